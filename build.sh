@@ -0,0 +1,7 @@
+#!/bin/sh
+#NOTE: only the headless tool builds on linux, the editor is still windows only (build.bat)
+cd "$(dirname "$0")/source"
+
+mkdir -p ../build
+#NOTE: -Wno-write-strings because string literals get passed as char * everywhere (eg. Literal("..."))
+g++ -std=c++11 -g -O2 -pthread -Wall -Wextra -Wno-write-strings north_tool_linux.cpp -o ../build/north_tool
@@ -1,10 +1,12 @@
 #include "theme.cpp"
 
+#include "north_shared/north_validation_utils.cpp"
 #define INCLUDE_DRAWPROFILES
 #include "north_shared/robot_profile_utils.cpp"
 #include "north_shared/auto_project_utils.cpp"
 #define INCLUDE_DRAWSETTINGS
 #include "north_shared/north_settings_utils.cpp"
+#include "north_shared/robot_recording_utils.cpp"
 
 enum EditorPage {
    EditorPage_Home,
@@ -42,16 +44,20 @@ struct EditorState {
       AutoPath *selected_path;
    };
    bool path_got_selected;
+   AutoPath *hot_path;
    PathEditMode path_edit;
+   PathIndex path_index;
 
    MemoryArena *project_arena;
    AutoProjectLink *project;
+   AutoProjectJournal journal;
 
    TextBoxData project_name_box;
    char _project_name_box[20];
 
    FileWatcher file_watcher;
    bool directory_changed;
+   AutoProjectIndex project_index;
 
    NorthSettings settings;
    RobotProfiles profiles;
@@ -114,42 +120,25 @@ void _ArrayMove(u32 size, u8 *array, u32 count, u32 from, u32 to) {
 }
 //---------------------------------------------------------------
 
-//--------------------Kinda-specific-utils-----------------------
-//TODO: debug this, its pretty janky with curved lines right now
-f32 MinDistFrom(ui_field_topdown *field, North_HermiteControlPoint *control_points, u32 control_point_count) {
-   v2 p = Cursor(field->e);
-   f32 result = F32_MAX;
-
-   for(u32 i = 1; i < control_point_count; i++) {
-      North_HermiteControlPoint cpa = control_points[i - 1];
-      North_HermiteControlPoint cpb = control_points[i];
-      
-      u32 point_count = 20;
-      f32 step = (f32)1 / (f32)(point_count - 1);
-      
-      for(u32 i = 1; i < point_count; i++) {
-         v2 a = GetPoint(field, CubicHermiteSpline(cpa, cpb, (i - 1) * step));
-         v2 b = GetPoint(field, CubicHermiteSpline(cpa, cpb, i * step));
-         result = Min(DistFromLine(a, b, p), result);
-      }
-   }
-
-   return result;
-}
-//---------------------------------------------------------------
-
 #include "auto_editor_ui.cpp"
 
 void initEditor(EditorState *state) {
    state->page = EditorPage_Home;
    state->settings.arena = PlatformAllocArena(Megabyte(1), "Settings");
    state->profiles.current.arena = PlatformAllocArena(Megabyte(10), "Current Profile");
+   state->profiles.current.schema_arena = PlatformAllocArena(Megabyte(1), "Current Profile Schema");
    state->profiles.loaded.arena = PlatformAllocArena(Megabyte(10), "Loaded Profile");
    state->project_arena = PlatformAllocArena(Megabyte(30), "Auto Project");
    state->file_lists_arena = PlatformAllocArena(Megabyte(10), "File List");
    
    InitTextBoxData(&state->project_name_box, state->_project_name_box);
    InitFileWatcher(&state->file_watcher, PlatformAllocArena(Kilobyte(512), "File Watcher"), "*.*");
+   InitProjectIndex(&state->project_index);
+   InitAutoProjectJournal(&state->journal);
+}
+
+void closeEditor(EditorState *state) {
+   CloseAutoProjectJournal(&state->journal);
 }
 
 void reloadFiles(EditorState *state) {
@@ -157,6 +146,7 @@ void reloadFiles(EditorState *state) {
    state->ncff_files = ListFilesWithExtension("*.ncff", state->file_lists_arena);
    state->ncrp_files = ListFilesWithExtension("*.ncrp", state->file_lists_arena);
    state->ncap_files = ListFilesWithExtension("*.ncap", state->file_lists_arena);
+   UpdateProjectIndex(&state->project_index, &state->file_watcher);
 
    ReadSettingsFile(&state->settings);
 }
@@ -183,16 +173,24 @@ void DrawOpenFileView(element *page, EditorState *state) {
          UI_SCOPE(page->context, file);
 
          //TODO: draw previews, not just buttons
-         //TODO: grey out buttons that are incompatible instead of just not working
-         if(Button(page, file->name, menu_button).clicked) {
+         AutoProjectIndexEntry *entry = GetIndexEntry(&state->project_index, file->name);
+         bool compatible = (entry == NULL) || IsProjectCompatible(entry, &state->profiles.current);
+         if(Button(page, file->name, menu_button.IsEnabled(compatible)).clicked) {
+            CloseAutoProjectJournal(&state->journal);
+            FreeAutoProject(state->project);
+            state->project = NULL;
             Reset(state->project_arena);
-            AutoProjectLink *project = ReadAutoProject(file->name, state->project_arena);
-            if(IsProjectCompatible(project, &state->profiles.current)) {
-               state->project = project;
+            //NOTE: check the view first so incompatible projects never get copied
+            AutoProjectLink *project = ReadAutoProjectView(file->name);
+            if(project && IsProjectCompatible(project, &state->profiles.current)) {
+               state->project = CopyAutoProject(project, state->project_arena);
+               OpenAutoProjectJournal(&state->journal, state->project, project->view_file.data, state->project_arena);
                SetText(&state->project_name_box, state->project->name);
                state->view = EditorView_Editing;
                state->selected_type = NothingSelected;
             }
+
+            FreeAutoProject(project);
          }
       }
    } else {
@@ -226,6 +224,8 @@ void DrawNewFileView(element *page, EditorState *state) {
             Center(field_starting_pos->bounds) + 10 * direction_arrow);           
 
       if(WasClicked(field_starting_pos)) {
+         CloseAutoProjectJournal(&state->journal);
+         FreeAutoProject(state->project);
          Reset(state->project_arena);
          state->project = PushStruct(state->project_arena, AutoProjectLink);
          state->project->starting_angle = starting_pos->angle;
@@ -264,6 +264,7 @@ void DrawNode(ui_field_topdown *field, EditorState *state, AutoNode *node, bool
                         RectCenterSize(V2(0, 0), field->size_in_ft));
 
       if(Length(drag_vector) > 0) {
+         WatchAutoNode(&state->journal, node);
          if(node->in_path != NULL) {
             RecalculateAutoPath(node->in_path);
          }
@@ -285,8 +286,7 @@ void DrawPath(ui_field_topdown *field, EditorState *state, AutoPath *path) {
    if(path->hidden)
       return;
 
-   AutoPathSpline path_spline = GetAutoPathSpline(path);
-   bool hot = IsHot(field->e) && (MinDistFrom(field, path_spline.points, path_spline.point_count) < 2);
+   bool hot = IsHot(field->e) && (state->hot_path == path);
 
    // for(u32 i = 1; i < path_spline.point_count; i++) {
    //    North_HermiteControlPoint a = path_spline.points[i - 1];
@@ -296,13 +296,13 @@ void DrawPath(ui_field_topdown *field, EditorState *state, AutoPath *path) {
 
    //TODO: make this better, make a "coloured line" call
    {
-      u32 point_count = (u32) (path->length * 4 * 4 /*added this second "* 4" because CIRC stuff is in meters not ft*/);
-      f32 step = path->length / (f32)(point_count - 1);
+      u32 point_count = Max(2, (u32) (path->length * 4 * 4 /*added this second "* 4" because CIRC stuff is in meters not ft*/));
+      AutoPathSamples samples = SampleAutoPath(path, 0, path->length, point_count);
 
-      for(u32 i = 1; i < point_count; i++) {
-         v2 point_a = GetAutoPathPoint(path, step * (i - 1));
-         v2 point_b  = GetAutoPathPoint(path, step * i);
-         f32 t_velocity = GetVelocityAt(path, step * i) / 20;
+      for(u32 i = 1; i < samples.count; i++) {
+         v2 point_a = V2(samples.x[i - 1], samples.y[i - 1]);
+         v2 point_b = V2(samples.x[i], samples.y[i]);
+         f32 t_velocity = samples.velocity[i] / 20;
          Line(field->e, hot ? GREEN : lerp(BLUE, t_velocity, RED), 2, GetPoint(field, point_a), GetPoint(field, point_b));
       }
 
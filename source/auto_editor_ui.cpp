@@ -14,6 +14,20 @@ void _DrawTangentHandle(ui_id id, ui_field_topdown *field, AutoPath *path,
       RecalculateAutoPath(path);
 }
 
+//NOTE: auto velocity paths follow the profile's limits, not just the ones from when the button was pressed
+void UpdateAutoVelocityLimits(EditorState *state, AutoNode *node, RobotMotionLimits limits) {
+   for(u32 i = 0; i < node->path_count; i++) {
+      AutoPath *path = node->out_paths[i];
+      if(path->auto_velocity && !SameMotionLimits(path->velocity_limits, limits)) {
+         path->velocity_limits = limits;
+         RecalculateAutoPathVelocity(path);
+         WatchAutoPath(&state->journal, path);
+      }
+
+      UpdateAutoVelocityLimits(state, path->out_node, limits);
+   }
+}
+
 struct editable_graph_line {
    f32 min;
    f32 max;
@@ -98,6 +112,7 @@ ui_graph_handle GraphHandle(editable_graph_line line, u32 i) {
 //---------------------------------------------------
 struct ui_pathlike_editor {
    bool recalculate;
+   bool velocity_edited;
    element *graph;
 };
 
@@ -115,7 +130,7 @@ ui_pathlike_editor DrawPathlikeDataEditor(EditorState *state, element *parent, R
    bool remove_velocity_sample = false;
    u32 remove_velocity_sample_i = 0;
 
-   DVTA_Data dvta = GetDVTA(&data->velocity);
+   DVTA_Data dvta = GetDVTA(data);
    editable_graph_line velocity_line = GraphLine(graph, 0, max_velocity, path_length, data->velocity.datapoints, data->velocity.datapoint_count);
    for(u32 i = 0; i < data->velocity.datapoint_count; i++) {
       UI_SCOPE(graph, data->velocity.datapoints + i);
@@ -123,6 +138,8 @@ ui_pathlike_editor DrawPathlikeDataEditor(EditorState *state, element *parent, R
       if((i != 0) && (i != (data->velocity.datapoint_count - 1))) {
          ui_graph_handle handle = GraphHandle(velocity_line, i);
          if(handle.moved) {
+            InvalidateDVTA(data);
+            result.velocity_edited = true;
             result.recalculate = true;
          }
          if(handle.clicked) {
@@ -174,12 +191,16 @@ ui_pathlike_editor DrawPathlikeDataEditor(EditorState *state, element *parent, R
                      ArrayInsert(state->project_arena, North_PathDataPoint, data->velocity.datapoints,
                                  new_velocity_sample_i, &new_datapoint, data->velocity.datapoint_count++);
       
+      InvalidateDVTA(data);
+      result.velocity_edited = true;
       result.recalculate = true;
    } else if(remove_velocity_sample) {
       data->velocity.datapoints = 
          ArrayRemove(state->project_arena, North_PathDataPoint, data->velocity.datapoints,
                      remove_velocity_sample_i, data->velocity.datapoint_count--);
 
+      InvalidateDVTA(data);
+      result.velocity_edited = true;
       result.recalculate = true;
    }
 
@@ -345,8 +366,12 @@ ui_pathlike_editor DrawPathlikeDataEditor(EditorState *state, element *parent, R
 }
 //---------------------------------------------------
 
-void DrawPivotCommandEditor(EditorState *state, AutoCommand *command, element *command_panel, RobotProfile *profile) {
+//NOTE: returns true if the pivot was changed & the node's pivots need to be recalculated
+bool DrawPivotCommandEditor(EditorState *state, AutoCommand *command, element *command_panel, RobotProfile *profile) {
    UI_SCOPE(command_panel, command);
+   f32 old_end_angle = command->pivot.end_angle;
+   bool old_turns_clockwise = command->pivot.turns_clockwise;
+
    element *compass = Panel(command_panel, Size(105, 105).Captures(INTERACTION_ACTIVE));
    Circle(compass, Center(compass), 50, BLACK, 2);
    Line(compass, BLACK, 2, Center(compass), Center(compass) + 50 * DirectionNormal(command->pivot.start_angle));
@@ -371,7 +396,7 @@ void DrawPivotCommandEditor(EditorState *state, AutoCommand *command, element *c
    f32 pivot_length = abs(AngleBetween(command->pivot.start_angle, command->pivot.end_angle, command->pivot.turns_clockwise));
    element *info_row = RowPanel(command_panel, Size(Size(command_panel).x, 20)); 
    Label(info_row, "Angle Between " + ToString(AngleBetween(command->pivot.start_angle, command->pivot.end_angle, command->pivot.turns_clockwise)), 20, WHITE);
-   Label(info_row, "Time " + ToString(GetTotalTime(GetDVTA(&command->pivot.data.velocity))), 20, WHITE);
+   Label(info_row, "Time " + ToString(GetTotalTime(GetDVTA(&command->pivot.data))), 20, WHITE);
 
    ui_pathlike_editor path_editor = DrawPathlikeDataEditor(state, command_panel, profile, &command->pivot.data, pivot_length, 90);
 
@@ -380,6 +405,10 @@ void DrawPivotCommandEditor(EditorState *state, AutoCommand *command, element *c
       Text(path_editor.graph, "Distance=" + ToString(cursor_d), path_editor.graph->bounds.min, 20, WHITE);
       Rectangle(compass, RectCenterSize(Center(compass) + 50 * DirectionNormal(command->pivot.start_angle + cursor_d), V2(5, 5)), BLACK);
    }
+
+   return path_editor.recalculate || 
+          (command->pivot.end_angle != old_end_angle) || 
+          (command->pivot.turns_clockwise != old_turns_clockwise);
 }
 
 void DrawSelectedNode(EditorState *state, ui_field_topdown *field, bool field_clicked, element *page) {
@@ -407,6 +436,7 @@ void DrawSelectedNode(EditorState *state, ui_field_topdown *field, bool field_cl
       new_path->out_tangent = Normalize(new_path->out_node->pos - new_path->in_node->pos);
       
       RecalculateAutoPathLength(new_path);
+      InitPathlikeData(&new_path->data, state->project_arena);
       new_path->data.velocity.datapoint_count = 4;
       new_path->data.velocity.datapoints = PushArray(state->project_arena, North_PathDataPoint, 4);
       new_path->data.velocity.datapoints[0] = { 0, 0 };
@@ -421,6 +451,7 @@ void DrawSelectedNode(EditorState *state, ui_field_topdown *field, bool field_cl
 
       selected_node->path_count = selected_node->path_count + 1;
       selected_node->out_paths = new_out_paths;
+      JournalAddedPath(&state->journal, new_path);
    }
 
    element *edit_panel = ColumnPanel(page, Width(Size(page).x - 10).Padding(5, 5));
@@ -445,6 +476,7 @@ void DrawSelectedNode(EditorState *state, ui_field_topdown *field, bool field_cl
          }
 
          Assert(remove_index != -1);
+         JournalRemovedPath(&state->journal, in_path);
          AutoPath **new_out_paths = PushArray(state->project_arena, AutoPath *, parent->path_count - 1);
 
          u32 before_count = remove_index;
@@ -453,6 +485,7 @@ void DrawSelectedNode(EditorState *state, ui_field_topdown *field, bool field_cl
                
          parent->out_paths = new_out_paths;
          parent->path_count--;
+         FreeAutoPath(in_path);
 
          state->selected_type = NothingSelected;
          state->selected_node = NULL;
@@ -496,12 +529,14 @@ void DrawSelectedNode(EditorState *state, ui_field_topdown *field, bool field_cl
       if(Button(available_command_list, "Pivot", menu_button).clicked) {
          AutoCommand *new_command = PushStruct(state->project_arena, AutoCommand);
          new_command->type = North_CommandType::Pivot;
+         InitPathlikeData(&new_command->pivot.data, state->project_arena);
          new_command->pivot.data.velocity.datapoint_count = 4;
          new_command->pivot.data.velocity.datapoints = PushArray(state->project_arena, North_PathDataPoint, new_command->pivot.data.velocity.datapoint_count);
 
          selected_node->commands =
             ArrayInsert(state->project_arena, AutoCommand *, selected_node->commands,
                         selected_node->command_count - 1, &new_command, selected_node->command_count++);
+         MarkPivotsDirty(selected_node);
       }
    }
 
@@ -587,7 +622,8 @@ void DrawSelectedNode(EditorState *state, ui_field_topdown *field, bool field_cl
          
          case North_CommandType::Pivot: {
             Label(button_row, "Pivot to " + ToString(command->pivot.end_angle), 20, WHITE);
-            DrawPivotCommandEditor(state, command, command_panel, profile);
+            if(DrawPivotCommandEditor(state, command, command_panel, profile))
+               MarkPivotsDirty(selected_node);
          } break;
 
          default: Assert(false);
@@ -598,9 +634,11 @@ void DrawSelectedNode(EditorState *state, ui_field_topdown *field, bool field_cl
       selected_node->commands =
                ArrayRemove(state->project_arena, AutoCommand *, selected_node->commands,
                            remove_index, selected_node->command_count--); 
+      MarkPivotsDirty(selected_node);
    } else if(move_command) {
       ArrayMove(AutoCommand *, selected_node->commands, selected_node->command_count,
                 from_index, to_index);
+      MarkPivotsDirty(selected_node);
    }
 
    FinalizeLayout(edit_panel);
@@ -636,10 +674,23 @@ void DrawSelectedPath(EditorState *state, ui_field_topdown *field, bool field_cl
       selected_path->is_reverse = !selected_path->is_reverse;
    }
 
+   if(Button(edit_buttons, "Auto Velocity", menu_button.IsSelected(selected_path->auto_velocity)).clicked) {
+      selected_path->auto_velocity = !selected_path->auto_velocity;
+      selected_path->velocity_limits = GetMotionLimits(profile);
+      RecalculateAutoPath(selected_path);
+   }
+
    Label(edit_panel, "Path length: " + ToString(selected_path->length), 20, WHITE);
-   Label(edit_panel, "Time: " + ToString(GetTotalTime(GetDVTA(&selected_path->data.velocity))), 20, WHITE);
+   Label(edit_panel, "Map samples: " + ToString(selected_path->map_info.sample_count) + 
+                     ", max error: " + ToString(selected_path->map_info.pose_error) + "ft", 20, WHITE);
+   Label(edit_panel, "Time: " + ToString(GetTotalTime(GetDVTA(&selected_path->data))), 20, WHITE);
 
    ui_pathlike_editor path_editor = DrawPathlikeDataEditor(state, edit_panel, profile, &selected_path->data, selected_path->length, 20);
+   if(path_editor.velocity_edited) {
+      //NOTE: editing the profile by hand turns off auto velocity so it doesnt get overwritten
+      selected_path->auto_velocity = false;
+   }
+
    if(path_editor.recalculate) {
       RecalculateAutoPath(selected_path);
    }
@@ -761,14 +812,17 @@ void DrawEditingView(element *page, EditorState *state) {
 
    Panel(state->top_bar, Size(40, Size(state->top_bar).y));
    if(Button(state->top_bar, "Save", menu_button.IsEnabled(GetText(project_name_box).length > 0)).clicked) {
-      WriteProject(state->project);
+      SaveAutoProject(&state->journal, state->project);
    }
 
-   if(Button(state->top_bar, "Upload", menu_button.IsEnabled(state->profiles.current.state == RobotProfileState::Connected)).clicked) {
+   //NOTE: robots that only take version 0 cant get projects with more than 255 of anything
+   bool can_upload = (state->profiles.current.state == RobotProfileState::Connected) && 
+                     CanUploadAutoProject(state->project, &state->profiles.current);
+   if(Button(state->top_bar, "Upload", menu_button.IsEnabled(can_upload)).clicked) {
       buffer setstate_packet = MakeSetStatePacket(state->project->starting_node->pos, state->project->starting_angle);
       SendPacket(setstate_packet);
 
-      buffer upload_packet = MakeUploadAutonomousPacket(state->project);
+      buffer upload_packet = MakeUploadAutonomousPacket(state->project, &state->profiles.current);
       SendPacket(upload_packet);
    }
 
@@ -784,6 +838,11 @@ void DrawEditingView(element *page, EditorState *state) {
    field_width += GetDrag(resize_divider).y * (field.size_in_ft.x / field.size_in_ft.y);
    
    RecalculateAutoNode(state->project->starting_node);
+   UpdateAutoVelocityLimits(state, state->project->starting_node, GetMotionLimits(profile));
+   
+   UpdatePathIndex(&state->path_index, state->project->starting_node);
+   v2 cursor_ft = PixelsToFeet(&field, Cursor(field.e) - Center(field.bounds));
+   state->hot_path = GetClosestPath(&state->path_index, cursor_ft, PixelsToFeet(&field, 2)).path;
    DrawNode(&field, state, state->project->starting_node, false);
    
    InputState *input = &page->context->input_state;
@@ -799,11 +858,27 @@ void DrawEditingView(element *page, EditorState *state) {
       } break;
    }
 
+   //NOTE: anything that can be edited this frame gets watched, the journal writes the edits once they settle
+   switch(state->selected_type) {
+      case NodeSelected: {
+         WatchAutoNode(&state->journal, state->selected_node);
+         for(u32 i = 0; i < state->selected_node->path_count; i++)
+            WatchAutoPath(&state->journal, state->selected_node->out_paths[i]);
+      } break;
+
+      case PathSelected: {
+         WatchAutoPath(&state->journal, state->selected_path);
+      } break;
+   }
+   UpdateAutoProjectJournal(&state->journal);
+
    if(input->key_esc) {
       state->selected_type = NothingSelected;
    }
 
    if(Button(state->top_bar, "Exit", menu_button).clicked) {
+      CloseAutoProjectJournal(&state->journal);
+      FreeAutoProject(state->project);
       Reset(state->project_arena);
       state->project = NULL;
       state->view = EditorView_Blank;
@@ -26,7 +26,7 @@
 #include "north_defs/north_file_definitions.h"
 #include "north_defs/north_network_definitions.h"
 
-#include "north_shared/north_networking_win32.cpp"
+#include "north_shared/north_networking.cpp"
 
 #include "auto_editor.cpp"
 #include "network.cpp"
@@ -55,23 +55,24 @@ int WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int n
    EditorState state = {};
    initEditor(&state);
 
-   WSADATA winsock_data = {};
-   WSAStartup(MAKEWORD(2, 2), &winsock_data);
-   CreateSocket();
+   InitNetworking();
+   StartNetworkThread(&robot_network, GetConnectionTarget(&state));
 
    Timer timer = InitTimer();
    while(PumpMessages(&window, &ui_context)) {
       state.directory_changed = CheckFiles(&state.file_watcher);
 
       Reset(__temp_arena);
-      PacketHeader header = {};
-      buffer packet = {};
-      while(HasPackets(ui_context.curr_time, &header, &packet)) {
-         HandlePacket(&state, (PacketType::type) header.type, packet);
-      }
+      SetNetworkTarget(&robot_network, GetConnectionTarget(&state));
 
-      if(HandleConnectionStatus((state.settings.team_number == 0) ? "127.0.0.1" : "10.0.5.4", ui_context.curr_time)) {
-         HandleDisconnect(&state);
+      NetworkMessageHeader message = {};
+      buffer packet = {};
+      while(HasNetworkMessages(&robot_network, &message, &packet)) {
+         if(message.type == NetworkMessageType::Disconnected) {
+            HandleDisconnect(&state);
+         } else {
+            HandlePacket(&state, (PacketType::type) message.packet_type, packet);
+         }
       }
 
       Reset(__temp_arena);
@@ -80,5 +81,7 @@ int WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int n
       endFrame(&window, root_element);
    }
 
+   StopNetworkThread(&robot_network);
+   closeEditor(&state);
    return 0;
 }
\ No newline at end of file
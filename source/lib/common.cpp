@@ -59,7 +59,7 @@ struct string {
 
    string () {
       this->text = 0;
-      this->length = NULL;
+      this->length = 0;
    }
 
    string (char *c_str) {
@@ -318,6 +318,79 @@ void Reset(MemoryArena *arena) {
    arena->curr_block = arena->first_block;
 }
 
+//NOTE: hands out fixed size arenas from power of 2 size classes, freed arenas go on a 
+//      free list for their class & get reused, for things that get rebuilt or thrown away a lot
+#define MEMORY_POOL_MIN_SIZE_EXP 8
+#define MEMORY_POOL_CLASS_COUNT 24
+
+struct MemoryPoolBlock {
+   MemoryArena arena; //NOTE: has to be first, PoolFreeArena casts the arena back to the block
+   MemoryArenaBlock arena_block;
+   
+   u32 size_class;
+   MemoryPoolBlock *next_free;
+};
+
+struct MemoryPool {
+   MemoryArena *arena;
+   MemoryPoolBlock *free_blocks[MEMORY_POOL_CLASS_COUNT];
+
+   u64 size_allocated;
+   u64 size_in_use;
+};
+
+MemoryPool *PushPool(MemoryArena *arena) {
+   MemoryPool *result = PushStruct(arena, MemoryPool);
+   result->arena = arena;
+   return result;
+}
+
+MemoryArena *PoolAllocArena(MemoryPool *pool, u64 size) {
+   u32 size_class = 0;
+   while(((u64)1 << (MEMORY_POOL_MIN_SIZE_EXP + size_class)) < size)
+      size_class++;
+   Assert(size_class < MEMORY_POOL_CLASS_COUNT);
+   u64 block_size = (u64)1 << (MEMORY_POOL_MIN_SIZE_EXP + size_class);
+
+   MemoryPoolBlock *block = pool->free_blocks[size_class];
+   if(block != NULL) {
+      pool->free_blocks[size_class] = block->next_free;
+   } else {
+      block = PushStruct(pool->arena, MemoryPoolBlock);
+      block->size_class = size_class;
+      block->arena_block.size = block_size;
+      block->arena_block.memory = PushSize(pool->arena, block_size);
+      pool->size_allocated += block_size;
+   }
+
+   block->next_free = NULL;
+   block->arena_block.used = 0;
+   block->arena_block.next = NULL;
+
+   ZeroStruct(&block->arena);
+   block->arena.initial_size = block_size;
+   block->arena.first_block = &block->arena_block;
+   block->arena.curr_block = &block->arena_block;
+   block->arena.valid = true;
+
+   pool->size_in_use += block_size;
+   return &block->arena;
+}
+
+void PoolFreeArena(MemoryPool *pool, MemoryArena *arena) {
+   MemoryPoolBlock *block = (MemoryPoolBlock *) arena;
+   Assert(arena->first_block == &block->arena_block);
+   
+   block->arena.valid = false;
+   block->next_free = pool->free_blocks[block->size_class];
+   pool->free_blocks[block->size_class] = block;
+   pool->size_in_use -= block->arena_block.size;
+}
+
+u64 PoolArenaSize(MemoryArena *arena) {
+   return arena->first_block->size;
+}
+
 struct buffer {
    u64 size;
    u64 offset;
@@ -354,6 +427,18 @@ string ConsumeString(buffer *b, u32 length) {
 
 #define ConsumeAndCopyArray(arena, b, struct, length) PushArrayCopy(arena, struct, ConsumeArray(b, struct, length), length)
 
+//NOTE: like ConsumeSize but returns NULL instead of asserting if size doesnt fit, for walking untrusted buffers
+#define ValidateStruct(b, struct) (struct *) ValidateSize(b, sizeof(struct))
+#define ValidateArray(b, struct, length) (struct *) ValidateSize(b, (u64)(length) * sizeof(struct))
+u8 *ValidateSize(buffer *b, u64 size) {
+   if((b->data == NULL) || (b->offset > b->size) || ((b->size - b->offset) < size))
+      return NULL;
+
+   u8 *result = b->data + b->offset;
+   b->offset += size;
+   return result;
+}
+
 #define PeekStruct(b, struct) (struct *) PeekSize(b, sizeof(struct))
 u8 *PeekSize(buffer *b, u64 size) {
    Assert((b->offset + size) <= b->size);
@@ -364,8 +449,11 @@ u8 *PeekSize(buffer *b, u64 size) {
 #define WriteArray(b, first_elem, length) WriteSize(b, (u8 *)(first_elem), (length) * sizeof(*(first_elem)))
 void WriteSize(buffer *b, void *in_data, u64 size) {
    u8 *data = (u8 *) in_data;
-   Assert((b->size - b->offset) >= size);
-   Copy(data, size, b->data + b->offset);
+   //NOTE: a buffer with no data only counts bytes, write into one of these first to get the exact size
+   if(b->data != NULL) {
+      Assert((b->size - b->offset) >= size);
+      Copy(data, size, b->data + b->offset);
+   }
    b->offset += size;
 }
 
@@ -375,6 +463,51 @@ void WriteString(buffer *b, string str) {
 
 #define WriteStructData(b, type, name, code) do { type name = {}; code WriteStruct(b, &name); } while(false)
 
+//NOTE: LEB128, 7 bits a byte starting from the bottom, the top bit is set on every byte but the last
+//      so small values (most counts) are 1 byte & a u32 is at most 5
+void WriteVarint(buffer *b, u32 value) {
+   u8 bytes[5];
+   u32 length = 0;
+   do {
+      bytes[length] = (u8)(value & 0x7F);
+      value >>= 7;
+      if(value != 0)
+         bytes[length] |= 0x80;
+      length++;
+   } while(value != 0);
+
+   WriteSize(b, bytes, length);
+}
+
+u32 ConsumeVarint(buffer *b) {
+   u32 result = 0;
+   for(u32 shift = 0; ; shift += 7) {
+      Assert(shift < 35);
+      u8 byte = *ConsumeStruct(b, u8);
+      result |= (u32)(byte & 0x7F) << shift;
+      if((byte & 0x80) == 0)
+         break;
+   }
+   return result;
+}
+
+//NOTE: fails if it runs off the end or doesnt fit in a u32
+bool ValidateVarint(buffer *b, u32 *value) {
+   u32 result = 0;
+   for(u32 shift = 0; shift < 35; shift += 7) {
+      u8 *byte = ValidateStruct(b, u8);
+      if((byte == NULL) || ((shift == 28) && ((*byte & 0x70) != 0)))
+         return false;
+
+      result |= (u32)(*byte & 0x7F) << shift;
+      if((*byte & 0x80) == 0) {
+         *value = result;
+         return true;
+      }
+   }
+   return false;
+}
+
 void Advance(buffer *b, u32 by) {
    Assert(by <= b->offset);
    //NOTE: this Copy is kinda sketchy because src & dst are in the same buffer
@@ -382,7 +515,8 @@ void Advance(buffer *b, u32 by) {
    b->offset -= by;
 }
 
-MemoryArena *__temp_arena = NULL;
+//NOTE: every thread gets its own temp arena, worker threads have to set theirs before touching anything that uses it
+thread_local MemoryArena *__temp_arena = NULL;
 
 struct TempArena {
    MemoryArena arena;
@@ -452,6 +586,7 @@ string operator+ (string a, string b) {
 }
 
 #include "stdio.h"
+#include "stdlib.h"
 string ToString(f32 value) {
    //TODO: clean this up
    char buffer[128] = {};
@@ -515,6 +650,8 @@ f32 lerp(f32 a, f32 t, f32 b) {
    return a + t * (b - a);
 }
 
+//NOTE: libstdc++'s stdlib.h already has the float & double overloads
+#ifndef __GLIBCXX__
 f32 abs(f32 x) {
    return (x > 0) ? x : -x;
 }
@@ -522,6 +659,7 @@ f32 abs(f32 x) {
 f64 abs(f64 x) {
    return (x > 0) ? x : -x;
 }
+#endif
 
 f32 ToDegrees(f32 r) {
    return r * (180 / PI32);
@@ -579,6 +717,73 @@ f32 ShortestAngleBetween_Radians(f32 a, f32 b) {
    return AngleBetween_Radians(a, b, IsClockwiseShorter_Radians(a, b));
 }
 
+//NOTE: IEEE half floats (1 sign, 5 exponent & 10 mantissa bits), rounds to the nearest even,
+//      anything bigger than 65504 becomes inf & nans stay nans
+//NOTE: the bits go through Copy instead of a pointer cast, casting breaks strict aliasing (& gets miscompiled at -O2)
+u16 F32ToF16(f32 value) {
+   u32 bits = 0;
+   Copy(&value, sizeof(u32), &bits);
+   u32 sign = (bits >> 16) & 0x8000;
+   u32 exponent = (bits >> 23) & 0xFF;
+   u32 mantissa = bits & 0x7FFFFF;
+
+   if(exponent == 0xFF)
+      return (u16)(sign | 0x7C00 | ((mantissa != 0) ? 0x200 : 0));
+
+   s32 half_exponent = (s32) exponent - 127 + 15;
+   if(half_exponent >= 31)
+      return (u16)(sign | 0x7C00);
+
+   if(half_exponent <= 0) {
+      //NOTE: too small for a normal half, the implicit 1 gets shifted down into the mantissa
+      if(half_exponent < -11)
+         return (u16) sign;
+
+      mantissa |= 0x800000;
+      u32 shift = (u32)(14 - half_exponent);
+      u32 result = mantissa >> shift;
+      u32 remainder = mantissa & ((1 << shift) - 1);
+      u32 halfway = 1 << (shift - 1);
+      if((remainder > halfway) || ((remainder == halfway) && (result & 1)))
+         result++;
+      return (u16)(sign | result);
+   }
+
+   //NOTE: rounding up can carry into the exponent, which is still the right answer (even if its inf)
+   u32 result = sign | ((u32) half_exponent << 10) | (mantissa >> 13);
+   u32 remainder = mantissa & 0x1FFF;
+   if((remainder > 0x1000) || ((remainder == 0x1000) && (result & 1)))
+      result++;
+   return (u16) result;
+}
+
+f32 F16ToF32(u16 half) {
+   u32 sign = (u32)(half & 0x8000) << 16;
+   u32 exponent = (half >> 10) & 0x1F;
+   u32 mantissa = half & 0x3FF;
+
+   u32 bits = 0;
+   if(exponent == 0x1F) {
+      bits = sign | 0x7F800000 | (mantissa << 13);
+   } else if(exponent != 0) {
+      bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+   } else if(mantissa != 0) {
+      //NOTE: subnormal, shift it up until the top bit becomes the implicit 1
+      exponent = 127 - 15 + 1;
+      while((mantissa & 0x400) == 0) {
+         mantissa <<= 1;
+         exponent--;
+      }
+      bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+   } else {
+      bits = sign;
+   }
+
+   f32 result = 0;
+   Copy(&bits, sizeof(f32), &result);
+   return result;
+}
+
 union v4 {
    struct { f32 r, g, b, a; };
    struct { f32 x, y, z, w; };
@@ -723,6 +928,15 @@ v2 Midpoint(v2 a, v2 b) {
    return (a + b) / 2;
 }
 
+v2 DirectionNormal(f32 angle) {
+   return V2(cosf(ToRadians(angle)), 
+             -sinf(ToRadians(angle)));
+}
+
+f32 Angle(v2 v) {
+   return ToDegrees(atan2(-v.y, v.x));
+}
+
 f32 DistFromLine(v2 a, v2 b, v2 p) {
    f32 num = (a.y - b.y) * p.x - (a.x - b.x) * p.y + a.x*b.y - a.y*b.x;
    return abs(num) / sqrtf((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
@@ -740,6 +954,547 @@ v2 CubicHermiteSplineTangent(v2 a_pos, v2 a_tan, v2 b_pos, v2 b_tan, f32 t) {
           (3*t*t - 2*t)*b_tan;
 }
 
+v2 CubicHermiteSplineSecondDerivative(v2 a_pos, v2 a_tan, v2 b_pos, v2 b_tan, f32 t) {
+   return (12*t - 6)*a_pos +
+          (6*t - 4)*a_tan +
+          (6 - 12*t)*b_pos +
+          (6*t - 2)*b_tan;
+}
+
+//NOTE: this is constant over the whole segment
+v2 CubicHermiteSplineThirdDerivative(v2 a_pos, v2 a_tan, v2 b_pos, v2 b_tan) {
+   return 12*a_pos + 6*a_tan - 12*b_pos + 6*b_tan;
+}
+
+//NOTE: 5 point Gauss-Legendre quadrature of |P'(t)| from t0 to t1
+f32 CubicHermiteSplineArcLength(v2 a_pos, v2 a_tan, v2 b_pos, v2 b_tan, f32 t0, f32 t1) {
+   const f32 nodes[5] = { -0.9061798459386640, -0.5384693101056831, 0, 0.5384693101056831, 0.9061798459386640 };
+   const f32 weights[5] = { 0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891 };
+
+   f32 half_width = (t1 - t0) / 2;
+   f32 center = (t1 + t0) / 2;
+
+   f32 result = 0;
+   for(u32 i = 0; i < 5; i++) {
+      v2 tangent = CubicHermiteSplineTangent(a_pos, a_tan, b_pos, b_tan, center + half_width * nodes[i]);
+      result += weights[i] * sqrtf(tangent.x * tangent.x + tangent.y * tangent.y);
+   }
+
+   return half_width * result;
+}
+
+//SPLINE-BATCHES---------------------------------------------
+//NOTE: evaluates a spline segment at lots of t values at once, the x86 kernels do 4 (SSE2) or
+//      8 (AVX2) t values per iteration, the best one the cpu supports gets picked on the first call
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+   #define COMMON_SIMD_X86
+   #include "emmintrin.h"
+   #include "immintrin.h"
+   #if defined(_MSC_VER)
+      #include "intrin.h"
+      #define SIMD_TARGET_AVX2
+   #else
+      #include "cpuid.h"
+      #define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+   #endif
+#endif
+
+//NOTE: power basis, P(t) = c[0] + c[1]t + c[2]t^2 + c[3]t^3
+struct HermiteCoefficients {
+   v2 c[4];
+};
+
+HermiteCoefficients GetHermiteCoefficients(v2 a_pos, v2 a_tan, v2 b_pos, v2 b_tan) {
+   HermiteCoefficients result = {};
+   result.c[0] = a_pos;
+   result.c[1] = a_tan;
+   result.c[2] = -3*a_pos - 2*a_tan + 3*b_pos - b_tan;
+   result.c[3] = 2*a_pos + a_tan - 2*b_pos + b_tan;
+   return result;
+}
+
+//NOTE: positions or tangents can be NULL if you dont need them
+typedef void (*hermite_batch_kernel)(HermiteCoefficients *coeffs, f32 *ts, u32 count, v2 *positions, v2 *tangents);
+
+void CubicHermiteBatch_Scalar(HermiteCoefficients *coeffs, f32 *ts, u32 count, v2 *positions, v2 *tangents) {
+   v2 *c = coeffs->c;
+   for(u32 i = 0; i < count; i++) {
+      f32 t = ts[i];
+      if(positions)
+         positions[i] = c[0] + t*(c[1] + t*(c[2] + t*c[3]));
+      if(tangents)
+         tangents[i] = c[1] + t*(2*c[2] + t*(3*c[3]));
+   }
+}
+
+#ifdef COMMON_SIMD_X86
+void CubicHermiteBatch_SSE2(HermiteCoefficients *coeffs, f32 *ts, u32 count, v2 *positions, v2 *tangents) {
+   v2 *c = coeffs->c;
+   __m128 c0x = _mm_set1_ps(c[0].x), c0y = _mm_set1_ps(c[0].y);
+   __m128 c1x = _mm_set1_ps(c[1].x), c1y = _mm_set1_ps(c[1].y);
+   __m128 c2x = _mm_set1_ps(c[2].x), c2y = _mm_set1_ps(c[2].y);
+   __m128 c3x = _mm_set1_ps(c[3].x), c3y = _mm_set1_ps(c[3].y);
+   __m128 dc2x = _mm_set1_ps(2*c[2].x), dc2y = _mm_set1_ps(2*c[2].y);
+   __m128 dc3x = _mm_set1_ps(3*c[3].x), dc3y = _mm_set1_ps(3*c[3].y);
+
+   u32 i = 0;
+   for(; (i + 4) <= count; i += 4) {
+      __m128 t = _mm_loadu_ps(ts + i);
+      if(positions) {
+         __m128 x = _mm_add_ps(c0x, _mm_mul_ps(t, _mm_add_ps(c1x, _mm_mul_ps(t, _mm_add_ps(c2x, _mm_mul_ps(t, c3x))))));
+         __m128 y = _mm_add_ps(c0y, _mm_mul_ps(t, _mm_add_ps(c1y, _mm_mul_ps(t, _mm_add_ps(c2y, _mm_mul_ps(t, c3y))))));
+         _mm_storeu_ps((f32 *)(positions + i), _mm_unpacklo_ps(x, y));
+         _mm_storeu_ps((f32 *)(positions + i + 2), _mm_unpackhi_ps(x, y));
+      }
+
+      if(tangents) {
+         __m128 x = _mm_add_ps(c1x, _mm_mul_ps(t, _mm_add_ps(dc2x, _mm_mul_ps(t, dc3x))));
+         __m128 y = _mm_add_ps(c1y, _mm_mul_ps(t, _mm_add_ps(dc2y, _mm_mul_ps(t, dc3y))));
+         _mm_storeu_ps((f32 *)(tangents + i), _mm_unpacklo_ps(x, y));
+         _mm_storeu_ps((f32 *)(tangents + i + 2), _mm_unpackhi_ps(x, y));
+      }
+   }
+
+   CubicHermiteBatch_Scalar(coeffs, ts + i, count - i, 
+                            positions ? (positions + i) : NULL, tangents ? (tangents + i) : NULL);
+}
+
+SIMD_TARGET_AVX2 
+void CubicHermiteBatch_AVX2(HermiteCoefficients *coeffs, f32 *ts, u32 count, v2 *positions, v2 *tangents) {
+   v2 *c = coeffs->c;
+   __m256 c0x = _mm256_set1_ps(c[0].x), c0y = _mm256_set1_ps(c[0].y);
+   __m256 c1x = _mm256_set1_ps(c[1].x), c1y = _mm256_set1_ps(c[1].y);
+   __m256 c2x = _mm256_set1_ps(c[2].x), c2y = _mm256_set1_ps(c[2].y);
+   __m256 c3x = _mm256_set1_ps(c[3].x), c3y = _mm256_set1_ps(c[3].y);
+   __m256 dc2x = _mm256_set1_ps(2*c[2].x), dc2y = _mm256_set1_ps(2*c[2].y);
+   __m256 dc3x = _mm256_set1_ps(3*c[3].x), dc3y = _mm256_set1_ps(3*c[3].y);
+
+   u32 i = 0;
+   for(; (i + 8) <= count; i += 8) {
+      __m256 t = _mm256_loadu_ps(ts + i);
+      if(positions) {
+         __m256 x = _mm256_fmadd_ps(t, _mm256_fmadd_ps(t, _mm256_fmadd_ps(t, c3x, c2x), c1x), c0x);
+         __m256 y = _mm256_fmadd_ps(t, _mm256_fmadd_ps(t, _mm256_fmadd_ps(t, c3y, c2y), c1y), c0y);
+         
+         //NOTE: unpack works per 128 bit lane, so the halves need swapping back into order
+         __m256 lo = _mm256_unpacklo_ps(x, y);
+         __m256 hi = _mm256_unpackhi_ps(x, y);
+         _mm256_storeu_ps((f32 *)(positions + i), _mm256_permute2f128_ps(lo, hi, 0x20));
+         _mm256_storeu_ps((f32 *)(positions + i + 4), _mm256_permute2f128_ps(lo, hi, 0x31));
+      }
+
+      if(tangents) {
+         __m256 x = _mm256_fmadd_ps(t, _mm256_fmadd_ps(t, dc3x, dc2x), c1x);
+         __m256 y = _mm256_fmadd_ps(t, _mm256_fmadd_ps(t, dc3y, dc2y), c1y);
+         
+         __m256 lo = _mm256_unpacklo_ps(x, y);
+         __m256 hi = _mm256_unpackhi_ps(x, y);
+         _mm256_storeu_ps((f32 *)(tangents + i), _mm256_permute2f128_ps(lo, hi, 0x20));
+         _mm256_storeu_ps((f32 *)(tangents + i + 4), _mm256_permute2f128_ps(lo, hi, 0x31));
+      }
+   }
+
+   CubicHermiteBatch_SSE2(coeffs, ts + i, count - i, 
+                          positions ? (positions + i) : NULL, tangents ? (tangents + i) : NULL);
+}
+
+bool CPUHasAVX2() {
+   u32 leaf1[4] = {};
+   u32 leaf7[4] = {};
+#if defined(_MSC_VER)
+   __cpuid((int *) leaf1, 1);
+   __cpuidex((int *) leaf7, 7, 0);
+#else
+   __cpuid(1, leaf1[0], leaf1[1], leaf1[2], leaf1[3]);
+   __cpuid_count(7, 0, leaf7[0], leaf7[1], leaf7[2], leaf7[3]);
+#endif
+   bool has_fma = (leaf1[2] & (1 << 12)) != 0;
+   bool has_osxsave = (leaf1[2] & (1 << 27)) != 0;
+   bool has_avx2 = (leaf7[1] & (1 << 5)) != 0;
+   if(!(has_fma && has_osxsave && has_avx2))
+      return false;
+
+   //NOTE: the os also has to save the ymm registers
+#if defined(_MSC_VER)
+   u64 xcr0 = _xgetbv(0);
+#else
+   u32 xcr0_lo, xcr0_hi;
+   __asm__ ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+   u64 xcr0 = ((u64)xcr0_hi << 32) | xcr0_lo;
+#endif
+   return (xcr0 & 0x6) == 0x6;
+}
+#endif
+
+hermite_batch_kernel __hermite_batch_kernel = NULL;
+
+hermite_batch_kernel GetHermiteBatchKernel() {
+   if(__hermite_batch_kernel == NULL) {
+#ifdef COMMON_SIMD_X86
+      //NOTE: SSE2 is always there on x64
+      __hermite_batch_kernel = CPUHasAVX2() ? CubicHermiteBatch_AVX2 : CubicHermiteBatch_SSE2;
+#else
+      __hermite_batch_kernel = CubicHermiteBatch_Scalar;
+#endif
+   }
+
+   return __hermite_batch_kernel;
+}
+
+void CubicHermiteSplineBatch(v2 a_pos, v2 a_tan, v2 b_pos, v2 b_tan, 
+                             f32 *ts, u32 count, v2 *positions, v2 *tangents = NULL)
+{
+   HermiteCoefficients coeffs = GetHermiteCoefficients(a_pos, a_tan, b_pos, b_tan);
+   GetHermiteBatchKernel()(&coeffs, ts, count, positions, tangents);
+}
+
+//NOTE: count evenly spaced t values from 0 to 1 (inclusive), a count of 1 just samples t = 0
+void CubicHermiteSplineBatch(v2 a_pos, v2 a_tan, v2 b_pos, v2 b_tan, 
+                             u32 count, v2 *positions, v2 *tangents = NULL)
+{
+   f32 ts[64];
+   f32 step = (count > 1) ? ((f32)1 / (f32)(count - 1)) : 0;
+   HermiteCoefficients coeffs = GetHermiteCoefficients(a_pos, a_tan, b_pos, b_tan);
+   hermite_batch_kernel kernel = GetHermiteBatchKernel();
+   
+   for(u32 chunk_start = 0; chunk_start < count; chunk_start += ArraySize(ts)) {
+      u32 chunk_count = Min(count - chunk_start, (u32) ArraySize(ts));
+      for(u32 i = 0; i < chunk_count; i++) {
+         ts[i] = (chunk_start + i) * step;
+      }
+      
+      kernel(&coeffs, ts, chunk_count, 
+             positions ? (positions + chunk_start) : NULL, tangents ? (tangents + chunk_start) : NULL);
+   }
+}
+
+//NOTE: CubicHermiteSplineArcLength of [t0, tm] & [tm, t1], with all 10 quadrature tangents evaluated in one batch
+void CubicHermiteSplineArcLengths(v2 a_pos, v2 a_tan, v2 b_pos, v2 b_tan, f32 t0, f32 tm, f32 t1,
+                                  f32 *left_length, f32 *right_length)
+{
+   const f32 nodes[5] = { -0.9061798459386640, -0.5384693101056831, 0, 0.5384693101056831, 0.9061798459386640 };
+   const f32 weights[5] = { 0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891 };
+
+   f32 left_half_width = (tm - t0) / 2;
+   f32 left_center = (tm + t0) / 2;
+   f32 right_half_width = (t1 - tm) / 2;
+   f32 right_center = (t1 + tm) / 2;
+
+   f32 ts[10];
+   for(u32 i = 0; i < 5; i++) {
+      ts[i] = left_center + left_half_width * nodes[i];
+      ts[5 + i] = right_center + right_half_width * nodes[i];
+   }
+   
+   v2 tangents[10];
+   CubicHermiteSplineBatch(a_pos, a_tan, b_pos, b_tan, ts, 10, NULL, tangents);
+
+   f32 left = 0;
+   f32 right = 0;
+   for(u32 i = 0; i < 5; i++) {
+      left += weights[i] * sqrtf(tangents[i].x * tangents[i].x + tangents[i].y * tangents[i].y);
+      right += weights[i] * sqrtf(tangents[5 + i].x * tangents[5 + i].x + tangents[5 + i].y * tangents[5 + i].y);
+   }
+
+   *left_length = left_half_width * left;
+   *right_length = right_half_width * right;
+}
+//SPLINE-BATCHES---------------------------------------------
+
+//BIT-PACKING------------------------------------------------
+//NOTE: blocks of up to 128 u32s all packed at the same bit width, value i goes into lane (i % 4)
+//      & each lane is its own stream of u32 words, interleaved with the other lanes,
+//      so the SSE2 kernel can pull 4 values out of one load
+#define PACKED_BLOCK_SIZE 128
+
+u32 BitWidth(u32 x) {
+   u32 result = 0;
+   while(x != 0) {
+      result++;
+      x >>= 1;
+   }
+   return result;
+}
+
+u32 PackedBlockWordCount(u32 count, u32 bit_width) {
+   u32 per_lane = (count + 3) / 4;
+   return 4 * ((per_lane * bit_width + 31) / 32);
+}
+
+u32 ZigZag(u32 x) {
+   return (x << 1) ^ (u32)((s32)x >> 31);
+}
+
+u32 UnZigZag(u32 x) {
+   return (x >> 1) ^ (0 - (x & 1));
+}
+
+//NOTE: words has to be PackedBlockWordCount(count, bit_width) long & zeroed
+void PackBlock(u32 *values, u32 count, u32 bit_width, u32 *words) {
+   for(u32 i = 0; i < count; i++) {
+      u32 lane = i % 4;
+      u32 bit = (i / 4) * bit_width;
+      u32 word = bit / 32;
+      u32 shift = bit % 32;
+
+      words[4 * word + lane] |= values[i] << shift;
+      if((shift + bit_width) > 32)
+         words[4 * (word + 1) + lane] |= values[i] >> (32 - shift);
+   }
+}
+
+//NOTE: out needs room for count rounded up to a multiple of 4, words dont have to be aligned
+typedef void (*unpack_block_kernel)(u8 *words, u32 count, u32 bit_width, u32 *out);
+//NOTE: out[i] = seed + in[0] + ... + in[i], in can be zigzagged, returns the last sum. in & out can be the same
+typedef u32 (*prefix_sum_kernel)(u32 *in, u32 *out, u32 count, u32 seed, bool zigzag);
+
+u32 LoadPackedWord(u8 *words, u32 i) {
+   u32 result;
+   Copy(words + 4 * i, sizeof(u32), &result);
+   return result;
+}
+
+void UnpackBlock_Scalar(u8 *words, u32 count, u32 bit_width, u32 *out) {
+   u32 mask = (bit_width == 32) ? 0xFFFFFFFF : ((1u << bit_width) - 1);
+   for(u32 i = 0; i < count; i++) {
+      u32 lane = i % 4;
+      u32 bit = (i / 4) * bit_width;
+      u32 word = bit / 32;
+      u32 shift = bit % 32;
+
+      u32 value = LoadPackedWord(words, 4 * word + lane) >> shift;
+      if((shift + bit_width) > 32)
+         value |= LoadPackedWord(words, 4 * (word + 1) + lane) << (32 - shift);
+      out[i] = value & mask;
+   }
+}
+
+u32 PrefixSum_Scalar(u32 *in, u32 *out, u32 count, u32 seed, bool zigzag) {
+   u32 sum = seed;
+   for(u32 i = 0; i < count; i++) {
+      sum += zigzag ? UnZigZag(in[i]) : in[i];
+      out[i] = sum;
+   }
+   return sum;
+}
+
+#ifdef COMMON_SIMD_X86
+void UnpackBlock_SSE2(u8 *words, u32 count, u32 bit_width, u32 *out) {
+   __m128i *lanes = (__m128i *) words;
+   __m128i mask = _mm_set1_epi32((bit_width == 32) ? 0xFFFFFFFF : ((1u << bit_width) - 1));
+   u32 per_lane = (count + 3) / 4;
+
+   if(bit_width == 0) {
+      for(u32 i = 0; i < per_lane; i++)
+         _mm_storeu_si128((__m128i *)(out + 4 * i), _mm_setzero_si128());
+      return;
+   }
+
+   for(u32 i = 0; i < per_lane; i++) {
+      u32 bit = i * bit_width;
+      u32 word = bit / 32;
+      u32 shift = bit % 32;
+
+      __m128i value = _mm_srl_epi32(_mm_loadu_si128(lanes + word), _mm_cvtsi32_si128(shift));
+      if((shift + bit_width) > 32) {
+         __m128i next = _mm_sll_epi32(_mm_loadu_si128(lanes + word + 1), _mm_cvtsi32_si128(32 - shift));
+         value = _mm_or_si128(value, next);
+      }
+      _mm_storeu_si128((__m128i *)(out + 4 * i), _mm_and_si128(value, mask));
+   }
+}
+
+u32 PrefixSum_SSE2(u32 *in, u32 *out, u32 count, u32 seed, bool zigzag) {
+   __m128i carry = _mm_set1_epi32(seed);
+   __m128i one = _mm_set1_epi32(1);
+
+   u32 i = 0;
+   for(; (i + 4) <= count; i += 4) {
+      __m128i x = _mm_loadu_si128((__m128i *)(in + i));
+      if(zigzag) {
+         __m128i sign = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(x, one));
+         x = _mm_xor_si128(_mm_srli_epi32(x, 1), sign);
+      }
+
+      //NOTE: log step scan, [a, b, c, d] -> [a, a+b, b+c, c+d] -> [a, a+b, a+b+c, a+b+c+d]
+      x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+      x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+      x = _mm_add_epi32(x, carry);
+      _mm_storeu_si128((__m128i *)(out + i), x);
+      carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+   }
+
+   return PrefixSum_Scalar(in + i, out + i, count - i, (u32) _mm_cvtsi128_si32(carry), zigzag);
+}
+#endif
+
+unpack_block_kernel __unpack_block_kernel = NULL;
+prefix_sum_kernel __prefix_sum_kernel = NULL;
+
+void InitBitPackingKernels() {
+   if(__unpack_block_kernel == NULL) {
+#ifdef COMMON_SIMD_X86
+      //NOTE: SSE2 is always there on x64
+      __prefix_sum_kernel = PrefixSum_SSE2;
+      __unpack_block_kernel = UnpackBlock_SSE2;
+#else
+      __prefix_sum_kernel = PrefixSum_Scalar;
+      __unpack_block_kernel = UnpackBlock_Scalar;
+#endif
+   }
+}
+
+unpack_block_kernel GetUnpackBlockKernel() {
+   InitBitPackingKernels();
+   return __unpack_block_kernel;
+}
+
+prefix_sum_kernel GetPrefixSumKernel() {
+   InitBitPackingKernels();
+   return __prefix_sum_kernel;
+}
+//BIT-PACKING------------------------------------------------
+
+//LZ-COMPRESSION---------------------------------------------
+//NOTE: byte oriented LZ77, the stream is a list of sequences:
+//      u8 token (high 4 bits literal count, low 4 bits match length - LZ_MIN_MATCH, 15 means more length bytes follow)
+//      [u8 more literal count]... (each 255 means keep going), literals
+//      u16 match offset (back from the end of the output so far), [u8 more match length]...
+//      the last sequence stops after its literals, so the stream always ends right after some literals
+#define LZ_MIN_MATCH 4
+#define LZ_MAX_OFFSET 0xFFFF
+#define LZ_HASH_BITS 12
+
+u64 LZCompressBound(u64 size) {
+   return size + (size / 255) + 16;
+}
+
+u32 LZHash(u8 *at) {
+   u32 x = at[0] | (at[1] << 8) | (at[2] << 16) | ((u32) at[3] << 24);
+   return (x * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+u8 *LZWriteLength(u8 *out, u64 length) {
+   for(; length >= 255; length -= 255)
+      *out++ = 255;
+   *out++ = (u8) length;
+   return out;
+}
+
+//NOTE: out has to be LZCompressBound(size) long, returns the compressed size
+u64 LZCompress(u8 *in, u64 size, u8 *out) {
+   u8 *in_end = in + size;
+   u8 *out_start = out;
+   u8 *literals = in;
+
+   //NOTE: most recent position of each hashed 4 bytes, +1 so 0 means empty
+   u32 table[1 << LZ_HASH_BITS] = {};
+
+   u8 *at = in;
+   while((at + LZ_MIN_MATCH) <= in_end) {
+      u32 hash = LZHash(at);
+      u8 *candidate = (table[hash] != 0) ? (in + table[hash] - 1) : NULL;
+      table[hash] = (u32)(at - in) + 1;
+
+      if((candidate == NULL) || ((at - candidate) > LZ_MAX_OFFSET) || 
+         (candidate[0] != at[0]) || (candidate[1] != at[1]) || (candidate[2] != at[2]) || (candidate[3] != at[3]))
+      {
+         at++;
+         continue;
+      }
+
+      u64 match_length = LZ_MIN_MATCH;
+      while(((at + match_length) < in_end) && (candidate[match_length] == at[match_length]))
+         match_length++;
+
+      u64 literal_count = at - literals;
+      u8 *token = out++;
+      *token = (u8)((Min(literal_count, 15) << 4) | Min(match_length - LZ_MIN_MATCH, 15));
+      if(literal_count >= 15)
+         out = LZWriteLength(out, literal_count - 15);
+      Copy(literals, literal_count, out);
+      out += literal_count;
+
+      u16 offset = (u16)(at - candidate);
+      Copy(&offset, sizeof(offset), out);
+      out += sizeof(offset);
+      if((match_length - LZ_MIN_MATCH) >= 15)
+         out = LZWriteLength(out, match_length - LZ_MIN_MATCH - 15);
+
+      at += match_length;
+      literals = at;
+   }
+
+   u64 literal_count = in_end - literals;
+   *out++ = (u8)(Min(literal_count, 15) << 4);
+   if(literal_count >= 15)
+      out = LZWriteLength(out, literal_count - 15);
+   Copy(literals, literal_count, out);
+   out += literal_count;
+
+   return out - out_start;
+}
+
+bool LZReadLength(u8 **in, u8 *in_end, u64 *length) {
+   u8 more = 255;
+   while(more == 255) {
+      if(*in >= in_end)
+         return false;
+      
+      more = *(*in)++;
+      *length += more;
+   }
+   return true;
+}
+
+//NOTE: safe on untrusted data, returns false unless in decodes to exactly out_size bytes
+bool LZDecompress(u8 *in, u64 in_size, u8 *out, u64 out_size) {
+   u8 *in_end = in + in_size;
+   u8 *out_start = out;
+   u8 *out_end = out + out_size;
+
+   while(in < in_end) {
+      u8 token = *in++;
+      u64 literal_count = token >> 4;
+      if((literal_count == 15) && !LZReadLength(&in, in_end, &literal_count))
+         return false;
+      
+      if(((u64)(in_end - in) < literal_count) || ((u64)(out_end - out) < literal_count))
+         return false;
+      
+      Copy(in, literal_count, out);
+      in += literal_count;
+      out += literal_count;
+
+      if(in == in_end)
+         break;
+      
+      if((in_end - in) < 2)
+         return false;
+      
+      u16 offset = 0;
+      Copy(in, sizeof(offset), &offset);
+      in += sizeof(offset);
+
+      u64 match_length = token & 0xF;
+      if((match_length == 15) && !LZReadLength(&in, in_end, &match_length))
+         return false;
+      match_length += LZ_MIN_MATCH;
+
+      if((offset == 0) || (offset > (out - out_start)) || ((u64)(out_end - out) < match_length))
+         return false;
+      
+      //NOTE: the match can overlap what it's writing (eg. offset 1 is a run), so byte by byte
+      u8 *match = out - offset;
+      for(u64 i = 0; i < match_length; i++)
+         out[i] = match[i];
+      out += match_length;
+   }
+
+   return out == out_end;
+}
+//LZ-COMPRESSION---------------------------------------------
+
 union v3 {
    struct { f32 r, g, b; };
    struct { f32 x, y, z; };
@@ -858,6 +1613,58 @@ inline rect2 Union(rect2 a, rect2 b) {
    return result;
 }
 
+inline rect2 Union(rect2 r, v2 p) {
+   return Union(r, RectMinMax(p, p));
+}
+
+inline bool Intersects(rect2 a, rect2 b) {
+   return (a.min.x <= b.max.x) && (b.min.x <= a.max.x) &&
+          (a.min.y <= b.max.y) && (b.min.y <= a.max.y);
+}
+
+//NOTE: 0 if p is inside the rect
+inline f32 DistanceSquared(rect2 r, v2 p) {
+   f32 dx = Max(0, Max(r.min.x - p.x, p.x - r.max.x));
+   f32 dy = Max(0, Max(r.min.y - p.y, p.y - r.max.y));
+   return dx * dx + dy * dy;
+}
+
+//NOTE: t is where the closest point is along a -> b, from 0 to 1
+inline v2 ClosestPointOnSegment(v2 a, v2 b, v2 p, f32 *t) {
+   v2 ab = b - a;
+   f32 len_sq = Dot(ab, ab);
+   *t = (len_sq > 0) ? Clamp(0, 1, Dot(p - a, ab) / len_sq) : 0;
+   return a + (*t) * ab;
+}
+
+//NOTE: clips the segment against the rect's slabs
+bool SegmentIntersects(v2 a, v2 b, rect2 r) {
+   f32 t_min = 0;
+   f32 t_max = 1;
+   v2 d = b - a;
+
+   for(u32 axis = 0; axis < 2; axis++) {
+      f32 start = axis ? a.y : a.x;
+      f32 dir = axis ? d.y : d.x;
+      f32 slab_min = axis ? r.min.y : r.min.x;
+      f32 slab_max = axis ? r.max.y : r.max.x;
+
+      if(dir == 0) {
+         if((start < slab_min) || (start > slab_max))
+            return false;
+      } else {
+         f32 t0 = (slab_min - start) / dir;
+         f32 t1 = (slab_max - start) / dir;
+         t_min = Max(t_min, Min(t0, t1));
+         t_max = Min(t_max, Max(t0, t1));
+         if(t_min > t_max)
+            return false;
+      }
+   }
+
+   return true;
+}
+
 union mat4 {
    f32 e[16];
 };
@@ -983,34 +1790,17 @@ struct InterpolatingMap_Leaf {
    };
 };
 
-struct InterpolatingMap_Branch {
-   f32 len;
-
-   f32 greater_value;
-   f32 less_value;
-
-   union {
-      struct {
-         u32 greater_leaf;
-         u32 less_leaf;
-      };
-
-      struct {
-         InterpolatingMap_Branch *greater_branch;
-         InterpolatingMap_Branch *less_branch;
-      };
-   };
-};
-
 typedef void (*interpolation_map_callback)(InterpolatingMap_Leaf *a, InterpolatingMap_Leaf *b, f32 t, void *result);
 
+//NOTE: lens is a flat sorted copy of samples[i].len, lookups only ever search lens
+//      so the whole search stays in a couple cache lines instead of chasing branch pointers
 struct InterpolatingMap {
    MemoryArena *arena;
-   u32 sample_exp;
+   u32 sample_exp; //NOTE: only used by ResetMap(map), maps built with an explicit count ignore this
    interpolation_map_callback lerp_callback;
 
-   InterpolatingMap_Branch *root;
-   InterpolatingMap_Branch **layers; //NOTE: has sample_exp arrays/layers in it
+   u32 sample_count;
+   f32 *lens;
    InterpolatingMap_Leaf *samples;
 };
 
@@ -1020,85 +1810,90 @@ struct InterpolatingMapSamples {
    MemoryArena *arena;
 };
 
-InterpolatingMapSamples ResetMap(InterpolatingMap *map) {
+InterpolatingMapSamples ResetMap(InterpolatingMap *map, u32 sample_count) {
+   Assert(sample_count >= 2);
    MemoryArena *arena = map->arena;
    Reset(arena);
 
-   u32 sample_count = Power(2, map->sample_exp); 
    InterpolatingMap_Leaf *samples = PushArray(arena, InterpolatingMap_Leaf, sample_count);
    map->samples = samples;
+   map->sample_count = sample_count;
+   map->lens = NULL;
 
    InterpolatingMapSamples result = {sample_count, samples, arena};
    return result;
 }
 
-void BuildMap(InterpolatingMap *map) {
-   MemoryArena *arena = map->arena;
+InterpolatingMapSamples ResetMap(InterpolatingMap *map) {
+   return ResetMap(map, Power(2, map->sample_exp));
+}
 
-   u32 last_layer_count = Power(2, map->sample_exp - 1);
-   InterpolatingMap_Branch *last_layer = PushArray(arena, InterpolatingMap_Branch, last_layer_count);
-   for(u32 i = 0; i < last_layer_count; i++) {
-      InterpolatingMap_Leaf *less = map->samples + (2 * i);
-      InterpolatingMap_Leaf *greater = map->samples + (2 * i + 1);
-
-      last_layer[i].less_leaf = 2 * i;
-      last_layer[i].less_value = less->len;
-      last_layer[i].greater_leaf = 2 * i + 1;
-      last_layer[i].greater_value = greater->len;
-      last_layer[i].len = (less->len + greater->len) / 2;
+void BuildMap(InterpolatingMap *map) {
+   map->lens = PushArray(map->arena, f32, map->sample_count);
+   for(u32 i = 0; i < map->sample_count; i++) {
+      map->lens[i] = map->samples[i].len;
    }
-   
-   u32 debug_layer_i = 0;
-   map->layers = PushArray(arena, InterpolatingMap_Branch *, map->sample_exp);
-   map->layers[debug_layer_i++] = last_layer;
-
-   for(u32 i = 1; i < map->sample_exp; i++) {
-      u32 layer_count = Power(2, map->sample_exp - i - 1);
-      InterpolatingMap_Branch *curr_layer = PushArray(arena, InterpolatingMap_Branch, layer_count);
+}
 
-      for(u32 i = 0; i < layer_count; i++) {
-         InterpolatingMap_Branch *less = last_layer + (2 * i);
-         InterpolatingMap_Branch *greater = last_layer + (2 * i + 1);
+//NOTE: branchless binary search, returns i such that lens[i] <= distance < lens[i + 1]
+//      clamped so that (i, i + 1) is always a valid pair of samples
+inline u32 MapSearch(InterpolatingMap *map, f32 distance) {
+   f32 *lens = map->lens;
+   u32 base = 0;
+   u32 n = map->sample_count - 1;
+   while(n > 1) {
+      u32 half = n / 2;
+      base = (lens[base + half] <= distance) ? (base + half) : base;
+      n -= half;
+   }
+   return base;
+}
 
-         curr_layer[i].less_branch = less;
-         curr_layer[i].less_value = less->less_value;
-         curr_layer[i].greater_branch = greater;
-         curr_layer[i].greater_value = greater->greater_value;
-         curr_layer[i].len = (less->greater_value + greater->less_value) / 2;
-      }
+//NOTE: same as MapSearch but starts from the last result, for sweeps where distance mostly increases
+inline u32 MapSearchFrom(InterpolatingMap *map, u32 last_i, f32 distance) {
+   f32 *lens = map->lens;
+   u32 last_interval = map->sample_count - 2;
+   if((last_i > last_interval) || (distance < lens[last_i]))
+      return MapSearch(map, distance);
 
-      last_layer_count = layer_count;
-      last_layer = curr_layer;
-      map->layers[debug_layer_i++] = last_layer;
+   for(u32 step = 0; step < 8; step++) {
+      if((last_i == last_interval) || (distance < lens[last_i + 1]))
+         return last_i;
+      last_i++;
    }
 
-   map->root = last_layer;
+   return MapSearch(map, distance);
+}
+
+//NOTE: t is clamped so lookups off either end of the map just return the end samples
+inline f32 MapLerpT(InterpolatingMap *map, u32 i, f32 distance) {
+   f32 len_a = map->lens[i];
+   f32 len_between = map->lens[i + 1] - len_a;
+   return (len_between > 0) ? Clamp(0, 1, (distance - len_a) / len_between) : 0;
 }
 
 void MapLookup(InterpolatingMap *map, f32 distance, void *result) {
-   u32 sample_count = Power(2, map->sample_exp);
-   InterpolatingMap_Branch *branch = map->root;
-   for(u32 i = 0; i < (map->sample_exp - 1); i++) {
-      branch = (distance > branch->len) ? branch->greater_branch : branch->less_branch;
+   u32 i = MapSearch(map, distance);
+   map->lerp_callback(map->samples + i, map->samples + i + 1, MapLerpT(map, i, distance), result);
+}
+
+//NOTE: result_stride is the size of the type lerp_callback writes out
+void MapLookupMany(InterpolatingMap *map, f32 *distances, u32 count, void *results, u32 result_stride) {
+   u8 *result = (u8 *) results;
+   u32 i = 0;
+   for(u32 j = 0; j < count; j++) {
+      i = MapSearchFrom(map, i, distances[j]);
+      map->lerp_callback(map->samples + i, map->samples + i + 1, MapLerpT(map, i, distances[j]), result);
+      result += result_stride;
    }
+}
 
-   u32 a_i;
-   u32 b_i;
-
-   u32 center_leaf_i = (distance > branch->len) ? branch->greater_leaf : branch->less_leaf;
-   if(distance > map->samples[center_leaf_i].len) {
-      a_i = Clamp(0, sample_count - 1, center_leaf_i);
-      b_i = Clamp(0, sample_count - 1, center_leaf_i + 1);
-   } else {
-      a_i = Clamp(0, sample_count - 1, center_leaf_i - 1);
-      b_i = Clamp(0, sample_count - 1, center_leaf_i);
+void MapLookupMany(InterpolatingMap *map, f32 *distances, u32 count, v2 *results) {
+   u32 i = 0;
+   for(u32 j = 0; j < count; j++) {
+      i = MapSearchFrom(map, i, distances[j]);
+      results[j] = lerp(map->samples[i].data_v2, MapLerpT(map, i, distances[j]), map->samples[i + 1].data_v2);
    }
-
-   InterpolatingMap_Leaf *leaf_a = map->samples + a_i;
-   InterpolatingMap_Leaf *leaf_b = map->samples + b_i;
-
-   f32 t = (distance - leaf_a->len) / (leaf_b->len - leaf_a->len); 
-   map->lerp_callback(leaf_a, leaf_b, t, result);
 }
 
 void interpolation_map_v2_lerp(InterpolatingMap_Leaf *a, InterpolatingMap_Leaf *b, f32 t, void *result) {
@@ -1121,62 +1916,72 @@ NamedMemoryArena *mdbg_first_arena = NULL;
 
 //------------------PLATFORM-SPECIFIC-STUFF---------------------
 #ifdef COMMON_PLATFORM
-   #if defined(_WIN32)
-      //TODO: make stuff thread safe before we re-introduce this stuff
+   //NOTE: arenas & __temp_arena arent thread safe, 
+   //      give each thread its own arenas & allocate them (PlatformAllocArena) from the main thread
+   typedef void (*thread_proc)(void *data);
+
+   struct FileListLink {
+      FileListLink *next;
+      string name;
+      string full_name;
+   };
 
+   #if defined(_WIN32)
       //NOTE: on windows you need to include "windows.h" before common
-      // u32 AtomicIncrement(volatile u32 *x) {
-      //    Assert(( (u64)x & 0x3 ) == 0);
-      //    return InterlockedIncrement(x);
-      // }
-      // #define READ_BARRIER MemoryBarrier()
-      // #define WRITE_BARRIER MemoryBarrier()
-
-      MemoryArenaBlock *PlatformAllocArenaBlock(u64 size) {
-         MemoryArenaBlock *result = (MemoryArenaBlock *) VirtualAlloc(0, sizeof(MemoryArenaBlock) + size, MEM_RESERVE|MEM_COMMIT, PAGE_READWRITE);
-         result->size = size;
-         result->used = 0;
-         result->next = NULL;
-         result->memory = (u8 *) (result + 1);
-         return result;
+      u32 AtomicIncrement(volatile u32 *x) {
+         Assert(( (u64)x & 0x3 ) == 0);
+         return InterlockedIncrement((volatile LONG *) x);
       }
+      #define READ_BARRIER MemoryBarrier()
+      #define WRITE_BARRIER MemoryBarrier()
 
-      MemoryArena *PlatformAllocArena(u64 initial_size, string name) {
-         //NOTE: big joint allocation here
-         //TODO: make joint allocations easier??
-         u8 *memory = (u8 *) VirtualAlloc(0, 
-            sizeof(NamedMemoryArena) + name.length + sizeof(MemoryArenaBlock) + initial_size, 
-            MEM_RESERVE|MEM_COMMIT, PAGE_READWRITE);
-         
-         NamedMemoryArena *named_arena = (NamedMemoryArena *) memory;
-         u8 *string_text = (u8 *) (memory + sizeof(NamedMemoryArena));
-         MemoryArenaBlock *first_block = (MemoryArenaBlock *) (memory + sizeof(NamedMemoryArena) + name.length);
-         u8 *block_memory = (u8 *) (memory + sizeof(NamedMemoryArena) + name.length + sizeof(MemoryArenaBlock));
-
-         //NOTE: initializing everything
-         first_block->size = initial_size;
-         first_block->used = 0;
-         first_block->next = NULL;
-         first_block->memory = block_memory;
-         
-         named_arena->name = String((char *) string_text, name.length);
-         Copy(name.text, name.length, named_arena->name.text); 
+      struct PlatformThread {
+         HANDLE handle;
+         thread_proc proc;
+         void *data;
+      };
+
+      DWORD WINAPI Win32ThreadProc(LPVOID param) {
+         PlatformThread *thread = (PlatformThread *) param;
+         thread->proc(thread->data);
+         return 0;
+      }
 
-         ZeroStruct(&named_arena->arena);
-         named_arena->arena.first_block = first_block;
-         named_arena->arena.curr_block = first_block;
-         named_arena->arena.initial_size = initial_size;
-         named_arena->arena.valid = true;
-         named_arena->arena.alloc_block = PlatformAllocArenaBlock;
+      //NOTE: thread has to stay alive until JoinThread
+      void StartThread(PlatformThread *thread, thread_proc proc, void *data) {
+         thread->proc = proc;
+         thread->data = data;
+         thread->handle = CreateThread(NULL, 0, Win32ThreadProc, thread, 0, NULL);
+         Assert(thread->handle != NULL);
+      }
 
-         named_arena->next = mdbg_first_arena;
-         mdbg_first_arena = named_arena;
+      void JoinThread(PlatformThread *thread) {
+         WaitForSingleObject(thread->handle, INFINITE);
+         CloseHandle(thread->handle);
+         thread->handle = NULL;
+      }
 
-         return &named_arena->arena;
+      //NOTE: zero initialized is unlocked, sleeps instead of spinning so its fine with more threads than cores
+      struct Mutex {
+         SRWLOCK srw_lock;
+      };
+
+      void BeginMutex(Mutex *mutex) {
+         AcquireSRWLockExclusive(&mutex->srw_lock);
       }
 
-      MemoryArena *PlatformAllocArena(u64 initial_size, char *name) {
-         return PlatformAllocArena(initial_size, Literal(name));
+      void EndMutex(Mutex *mutex) {
+         ReleaseSRWLockExclusive(&mutex->srw_lock);
+      }
+
+      u32 GetProcessorCount() {
+         SYSTEM_INFO info = {};
+         GetSystemInfo(&info);
+         return Max(1, info.dwNumberOfProcessors);
+      }
+
+      u8 *PlatformAllocMemory(u64 size) {
+         return (u8 *) VirtualAlloc(0, size, MEM_RESERVE|MEM_COMMIT, PAGE_READWRITE);
       }
 
       //TODO: ReadFileRange()
@@ -1203,8 +2008,53 @@ NamedMemoryArena *mdbg_first_arena = NULL;
          return result;
       }
 
-      buffer ReadEntireFile(string path, bool in_exe_directory = false) {
-         return ReadEntireFile(ToCString(path), in_exe_directory);
+      struct MappedFile {
+         HANDLE file_handle;
+         HANDLE mapping_handle;
+         buffer data; //NOTE: read only
+      };
+
+      //NOTE: no copy, data points straight at the mapping & stays valid until UnmapFile
+      MappedFile MapEntireFile(const char *path) {
+         MappedFile result = {};
+         result.file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ,
+                                          NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+         
+         if(result.file_handle != INVALID_HANDLE_VALUE) {
+            u32 size = GetFileSize(result.file_handle, NULL);
+            //NOTE: CreateFileMapping fails on empty files
+            if(size > 0)
+               result.mapping_handle = CreateFileMappingA(result.file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+            
+            if(result.mapping_handle != NULL) {
+               result.data.data = (u8 *) MapViewOfFile(result.mapping_handle, FILE_MAP_READ, 0, 0, 0);
+               result.data.size = size;
+            }
+         } else {
+            OutputDebugStringA("File map error\n");
+            result.file_handle = NULL;
+         }
+
+         if(result.data.data == NULL) {
+            if(result.mapping_handle != NULL)
+               CloseHandle(result.mapping_handle);
+            if(result.file_handle != NULL)
+               CloseHandle(result.file_handle);
+            
+            result = {};
+         }
+
+         return result;
+      }
+
+      void UnmapFile(MappedFile *file) {
+         if(file->data.data != NULL) {
+            UnmapViewOfFile(file->data.data);
+            CloseHandle(file->mapping_handle);
+            CloseHandle(file->file_handle);
+         }
+
+         *file = {};
       }
 
       void WriteEntireFile(const char* path, buffer file) {
@@ -1218,25 +2068,48 @@ NamedMemoryArena *mdbg_first_arena = NULL;
          }
       }
 
-      void WriteEntireFile(string path, buffer file) {
-         return WriteEntireFile(ToCString(path), file);
-      }
+      //NOTE: writes to "path.tmp" then renames it over path, 
+      //      so if we crash mid-write the old file is still there instead of half a new one
+      bool ReplaceEntireFile(const char *path, buffer file) {
+         char temp_path[MAX_PATH + 1];
+         snprintf(temp_path, ArraySize(temp_path), "%s.tmp", path);
+
+         HANDLE file_handle = CreateFileA(temp_path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                                          FILE_ATTRIBUTE_NORMAL, NULL);
+         if(file_handle == INVALID_HANDLE_VALUE)
+            return false;
+
+         DWORD number_of_bytes_written = 0;
+         BOOL written = WriteFile(file_handle, file.data, file.offset, &number_of_bytes_written, NULL) &&
+                        (number_of_bytes_written == file.offset) &&
+                        FlushFileBuffers(file_handle);
+         CloseHandle(file_handle);
+
+         if(!written || !MoveFileExA(temp_path, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+            OutputDebugStringA("File replace error\n");
+            DeleteFileA(temp_path);
+            return false;
+         }
 
-      //TODO!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+         return true;
+      }
 
       //NOTE: this creates a file only if the file didnt already exist
       //      won't totally overwrite existing files like WriteEntireFile
-      // void WriteFileRange(const char* path, buffer file, u64 offset) {
-      //    HANDLE file_handle = CreateFileA(path, GENERIC_WRITE, 0, NULL, OPEN_ALWAYS,
-      //                                     FILE_ATTRIBUTE_NORMAL, NULL);
+      void WriteFileRange(const char* path, buffer file, u64 offset) {
+         HANDLE file_handle = CreateFileA(path, GENERIC_WRITE, 0, NULL, OPEN_ALWAYS,
+                                          FILE_ATTRIBUTE_NORMAL, NULL);
                                           
-      //    if(file_handle != INVALID_HANDLE_VALUE) {
-      //       //TODO: write at offset
-      //       // DWORD number_of_bytes_written;
-      //       // WriteFile(file_handle, file.data, file.offset, &number_of_bytes_written, NULL);
-      //       CloseHandle(file_handle);
-      //    }
-      // }
+         if(file_handle != INVALID_HANDLE_VALUE) {
+            LARGE_INTEGER distance = {};
+            distance.QuadPart = offset;
+            SetFilePointerEx(file_handle, distance, NULL, FILE_BEGIN);
+
+            DWORD number_of_bytes_written;
+            WriteFile(file_handle, file.data, file.offset, &number_of_bytes_written, NULL);
+            CloseHandle(file_handle);
+         }
+      }
 
       void WriteFileAppend(const char* path, buffer file) {
          HANDLE file_handle = CreateFileA(path, GENERIC_WRITE | FILE_APPEND_DATA, 
@@ -1251,24 +2124,14 @@ NamedMemoryArena *mdbg_first_arena = NULL;
          }
       }
 
-      void WriteFileAppend(string path, buffer file) {
-         return WriteFileAppend(ToCString(path), file);
+      void RemoveFile(const char *path) {
+         DeleteFileA(path);
       }
 
       void CreateFolder(const char* path) {
          CreateDirectoryA(path, NULL);
       }
 
-      void CreateFolder(string path) {
-         CreateFolder(ToCString(path));
-      }
-
-      struct FileListLink {
-         FileListLink *next;
-         string name;
-         string full_name;
-      };
-
       FileListLink *ListFilesWithExtension(char *wildcard_extension, MemoryArena *arena = __temp_arena) {
          WIN32_FIND_DATAA file = {};
          HANDLE handle = FindFirstFileA(wildcard_extension, &file);
@@ -1319,129 +2182,344 @@ NamedMemoryArena *mdbg_first_arena = NULL;
                ((u64)last_write_time.dwHighDateTime << 32);
       }
 
-      u64 GetFileTimestamp(string path, bool in_exe_directory = false) {
-         return GetFileTimestamp(ToCString(path), in_exe_directory);
+      //NOTE: this is pretty jank-tastic but itll get cleaned up in future
+      char exepath[MAX_PATH + 1];
+      void Win32CommonInit(MemoryArena *temp_arena) {
+         __temp_arena = temp_arena;
+
+         if(0 == GetModuleFileNameA(0, exepath, MAX_PATH + 1))
+            Assert(false);
+            
+         exe_directory = Literal(exepath);
+         for(u32 i = exe_directory.length - 1; i >= 0; i--) {
+            if((exe_directory.text[i] == '\\') || (exe_directory.text[i] == '/'))
+               break;
+
+            exe_directory.length--;
+         }
+
+         //TODO: setup a console for logging when we're not running in visual studios
+      }
+
+      struct Timer {
+         LARGE_INTEGER frequency;
+         LARGE_INTEGER last_time;
+      };
+
+      Timer InitTimer() {
+         Timer result = {};
+         QueryPerformanceFrequency(&result.frequency);
+         QueryPerformanceCounter(&result.last_time);
+         return result;
       }
 
-      struct FileWatcherLink {
-         FileWatcherLink *next_in_list;
-         FileWatcherLink *next_in_hash;
+      f32 GetDT(Timer *timer) {
+         LARGE_INTEGER new_time;
+         QueryPerformanceCounter(&new_time);
+         f32 dt = (f32)(new_time.QuadPart - timer->last_time.QuadPart) / (f32)timer->frequency.QuadPart;
+         timer->last_time = new_time;
+         
+         return dt;
+      }
 
-         bool found;
+   #elif defined(__linux__)
+      //NOTE: theres no window or GL layer on linux, this is just enough for the headless tools
+      #include <pthread.h>
+      #include <fcntl.h>
+      #include <unistd.h>
+      #include <dirent.h>
+      #include <time.h>
+      #include <limits.h>
+      #include <sys/mman.h>
+      #include <sys/stat.h>
+
+      u32 AtomicIncrement(volatile u32 *x) {
+         Assert(( (u64)x & 0x3 ) == 0);
+         return __sync_add_and_fetch(x, 1);
+      }
+      #define READ_BARRIER __sync_synchronize()
+      #define WRITE_BARRIER __sync_synchronize()
 
-         u64 timestamp;
-         string name;
+      struct PlatformThread {
+         pthread_t handle;
+         thread_proc proc;
+         void *data;
       };
-      
-      struct FileWatcher {
-         //NOTE: this needs its own memory because it has to persist
-         MemoryArena *arena; //NOTE: FileWatcher ownes this
-         string wildcard_extension;
 
-         FileWatcherLink *first_in_list;
-         FileWatcherLink *hash[64];
+      void *LinuxThreadProc(void *param) {
+         PlatformThread *thread = (PlatformThread *) param;
+         thread->proc(thread->data);
+         return NULL;
+      }
+
+      //NOTE: thread has to stay alive until JoinThread
+      void StartThread(PlatformThread *thread, thread_proc proc, void *data) {
+         thread->proc = proc;
+         thread->data = data;
+         int error = pthread_create(&thread->handle, NULL, LinuxThreadProc, thread);
+         Assert(error == 0);
+      }
+
+      void JoinThread(PlatformThread *thread) {
+         pthread_join(thread->handle, NULL);
+      }
+
+      //NOTE: zero initialized is unlocked (PTHREAD_MUTEX_INITIALIZER is all 0s on linux)
+      struct Mutex {
+         pthread_mutex_t mutex;
       };
 
-      void InitFileWatcher(FileWatcher *watcher, MemoryArena *arena, string wildcard_extension) {
-         watcher->arena = arena;
-         watcher->wildcard_extension = PushCopy(watcher->arena, wildcard_extension);
+      void BeginMutex(Mutex *mutex) {
+         pthread_mutex_lock(&mutex->mutex);
       }
-      
-      void InitFileWatcher(FileWatcher *watcher, MemoryArena *arena, char *wildcard_extension) {
-         InitFileWatcher(watcher, arena, Literal(wildcard_extension));
+
+      void EndMutex(Mutex *mutex) {
+         pthread_mutex_unlock(&mutex->mutex);
+      }
+
+      u32 GetProcessorCount() {
+         long count = sysconf(_SC_NPROCESSORS_ONLN);
+         return (count > 0) ? (u32) count : 1;
       }
 
-      //NOTE: updates file watcher, returns true if file timestamps have changed
-      bool CheckFiles(FileWatcher *watcher) {
-         MemoryArena *arena = watcher->arena;
+      //NOTE: theres no debugger output window, so debug strings go to stderr
+      void OutputDebugStringA(const char *text) {
+         fputs(text, stderr);
+      }
 
-         for(FileWatcherLink *curr = watcher->first_in_list;
-             curr; curr = curr->next_in_list)
-         {
-            curr->found = false;
+      //NOTE: anonymous mappings come back zeroed, same as VirtualAlloc
+      u8 *PlatformAllocMemory(u64 size) {
+         void *memory = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+         Assert(memory != MAP_FAILED);
+         return (u8 *) memory;
+      }
+
+      buffer ReadEntireFile(const char* path, bool in_exe_directory = false, MemoryArena *arena = __temp_arena) {
+         char full_path[PATH_MAX + 1];
+         snprintf(full_path, ArraySize(full_path), "%.*s%s", exe_directory.length, exe_directory.text, path);
+
+         int file_handle = open(in_exe_directory ? full_path : path, O_RDONLY);
+         struct stat file_info = {};
+
+         buffer result = {};
+         if((file_handle != -1) && (fstat(file_handle, &file_info) == 0)) {
+            result.size = file_info.st_size;
+            result.data = (u8 *) PushSize(arena, result.size);
+            
+            u64 bytes_read = 0;
+            while(bytes_read < result.size) {
+               ssize_t count = read(file_handle, result.data + bytes_read, result.size - bytes_read);
+               if(count <= 0)
+                  break;
+               bytes_read += count;
+            }
+            result.size = bytes_read;
+         } else {
+            OutputDebugStringA("File read error\n");
          }
 
-         bool changed = false;
-         for(FileListLink *file = ListFilesWithExtension(ToCString(watcher->wildcard_extension)); 
-             file; file = file->next)
-         {
-            FileWatcherLink *link = NULL;
-            u32 hash = Hash(file->full_name) % ArraySize(watcher->hash);
-            for(FileWatcherLink *curr = watcher->hash[hash];
-                curr; curr = curr->next_in_hash)
-            {
-               if(curr->name == file->full_name) {
-                  link = curr;
+         if(file_handle != -1)
+            close(file_handle);
+         
+         return result;
+      }
+
+      struct MappedFile {
+         int file_handle;
+         buffer data; //NOTE: read only
+      };
+
+      //NOTE: no copy, data points straight at the mapping & stays valid until UnmapFile
+      MappedFile MapEntireFile(const char *path) {
+         MappedFile result = {};
+         result.file_handle = open(path, O_RDONLY);
+         
+         if(result.file_handle != -1) {
+            struct stat file_info = {};
+            //NOTE: mmap fails on empty files
+            if((fstat(result.file_handle, &file_info) == 0) && (file_info.st_size > 0)) {
+               void *memory = mmap(NULL, file_info.st_size, PROT_READ, MAP_PRIVATE, result.file_handle, 0);
+               if(memory != MAP_FAILED) {
+                  result.data.data = (u8 *) memory;
+                  result.data.size = file_info.st_size;
                }
             }
+         } else {
+            OutputDebugStringA("File map error\n");
+         }
 
-            if(link == NULL) {
-               changed = true;
-               FileWatcherLink *new_link = PushStruct(arena, FileWatcherLink);
-               new_link->name = PushCopy(arena, file->full_name);
-               
-               new_link->next_in_list = watcher->first_in_list;
-               watcher->first_in_list = new_link;
-               new_link->next_in_hash = watcher->hash[hash];
-               watcher->hash[hash] = new_link;
+         if(result.data.data == NULL) {
+            if(result.file_handle != -1)
+               close(result.file_handle);
+            
+            result = {};
+         }
 
-               link = new_link;
-            }
+         return result;
+      }
 
-            link->found = true;
-            u64 timestamp = GetFileTimestamp(file->name);
-            if(link->timestamp != timestamp) {
-               link->timestamp = timestamp;
-               changed = true;
-            }
+      void UnmapFile(MappedFile *file) {
+         if(file->data.data != NULL) {
+            munmap(file->data.data, file->data.size);
+            close(file->file_handle);
          }
-         
-         for(FileWatcherLink *curr = watcher->first_in_list;
-             curr; curr = curr->next_in_list)
-         {
-            if(curr->found == false) {
-               changed = true;
+
+         *file = {};
+      }
+
+      //NOTE: write can stop early (eg. signals), keep going until everything is out
+      bool LinuxWriteAll(int file_handle, buffer file) {
+         u64 bytes_written = 0;
+         while(bytes_written < file.offset) {
+            ssize_t count = write(file_handle, file.data + bytes_written, file.offset - bytes_written);
+            if(count <= 0)
+               return false;
+            bytes_written += count;
+         }
+         return true;
+      }
+
+      void WriteEntireFile(const char* path, buffer file) {
+         int file_handle = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+         if(file_handle != -1) {
+            LinuxWriteAll(file_handle, file);
+            close(file_handle);
+         }
+      }
+
+      //NOTE: writes to "path.tmp" then renames it over path, 
+      //      so if we crash mid-write the old file is still there instead of half a new one
+      bool ReplaceEntireFile(const char *path, buffer file) {
+         char temp_path[PATH_MAX + 1];
+         snprintf(temp_path, ArraySize(temp_path), "%s.tmp", path);
+
+         int file_handle = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+         if(file_handle == -1)
+            return false;
+
+         bool written = LinuxWriteAll(file_handle, file) && (fsync(file_handle) == 0);
+         close(file_handle);
+
+         if(!written || (rename(temp_path, path) != 0)) {
+            OutputDebugStringA("File replace error\n");
+            unlink(temp_path);
+            return false;
+         }
+
+         return true;
+      }
+
+      //NOTE: this creates a file only if the file didnt already exist
+      //      won't totally overwrite existing files like WriteEntireFile
+      void WriteFileRange(const char* path, buffer file, u64 offset) {
+         int file_handle = open(path, O_WRONLY | O_CREAT, 0644);
+         if(file_handle != -1) {
+            if(lseek(file_handle, offset, SEEK_SET) != -1)
+               LinuxWriteAll(file_handle, file);
+            close(file_handle);
+         }
+      }
+
+      void WriteFileAppend(const char* path, buffer file) {
+         int file_handle = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+         if(file_handle != -1) {
+            LinuxWriteAll(file_handle, file);
+            close(file_handle);
+         }
+      }
+
+      void RemoveFile(const char *path) {
+         unlink(path);
+      }
+
+      void CreateFolder(const char* path) {
+         mkdir(path, 0755);
+      }
+
+      //NOTE: only handles the "*.ext" & "*.*" wildcards we actually use, matches against the current directory
+      FileListLink *ListFilesWithExtension(char *wildcard_extension, MemoryArena *arena = __temp_arena) {
+         Assert(wildcard_extension[0] == '*');
+         string extension = Literal(wildcard_extension + 1);
+         bool match_all = (extension == Literal(".*"));
+
+         FileListLink *result = NULL;
+         DIR *directory = opendir(".");
+         if(directory != NULL) {
+            while(struct dirent *file = readdir(directory)) {
+               string full_name = Literal(file->d_name);
+               
+               if((full_name == Literal(".")) ||
+                  (full_name == Literal("..")))
+               {
+                  continue;
+               }
+
+               if(!match_all && 
+                  ((full_name.length < extension.length) || 
+                   (String(full_name.text + full_name.length - extension.length, extension.length) != extension)))
+               {
+                  continue;
+               }
+               
+               u32 name_length = 0;
+               for(u32 i = 0; i < full_name.length; i++) {
+                  if(full_name.text[i] == '.') {
+                     name_length = i;
+                     break;
+                  }
+               }
+               
+               FileListLink *new_link = PushStruct(arena, FileListLink);
+               new_link->full_name = PushCopy(arena, full_name);
+               new_link->name = String(new_link->full_name.text, name_length);
+               new_link->next = result;
+               result = new_link;
             }
+            closedir(directory);
          }
+         return result;
+      }
+   
+      u64 GetFileTimestamp(const char* path, bool in_exe_directory = false) {
+         char full_path[PATH_MAX + 1];
+         snprintf(full_path, ArraySize(full_path), "%.*s%s", exe_directory.length, exe_directory.text, path);
+         
+         struct stat file_info = {};
+         if(stat(in_exe_directory ? full_path : path, &file_info) != 0)
+            return 0;
          
-         return changed;
+         return (u64) file_info.st_mtim.tv_sec * 1000000000 + (u64) file_info.st_mtim.tv_nsec;
       }
-      
-      //NOTE: this is pretty jank-tastic but itll get cleaned up in future
-      char exepath[MAX_PATH + 1];
-      void Win32CommonInit(MemoryArena *temp_arena) {
+
+      char exepath[PATH_MAX + 1];
+      void LinuxCommonInit(MemoryArena *temp_arena) {
          __temp_arena = temp_arena;
 
-         if(0 == GetModuleFileNameA(0, exepath, MAX_PATH + 1))
-            Assert(false);
+         ssize_t length = readlink("/proc/self/exe", exepath, PATH_MAX);
+         Assert(length > 0);
+         exepath[length] = '\0';
             
          exe_directory = Literal(exepath);
-         for(u32 i = exe_directory.length - 1; i >= 0; i--) {
-            if((exe_directory.text[i] == '\\') || (exe_directory.text[i] == '/'))
-               break;
-
+         while((exe_directory.length > 0) && (exe_directory.text[exe_directory.length - 1] != '/')) {
             exe_directory.length--;
          }
-
-         //TODO: setup a console for logging when we're not running in visual studios
       }
 
       struct Timer {
-         LARGE_INTEGER frequency;
-         LARGE_INTEGER last_time;
+         timespec last_time;
       };
 
       Timer InitTimer() {
          Timer result = {};
-         QueryPerformanceFrequency(&result.frequency);
-         QueryPerformanceCounter(&result.last_time);
+         clock_gettime(CLOCK_MONOTONIC, &result.last_time);
          return result;
       }
 
       f32 GetDT(Timer *timer) {
-         LARGE_INTEGER new_time;
-         QueryPerformanceCounter(&new_time);
-         f32 dt = (f32)(new_time.QuadPart - timer->last_time.QuadPart) / (f32)timer->frequency.QuadPart;
+         timespec new_time = {};
+         clock_gettime(CLOCK_MONOTONIC, &new_time);
+         f32 dt = (f32)(new_time.tv_sec - timer->last_time.tv_sec) + 
+                  (f32)(new_time.tv_nsec - timer->last_time.tv_nsec) / 1000000000.0f;
          timer->last_time = new_time;
          
          return dt;
@@ -1450,6 +2528,190 @@ NamedMemoryArena *mdbg_first_arena = NULL;
    #else
       #error "we dont support that platform yet"
    #endif
+
+   //NOTE: everything below is built on top of the platform specific functions above
+   MemoryArenaBlock *PlatformAllocArenaBlock(u64 size) {
+      MemoryArenaBlock *result = (MemoryArenaBlock *) PlatformAllocMemory(sizeof(MemoryArenaBlock) + size);
+      result->size = size;
+      result->used = 0;
+      result->next = NULL;
+      result->memory = (u8 *) (result + 1);
+      return result;
+   }
+
+   MemoryArena *PlatformAllocArena(u64 initial_size, string name) {
+      //NOTE: big joint allocation here
+      //TODO: make joint allocations easier??
+      u8 *memory = PlatformAllocMemory(sizeof(NamedMemoryArena) + name.length + sizeof(MemoryArenaBlock) + initial_size);
+      
+      NamedMemoryArena *named_arena = (NamedMemoryArena *) memory;
+      u8 *string_text = (u8 *) (memory + sizeof(NamedMemoryArena));
+      MemoryArenaBlock *first_block = (MemoryArenaBlock *) (memory + sizeof(NamedMemoryArena) + name.length);
+      u8 *block_memory = (u8 *) (memory + sizeof(NamedMemoryArena) + name.length + sizeof(MemoryArenaBlock));
+
+      //NOTE: initializing everything
+      first_block->size = initial_size;
+      first_block->used = 0;
+      first_block->next = NULL;
+      first_block->memory = block_memory;
+      
+      named_arena->name = String((char *) string_text, name.length);
+      Copy(name.text, name.length, named_arena->name.text); 
+
+      ZeroStruct(&named_arena->arena);
+      named_arena->arena.first_block = first_block;
+      named_arena->arena.curr_block = first_block;
+      named_arena->arena.initial_size = initial_size;
+      named_arena->arena.valid = true;
+      named_arena->arena.alloc_block = PlatformAllocArenaBlock;
+
+      named_arena->next = mdbg_first_arena;
+      mdbg_first_arena = named_arena;
+
+      return &named_arena->arena;
+   }
+
+   MemoryArena *PlatformAllocArena(u64 initial_size, char *name) {
+      return PlatformAllocArena(initial_size, Literal(name));
+   }
+
+   buffer ReadEntireFile(string path, bool in_exe_directory = false) {
+      return ReadEntireFile(ToCString(path), in_exe_directory);
+   }
+
+   MappedFile MapEntireFile(string path) {
+      return MapEntireFile(ToCString(path));
+   }
+
+   void WriteEntireFile(string path, buffer file) {
+      return WriteEntireFile(ToCString(path), file);
+   }
+
+   bool ReplaceEntireFile(string path, buffer file) {
+      return ReplaceEntireFile(ToCString(path), file);
+   }
+
+   void WriteFileRange(string path, buffer file, u64 offset) {
+      WriteFileRange(ToCString(path), file, offset);
+   }
+
+   void WriteFileAppend(string path, buffer file) {
+      return WriteFileAppend(ToCString(path), file);
+   }
+
+   void RemoveFile(string path) {
+      RemoveFile(ToCString(path));
+   }
+
+   void CreateFolder(string path) {
+      CreateFolder(ToCString(path));
+   }
+
+   u64 GetFileTimestamp(string path, bool in_exe_directory = false) {
+      return GetFileTimestamp(ToCString(path), in_exe_directory);
+   }
+
+   struct FileWatcherLink {
+      FileWatcherLink *next_in_list;
+      FileWatcherLink *next_in_hash;
+
+      bool found;
+
+      u64 timestamp;
+      string name;
+   };
+   
+   struct FileWatcher {
+      //NOTE: this needs its own memory because it has to persist
+      MemoryArena *arena; //NOTE: FileWatcher ownes this
+      string wildcard_extension;
+
+      FileWatcherLink *first_in_list;
+      FileWatcherLink *hash[64];
+   };
+
+   void InitFileWatcher(FileWatcher *watcher, MemoryArena *arena, string wildcard_extension) {
+      watcher->arena = arena;
+      watcher->wildcard_extension = PushCopy(watcher->arena, wildcard_extension);
+   }
+   
+   void InitFileWatcher(FileWatcher *watcher, MemoryArena *arena, char *wildcard_extension) {
+      InitFileWatcher(watcher, arena, Literal(wildcard_extension));
+   }
+
+   void RemoveFromHash(FileWatcher *watcher, FileWatcherLink *link) {
+      u32 hash = Hash(link->name) % ArraySize(watcher->hash);
+      for(FileWatcherLink **curr = watcher->hash + hash; *curr; curr = &(*curr)->next_in_hash) {
+         if(*curr == link) {
+            *curr = link->next_in_hash;
+            break;
+         }
+      }
+   }
+
+   //NOTE: updates file watcher, returns true if file timestamps have changed
+   //      after this links with found == false are files that just got deleted, 
+   //      they get dropped the next time CheckFiles is called
+   bool CheckFiles(FileWatcher *watcher) {
+      MemoryArena *arena = watcher->arena;
+
+      for(FileWatcherLink **curr = &watcher->first_in_list; *curr;) {
+         FileWatcherLink *link = *curr;
+         if(link->found == false) {
+            RemoveFromHash(watcher, link);
+            *curr = link->next_in_list;
+         } else {
+            link->found = false;
+            curr = &link->next_in_list;
+         }
+      }
+
+      bool changed = false;
+      for(FileListLink *file = ListFilesWithExtension(ToCString(watcher->wildcard_extension)); 
+          file; file = file->next)
+      {
+         FileWatcherLink *link = NULL;
+         u32 hash = Hash(file->full_name) % ArraySize(watcher->hash);
+         for(FileWatcherLink *curr = watcher->hash[hash];
+             curr; curr = curr->next_in_hash)
+         {
+            if(curr->name == file->full_name) {
+               link = curr;
+            }
+         }
+
+         if(link == NULL) {
+            changed = true;
+            FileWatcherLink *new_link = PushStruct(arena, FileWatcherLink);
+            new_link->name = PushCopy(arena, file->full_name);
+            
+            new_link->next_in_list = watcher->first_in_list;
+            watcher->first_in_list = new_link;
+            new_link->next_in_hash = watcher->hash[hash];
+            watcher->hash[hash] = new_link;
+
+            link = new_link;
+         }
+
+         link->found = true;
+         u64 timestamp = GetFileTimestamp(file->full_name);
+         if(link->timestamp != timestamp) {
+            link->timestamp = timestamp;
+            changed = true;
+         }
+      }
+      
+      for(FileWatcherLink *curr = watcher->first_in_list;
+          curr; curr = curr->next_in_list)
+      {
+         if(curr->found == false) {
+            changed = true;
+         }
+      }
+      
+      return changed;
+   }
+   
 #endif
 //------------------------------------------------------------------
 
@@ -16,6 +16,7 @@ struct texture {
 
 texture loadTexture(char *path, bool in_exe_directory = false);
 texture createTexture(u32 *texels, u32 width, u32 height);
+texture createTexture(u32 **level_texels, u32 width, u32 height, u32 level_count);
 void deleteTexture(texture tex);
 
 struct glyph_texture {
@@ -425,15 +426,6 @@ void Arc(element *e, v2 center, f32 radius, f32 angle1, f32 angle2, bool clockwi
    _Line(e, colour, thickness, points, point_count, false);
 }
 
-v2 DirectionNormal(f32 angle) {
-   return V2(cosf(ToRadians(angle)), 
-             -sinf(ToRadians(angle)));
-}
-
-f32 Angle(v2 v) {
-   return ToDegrees(atan2(-v.y, v.x));
-}
-
 RenderCommand *Texture(element *e, texture tex, rect2 bounds, v4 colour = WHITE) {
    UIContext *context = e->context;
    RenderCommand *result = PushStruct(context->frame_arena, RenderCommand);
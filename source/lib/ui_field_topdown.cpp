@@ -50,11 +50,11 @@ void CubicHermiteSpline(ui_field_topdown *field,
                         v4 colour, f32 thickness = 2)
 {
    u32 point_count = 20;
-   f32 step = (f32)1 / (f32)(point_count - 1);
    v2 *points = PushTempArray(v2, point_count);
+   CubicHermiteSplineBatch(a_pos, a_tan, b_pos, b_tan, point_count, points);
 
    for(u32 i = 0; i < point_count; i++) {
-      points[i] = GetPoint(field, CubicHermiteSpline(a_pos, a_tan, b_pos, b_tan, i * step));
+      points[i] = GetPoint(field, points[i]);
    }
 
    _Line(field->e, colour, thickness, points, point_count);
@@ -63,12 +63,13 @@ image ReadImage(char *path, bool in_exe_directory) {
 
    if(file.data != NULL) {
       s32 width, height, channels;
+      //NOTE: always ask for 4 channels, texels get used as RGBA u32s even if the file is RGB
       u32 *data = (u32 *) stbi_load_from_memory((u8 *) file.data, file.size,
-                                                &width, &height, &channels, 0);
+                                                &width, &height, &channels, 4);
       result.width = width;
       result.height = height;
       result.texels = data;
-      result.valid = true;
+      result.valid = (data != NULL);
    }
 
    return result;
@@ -108,6 +109,26 @@ texture createTexture(u32 *texels, u32 width, u32 height) {
    return result;
 }
 
+//NOTE: level_texels[0] is width x height, each level after it is half the one before (rounded down, at least 1)
+texture createTexture(u32 **level_texels, u32 width, u32 height, u32 level_count) {
+   texture result = {};
+   result.size = V2(width, height);
+      
+   glGenTextures(1, &result.handle);
+   glBindTexture(GL_TEXTURE_2D, result.handle);
+      for(u32 i = 0; i < level_count; i++) {
+         glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, level_texels[i]);
+         width = Max(1, width / 2);
+         height = Max(1, height / 2);
+      }
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level_count - 1);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (level_count > 1) ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+   glBindTexture(GL_TEXTURE_2D, 0);
+
+   return result;
+}
+
 void deleteTexture(texture tex) {
    if(tex.handle != 0)
       glDeleteTextures(1, &tex.handle); 
@@ -10,13 +10,31 @@ void PacketHandler_State(buffer *packet, EditorState *state) {
    
 }
 
+void PacketHandler_StateSchema(buffer *packet, EditorState *state) {
+   RecieveStateSchemaPacket(&state->profiles.current, *packet);
+}
+
+void PacketHandler_State_V2(buffer *packet, EditorState *state) {
+   //NOTE: a packet for a schema we dont have yet gets skipped, the robot's StateSchema is on its way
+   if(!RecieveStateV2Packet(&state->profiles.current, *packet))
+      OutputDebugStringA("State_V2 packet doesnt match the schema, skipping it\n");
+}
+
 void HandlePacket(EditorState *state, PacketType::type type, buffer packet) {
+   //NOTE: after this the packet handlers can parse without checking anything
+   if(!ValidatePacket(type, packet))
+      return;
+
    if(type == PacketType::Welcome) {
       PacketHandler_Welcome(&packet, state);
    } else if(type == PacketType::CurrentParameters) {
       PacketHandler_CurrentParameters(&packet, state);
    } else if(type == PacketType::State) {
       PacketHandler_State(&packet, state);
+   } else if(type == PacketType::StateSchema) {
+      PacketHandler_StateSchema(&packet, state);
+   } else if(type == PacketType::State_V2) {
+      PacketHandler_State_V2(&packet, state);
    }
 }
 
@@ -28,4 +46,8 @@ void HandleDisconnect(EditorState *state) {
    if(state->profiles.selected == &state->profiles.current) {
       state->profiles.selected = NULL;
    }
+}
+
+char *GetConnectionTarget(EditorState *state) {
+   return (state->settings.team_number == 0) ? "127.0.0.1" : "10.0.5.4";
 }
\ No newline at end of file
@@ -43,9 +43,58 @@ struct Field_StartingPosition {
    f32 angle;
 };
 
+//NOTE: level 0 is the full image, every level after it is half the one before (rounded down, at least 1)
+//      down to 1x1, each level is cut into FIELD_IMAGE_TILE_SIZE tiles that get compressed on their own
+struct Field_ImageLevel {
+#define FIELD_IMAGE_TILE_SIZE 256
+   u16 width;
+   u16 height;
+   u32 offset; //NOTE: from the start of the file to tile_ends
+   //(at offset) u32 tile_ends [tile_count], tiles go left to right then top to bottom,
+   //   end of each tile's data from the end of tile_ends, each tile starts where the last one ended
+   //(after tile_ends) tile data, LZCompress-ed RGBA, each byte minus the same channel of the texel 
+   //   to its left (or above it for the first texel in a row)
+};
+
 struct Field_FileHeader {
 #define FIELD_MAGIC_NUMBER RIFF_CODE("NCFF") 
-#define FIELD_CURR_VERSION 0
+#define FIELD_CURR_VERSION 1
+#define FIELD_MAX_STARTING_POSITIONS 16
+   f32 width; //in ft
+   f32 height; //in ft
+   u32 flags;
+   u8 starting_position_count;
+   u16 image_width;
+   u16 image_height;
+   u8 image_level_count;
+
+   //NOTE: always FIELD_MAX_STARTING_POSITIONS of them so the header is a fixed size, 
+   //      changing the settings just rewrites the header in place & leaves the image alone
+   Field_StartingPosition starting_positions[FIELD_MAX_STARTING_POSITIONS];
+   //Field_ImageLevel [image_level_count]
+};
+
+inline u32 FieldImageLevelCount(u32 width, u32 height) {
+   if((width == 0) || (height == 0))
+      return 0;
+   
+   u32 result = 1;
+   while((width > 1) || (height > 1)) {
+      width = Max(1, width / 2);
+      height = Max(1, height / 2);
+      result++;
+   }
+   return result;
+}
+
+inline u32 FieldImageTileCount(u32 width, u32 height) {
+   return ((width + FIELD_IMAGE_TILE_SIZE - 1) / FIELD_IMAGE_TILE_SIZE) * 
+          ((height + FIELD_IMAGE_TILE_SIZE - 1) / FIELD_IMAGE_TILE_SIZE);
+}
+
+//NOTE: old uncompressed format, still gets read & gets upgraded the first time its saved
+struct Field_FileHeader_V0 {
+#define FIELD_V0_VERSION 0
    f32 width; //in ft
    f32 height; //in ft
    u32 flags;
@@ -107,14 +156,25 @@ struct RobotProfile_FileHeader {
 //-----------------------------------------------------------
 
 //RobotRecording---------------------------------------------
+//NOTE: sample_count f32s (as their u32 bits) in blocks of PACKED_BLOCK_SIZE, each value is the zigzagged
+//      delta (order 1) or delta of delta (order 2) from the ones before it, bit packed at the block's bit_width
+struct RobotRecording_PackedColumn {
+   u8 order;
+   u32 first;
+   u32 first_delta; //NOTE: only used by order 2
+   //u8 bit_width [block_count]
+   //u32 [PackedBlockWordCount(block sample_count, bit_width)] [block_count]
+};
+
 struct RobotRecording_Diagnostic {
    u8 name_length;
    u8 unit; //NOTE: North_Unit
    u32 sample_count;
    //char name[name_length]
-   //RobotRecording_DiagnosticSample [sample_count]
+   //RobotRecording_PackedColumn value, time
 };
 
+//NOTE: decoded sample, stored as columns in the file
 struct RobotRecording_DiagnosticSample {
    f32 value;
    f32 time;
@@ -148,7 +208,7 @@ struct RobotRecording_Path {
 struct RobotRecording_Group {
    u8 name_length;
    
-   u8 diagnostic_count;
+   u32 diagnostic_count;
    u32 message_count;
    u32 marker_count;
    u32 path_count;
@@ -161,64 +221,104 @@ struct RobotRecording_Group {
    //RobotRecording_Path [path_count]
 };
 
+//NOTE: decoded sample, stored as columns in the file
 struct RobotRecording_RobotStateSample {
    v2 pos;
    f32 angle;
    f32 time;
 };
 
-/*
+//NOTE: the file is split into chunks that each cover chunk_duration seconds, 
+//      each chunk is self contained so any time range can be read without touching the rest of the file
 struct RobotRecording_Chunk {
+   u32 size; //NOTE: size of everything after this header, lets the chunks be walked if the index is missing
+   f32 begin_time;
+   f32 end_time;
    u32 robot_state_sample_count;
-   u8 group_count;
+   u32 group_count;
 
-   //RobotRecording_RobotStateSample [robot_state_sample_count]
+   //RobotRecording_PackedColumn pos.x, pos.y, angle, time
    
    //RobotRecording_Group default_group
    //RobotRecording_Group [group_count]
-}
+};
 
-struct RobotRecording_GroupSummary {
-   u64 next_summary_offset;
+struct RobotRecording_ChunkIndexEntry {
+   u64 offset; //NOTE: from the start of the file to the RobotRecording_Chunk
+   f32 begin_time;
+   f32 end_time;
+};
 
-   u8 name_length;
-   
-   u8 diagnostic_count;
-   u32 message_count;
-   u32 marker_count;
-   u32 path_count;
+//NOTE: written after the last chunk when the recording ends
+struct RobotRecording_ChunkIndex {
+   u32 chunk_count;
+   //RobotRecording_ChunkIndexEntry [chunk_count]
+};
 
+//NOTE: one bucket of diagnostic samples, level n buckets each cover (base_bucket_size << n) samples
+//      so a time range can be drawn from roughly one bucket per pixel instead of every sample
+struct RobotRecording_DiagnosticSummary {
+   f32 begin_time;
+   f32 end_time;
+   f32 min;
+   f32 max;
+   f32 mean;
+   f32 first;
+   f32 last;
+};
+
+struct RobotRecording_SummaryLevel {
+   u32 bucket_count;
+   //RobotRecording_DiagnosticSummary [bucket_count]
+};
+
+//NOTE: every sample of one diagnostic over the whole recording, across all chunks
+struct RobotRecording_SummaryStream {
+   u8 group_name_length;
+   u8 name_length;
+   u8 unit; //NOTE: North_Unit
+   u32 sample_count;
+   u8 level_count;
+   //char group_name[group_name_length]
    //char name[name_length]
+   //RobotRecording_SummaryLevel [level_count], finest first
 };
-*/
 
-//TODO keep track of the totals somehow, like total diagnostic samples in a group
+//NOTE: written after the chunk index when the recording ends
+struct RobotRecording_SummaryIndex {
+   u32 base_bucket_size;
+   u32 stream_count;
+   //RobotRecording_SummaryStream [stream_count]
+};
 
 struct RobotRecording_FileHeader {
 #define ROBOT_RECORDING_MAGIC_NUMBER RIFF_CODE("NCRR") 
-#define ROBOT_RECORDING_CURR_VERSION 0
+#define ROBOT_RECORDING_CURR_VERSION 4
    u64 timestamp;
 
    u8 robot_name_length;
    f32 robot_width;
    f32 robot_length;
 
-   u32 robot_state_sample_count;
-   u8 group_count;
+   f32 chunk_duration;
+   u64 chunk_index_offset; //NOTE: 0 if the recording never got ended (eg. crashed), walk the chunks instead
+   u64 summary_offset; //NOTE: 0 if the recording never got ended, there are no summaries then
 
    //char [robot_name_length]
 
-   //RobotRecording_RobotStateSample [robot_state_sample_count]
-   
-   //RobotRecording_Group default_group
-   //RobotRecording_Group [group_count]
+   //RobotRecording_Chunk [...]
+   //RobotRecording_ChunkIndex
+   //RobotRecording_SummaryIndex
 };
 //-----------------------------------------------------------
 
 //AutonomousProgram------------------------------------------
+//NOTE: the "//count" lines come right after their struct, in order. version 0 wrote each count as a u8 
+//      (capping everything at 255, see north_network_definitions.h for that layout), version 1 as a varint 
+//      (LEB128, see WriteVarint) so most counts are still a byte. everything else is the same in both
 struct AutonomousProgram_ContinuousEvent {
    u8 command_name_length;
-   u8 datapoint_count;
+   //count datapoint_count
    //char [command_name_length]
    //North_PathDataPoint [datapoint_count]
 };
@@ -226,27 +326,44 @@ struct AutonomousProgram_ContinuousEvent {
 struct AutonomousProgram_DiscreteEvent {
    f32 distance;
    u8 command_name_length;
-   u8 parameter_count;
+   //count parameter_count
    //char [command_name_length]
    //f32 [parameter_count]
 };
 
+namespace AutonomousProgram_PathFlags {
+   enum type {
+      IS_REVERSE = (1 << 0),
+      QUANTIZED_CONTROL_POINTS = (1 << 1), //NOTE: version 1 only, version 0 wrote is_reverse as 0 or 1 here
+   };
+};
+
+//NOTE: control points as fixed point, 1/AUTONOMOUS_PROGRAM_QUANTIZE_SCALE ft steps so +-128ft, 
+//      a path only gets written like this if every one of its points fits
+#define AUTONOMOUS_PROGRAM_QUANTIZE_SCALE 256
+struct AutonomousProgram_QuantizedControlPoint {
+   s16 pos_x;
+   s16 pos_y;
+   s16 tangent_x;
+   s16 tangent_y;
+};
+
 struct AutonomousProgram_Path {
    //NOTE: begin & end points are (parent.pos, in_tangent) & (end_node.pos, out_tangent)
    v2 in_tangent;
    v2 out_tangent;
 
-   u8 is_reverse;
-
+   u8 flags; //NOTE: AutonomousProgram_PathFlags
    u8 conditional_length; //NOTE: if conditional_length is 0, there is no conditional
-   u8 control_point_count;
-
-   u8 velocity_datapoint_count;
-   u8 continuous_event_count;
-   u8 discrete_event_count;
+   
+   //count control_point_count
+   //count velocity_datapoint_count
+   //count continuous_event_count
+   //count discrete_event_count
 
    //char conditional_name [conditional_length]
    //North_HermiteControlPoint [control_point_count]
+   //   or AutonomousProgram_QuantizedControlPoint [control_point_count] if QUANTIZED_CONTROL_POINTS is set
 
    //North_PathDataPoint [velocity_datapoint_count]
    //AutonomousProgram_ContinuousEvent [continuous_event_count]
@@ -262,7 +379,7 @@ struct AutonomousProgram_CommandHeader {
 
 struct AutonomousProgram_CommandBody_Generic {
    u8 command_name_length;
-   u8 parameter_count;
+   //count parameter_count
    
    //char [command_name_length]
    //f32 [parameter_count]
@@ -276,9 +393,9 @@ struct AutonomousProgram_CommandBody_Pivot {
    f32 start_angle;
    f32 end_angle;
    u8 turns_clockwise;
-   u8 velocity_datapoint_count;
-   u8 continuous_event_count;
-   u8 discrete_event_count;
+   //count velocity_datapoint_count
+   //count continuous_event_count
+   //count discrete_event_count
 
    //North_PathDataPoint [velocity_datapoint_count]
    //AutonomousProgram_ContinuousEvent [continuous_event_count]
@@ -287,19 +404,96 @@ struct AutonomousProgram_CommandBody_Pivot {
 
 struct AutonomousProgram_Node {
    v2 pos;
-   u8 command_count;
-   u8 path_count;
+   //count command_count
+   //count path_count
    //AutonomousProgram_CommandHeader [command_count]
    //AutonomousProgram_Path [path_count]
 };
 
 struct AutonomousProgram_FileHeader {
 #define AUTONOMOUS_PROGRAM_MAGIC_NUMBER RIFF_CODE("NCAP") 
-#define AUTONOMOUS_PROGRAM_CURR_VERSION 0
+#define AUTONOMOUS_PROGRAM_CURR_VERSION 1
+#define AUTONOMOUS_PROGRAM_V0_VERSION 0
    //TODO: linked auto projects
    f32 starting_angle;
    //AutonomousProgram_Node begining_node
 };
 //-----------------------------------------------------------
 
+//Autonomous Program Index-----------------------------------
+//NOTE: one per directory, a summary of every .ncap in it so projects can be filtered without parsing them
+namespace AutonomousProgramIndex_CommandUse {
+   enum type {
+      Command = 0, //NOTE: generic command on a node
+      ContinuousEvent = 1,
+      DiscreteEvent = 2,
+   };
+};
+
+struct AutonomousProgramIndex_Command {
+   u8 use; //NOTE: AutonomousProgramIndex_CommandUse
+   u8 parameter_count; //NOTE: only matters for DiscreteEvent
+   u8 command_name_length;
+   //char [command_name_length]
+};
+
+struct AutonomousProgramIndex_Project {
+   u64 timestamp;
+   u32 file_size;
+
+   v2 starting_pos;
+   f32 starting_angle;
+   f32 path_length; //NOTE: every path in the project added together
+   f32 run_time; //NOTE: longest route through the project
+
+   u8 name_length;
+   u16 command_count;
+   u16 conditional_count;
+
+   //char name[name_length]
+   //AutonomousProgramIndex_Command [command_count]
+   //u8 length, char [length] [conditional_count]
+};
+
+struct AutonomousProgramIndex_FileHeader {
+#define AUTONOMOUS_PROGRAM_INDEX_MAGIC_NUMBER RIFF_CODE("NCAI") 
+#define AUTONOMOUS_PROGRAM_INDEX_CURR_VERSION 0
+   u32 project_count;
+   //AutonomousProgramIndex_Project [project_count]
+};
+//-----------------------------------------------------------
+
+//Autonomous Program Journal---------------------------------
+//NOTE: one next to each .ncap being edited, every edit gets appended as a record 
+//      & they get replayed on top of the .ncap when it's opened again (eg. after a crash)
+namespace AutonomousProgramJournal_RecordType {
+   enum type {
+      Node = 0, //NOTE: AutonomousProgram_Node & its commands, path_count is ignored
+      Path = 1, //NOTE: AutonomousProgram_Path & its data, without the end_node
+      AddPath = 2, //NOTE: AutonomousProgram_Path with its end_node, added after the node's other paths
+      RemovePath = 3, //NOTE: no body
+   };
+};
+
+struct AutonomousProgramJournal_Record {
+   u8 type; //NOTE: AutonomousProgramJournal_RecordType
+   u8 address_length;
+   u32 size; //NOTE: size of the body
+   //u8 address[address_length], the path index at each node starting from begining_node, 
+   //   Node & AddPath end at a node, Path & RemovePath end at a path 
+   //body
+};
+
+struct AutonomousProgramJournal_FileHeader {
+#define AUTONOMOUS_PROGRAM_JOURNAL_MAGIC_NUMBER RIFF_CODE("NCAJ") 
+#define AUTONOMOUS_PROGRAM_JOURNAL_CURR_VERSION 1
+   //NOTE: record bodies are laid out like the .ncap version with the same number
+   //NOTE: the .ncap the records go on top of, if it doesnt match the project 
+   //      got saved after the journal was written & the journal is out of date
+   u32 project_size;
+   u32 project_hash;
+   //AutonomousProgramJournal_Record [...] until the end of the file
+};
+//-----------------------------------------------------------
+
 #pragma pack(pop)
\ No newline at end of file
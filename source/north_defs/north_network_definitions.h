@@ -4,6 +4,7 @@
 
 struct PacketHeader {
    //NOTE: this lets packets be really big, our practical limit is much smaller than the 4 gb limit
+   //      (the editor drops the connection on anything that doesnt fit its 1 mb receive ring)
    //NOTE: this size excludes the 5 byte header
    u32 size;
    u8 type; 
@@ -19,6 +20,9 @@ namespace PacketType {
       ParameterOp = 5,           //  ->
       SetState = 6,              //  ->
       UploadAutonomous = 7,      //  ->
+      UploadAutonomous_V1 = 8,   //  ->
+      StateSchema = 9,           // <-
+      State_V2 = 10,             // <-
       //NOTE: if we change a packet just make a new type instead 
       //eg. "Welcome" becomes "Welcome_V1" & we create "Welcome_V2"
    };
@@ -28,6 +32,7 @@ namespace PacketType {
 namespace SetConnectionFlags_Flags {
    enum type {
       WANTS_STATE = (1 << 0),
+      WANTS_STATE_V2 = (1 << 1), //NOTE: with WANTS_STATE, get StateSchema & State_V2 instead of State
    };
 };
 
@@ -48,14 +53,11 @@ struct Welcome_Command {
    //{ u8 length; char [length]; } [param_count]
 };
 
-//NOTE: unused
-/*
 namespace Welcome_Flags {
    enum type {
-
+      ACCEPTS_UPLOAD_AUTONOMOUS_V1 = (1 << 0), //NOTE: otherwise autos go up as UploadAutonomous
    };
 };
-*/
 
 struct Welcome_PacketHeader {
    u8 robot_name_length;
@@ -152,6 +154,74 @@ struct State_PacketHeader {
 };
 //-----------------------------------------
 
+//-----------------------------------------
+//NOTE: StateSchema & State_V2 replace State, group names, diagnostic names & units
+//      only get sent once (in StateSchema) & State_V2 refers to them by id
+struct StateSchema_Diagnostic {
+   u8 name_length;
+   u8 unit; //NOTE: North_Unit
+   //char name[name_length]
+};
+
+struct StateSchema_Group {
+   u8 name_length;
+   u8 diagnostic_count;
+   //char name[name_length]
+   //StateSchema_Diagnostic [diagnostic_count]
+};
+
+//NOTE: sent before the first State_V2 & again whenever the robot adds a group or diagnostic, it replaces the whole schema
+//      group ids go in order starting with the default group at 0,
+//      diagnostic ids go in order across all the groups (default group first)
+struct StateSchema_PacketHeader {
+   u8 schema_id; //NOTE: different every time the schema gets resent
+   u8 group_count;
+
+   //NOTE: default_group.name_length should always be 0
+   //StateSchema_Group default_group
+
+   //StateSchema_Group [group_count]
+};
+
+namespace State_V2_Flags {
+   enum type {
+      F16_VALUES = (1 << 0), //NOTE: values are IEEE half floats instead of f32s
+      KEYFRAME = (1 << 1), //NOTE: every diagnostic that has a value is in this packet, not just the ones that changed
+   };
+};
+
+//NOTE: only groups with messages, markers or paths get one of these
+struct State_V2_Group {
+   u8 group_id;
+   u8 message_count;
+   u8 marker_count;
+   u8 path_count;
+   //State_Message [message_count]
+   //State_Marker [marker_count]
+   //State_Path [path_count]
+};
+
+//NOTE: only the diagnostics that changed since the last State_V2 are in here,
+//      the robot sends a KEYFRAME right after every StateSchema & every so often after that
+struct State_V2_PacketHeader {
+   v2 pos;
+   f32 angle;
+
+   u8 mode; //NOTE: North_GameMode
+   f32 time;
+
+   u8 schema_id; //NOTE: from the StateSchema these ids are for
+   u8 flags; //NOTE: State_V2_Flags
+
+   //varint changed_count
+   //varint id_gaps [changed_count] (ids go up, the first id is its gap & every other one is the last id + 1 + gap)
+   //f32 (or f16 with F16_VALUES) values [changed_count]
+
+   //varint group_count
+   //State_V2_Group [group_count]
+};
+//-----------------------------------------
+
 //--------------------------------------
 namespace ParameterOp_Type {
    enum type {
@@ -181,7 +251,7 @@ struct SetState_PacketHeader {
 
 //-------------------------------------
 #if 0
-//NOTE: From north_file_definitions.h -------------------------
+//NOTE: From north_file_definitions.h, version 0 (AUTONOMOUS_PROGRAM_V0_VERSION) -------------------------
 struct AutonomousProgram_ContinuousEvent {
    u8 command_name_length;
    u8 datapoint_count;
@@ -262,7 +332,13 @@ struct AutonomousProgram_Node {
 
 struct UploadAutonomous_PacketHeader {
    f32 starting_angle;
-   //AutonomousProgram_Node begining_node
+   //AutonomousProgram_Node begining_node (version 0, laid out like above)
+};
+
+//NOTE: only sent if the robot's Welcome has ACCEPTS_UPLOAD_AUTONOMOUS_V1
+struct UploadAutonomous_V1_PacketHeader {
+   f32 starting_angle;
+   //AutonomousProgram_Node begining_node (version 1, see north_file_definitions.h)
 };
 
 #pragma pack(pop)
\ No newline at end of file
@@ -14,13 +14,11 @@ struct DVTA_Data {
    f32 *a;
 };
 
-DVTA_Data GetDVTA(AutoVelocityDatapoints *data) {
-   Assert(data->datapoint_count >= 2);
-
-   f32 *d = PushTempArray(f32, data->datapoint_count);
-   f32 *v = PushTempArray(f32, data->datapoint_count);
-   f32 *t = PushTempArray(f32, data->datapoint_count);
-   f32 *a = PushTempArray(f32, data->datapoint_count - 1);
+void FillDVTA(DVTA_Data *dvta, AutoVelocityDatapoints *data) {
+   f32 *d = dvta->d;
+   f32 *v = dvta->v;
+   f32 *t = dvta->t;
+   f32 *a = dvta->a;
 
    for(u32 i = 0; i < data->datapoint_count; i++) {
       d[i] = data->datapoints[i].distance;
@@ -33,11 +31,56 @@ DVTA_Data GetDVTA(AutoVelocityDatapoints *data) {
       t[1 + i] = ((2 * (d[i + 1] - d[i])) / (v[i + 1] + v[i]))  + t[i];
       a[i] = (v[i+1]*v[i+1] - v[i]*v[i]) / (2 * (d[i + 1] - d[i]));
    }
-   
-   DVTA_Data result = {data->datapoint_count, d, v, t, a};
+
+   dvta->datapoint_count = data->datapoint_count;
+}
+
+DVTA_Data GetDVTA(AutoVelocityDatapoints *data, MemoryArena *arena = __temp_arena) {
+   Assert(data->datapoint_count >= 2);
+
+   DVTA_Data result = {};
+   result.d = PushArray(arena, f32, data->datapoint_count);
+   result.v = PushArray(arena, f32, data->datapoint_count);
+   result.t = PushArray(arena, f32, data->datapoint_count);
+   result.a = PushArray(arena, f32, data->datapoint_count - 1);
+   FillDVTA(&result, data);
    return result;
 }
 
+//NOTE: time from d[i] to distance, distance has to be in segment i
+inline f32 GetSegmentDeltaT(DVTA_Data dvta, u32 i, f32 distance) {
+   if(dvta.a[i] == 0) {
+      return (distance - dvta.d[i]) / dvta.v[i];
+   } else {
+      return (sqrtf(2*dvta.a[i]*(distance - dvta.d[i]) + dvta.v[i]*dvta.v[i]) - dvta.v[i]) / dvta.a[i];
+   }
+}
+
+//NOTE: returns the last segment i (in [0, datapoint_count - 2]) with keys[i] <= x, 
+//      keys is either dvta.d or dvta.t
+inline u32 DVTASearch(f32 *keys, u32 datapoint_count, f32 x) {
+   u32 base = 0;
+   u32 n = datapoint_count - 1;
+   while(n > 1) {
+      u32 half = n / 2;
+      base = (keys[base + half] <= x) ? (base + half) : base;
+      n -= half;
+   }
+   return base;
+}
+
+//NOTE: same as DVTASearch but starts from the last result, for sweeps where x mostly increases
+inline u32 DVTASearchFrom(f32 *keys, u32 datapoint_count, u32 last_i, f32 x) {
+   u32 last_segment = datapoint_count - 2;
+   if((last_i > last_segment) || (x < keys[last_i]))
+      return DVTASearch(keys, datapoint_count, x);
+
+   while((last_i < last_segment) && (keys[last_i + 1] <= x))
+      last_i++;
+   
+   return last_i;
+}
+
 f32 GetTotalTime(DVTA_Data dvta) {
    return dvta.t[dvta.datapoint_count - 1];
 }
@@ -49,67 +92,28 @@ f32 GetTotalLength(DVTA_Data dvta) {
 //NOTE: V(s)
 f32 GetVelocityAt(DVTA_Data dvta, f32 distance) {
    distance = Clamp(0, GetTotalLength(dvta), distance);
-   for(u32 i = 0; i < (dvta.datapoint_count - 1); i++) {
-      if((dvta.d[i] <= distance) && (distance <= dvta.d[i+1])) {
-         f32 delta_t;
-         if(dvta.a[i] == 0) {
-            delta_t = (distance - dvta.d[i]) / dvta.v[i];
-         } else {
-            delta_t = (sqrtf(2*dvta.a[i]*(distance - dvta.d[i]) + dvta.v[i]*dvta.v[i]) - dvta.v[i]) / dvta.a[i];
-         }
-
-         return dvta.v[i] + dvta.a[i]*delta_t;
-      }
-   }
-
-   Assert(false);
-   return 0;
+   u32 i = DVTASearch(dvta.d, dvta.datapoint_count, distance);
+   return dvta.v[i] + dvta.a[i]*GetSegmentDeltaT(dvta, i, distance);
 }
 
 f32 GetAccelerationAt(DVTA_Data dvta, f32 distance) {
    distance = Clamp(0, GetTotalLength(dvta), distance);
-   for(u32 i = 0; i < (dvta.datapoint_count - 1); i++) {
-      if((dvta.d[i] <= distance) && (distance <= dvta.d[i+1])) {
-         return dvta.a[i];
-      }
-   }
-
-   Assert(false);
-   return 0;
+   return dvta.a[DVTASearch(dvta.d, dvta.datapoint_count, distance)];
 }
 
 //NOTE: T(s)
 f32 GetArrivalTimeAt(DVTA_Data dvta, f32 distance) {
    distance = Clamp(0, GetTotalLength(dvta), distance);
-   for(u32 i = 0; i < (dvta.datapoint_count - 1); i++) {
-      if((dvta.d[i] <= distance) && (distance <= dvta.d[i+1])) {
-         f32 delta_t;
-         if(dvta.a[i] == 0) {
-            delta_t = (distance - dvta.d[i]) / dvta.v[i];
-         } else {
-            delta_t = (sqrtf(2*dvta.a[i]*(distance - dvta.d[i]) + dvta.v[i]*dvta.v[i]) - dvta.v[i]) / dvta.a[i];
-         }
-
-         return dvta.t[i] + delta_t;
-      }
-   }
-
-   Assert(false);
-   return 0;
+   u32 i = DVTASearch(dvta.d, dvta.datapoint_count, distance);
+   return dvta.t[i] + GetSegmentDeltaT(dvta, i, distance);
 }
 
 //NOTE: D(t)
 f32 GetDistanceAt(DVTA_Data dvta, f32 time) {
    time = Clamp(0, GetTotalTime(dvta), time);
-   for(u32 i = 0; i < (dvta.datapoint_count - 1); i++) {
-      if((dvta.t[i] <= time) && (time <= dvta.t[i+1])) {
-         f32 dt = time - dvta.t[i];
-         return dvta.d[i] + dvta.v[i]*dt + 0.5*dvta.a[i]*dt*dt;
-      }
-   }
-
-   Assert(false);
-   return 0;
+   u32 i = DVTASearch(dvta.t, dvta.datapoint_count, time);
+   f32 dt = time - dvta.t[i];
+   return dvta.d[i] + dvta.v[i]*dt + 0.5*dvta.a[i]*dt*dt;
 }
 //--------------------------------------------
 
@@ -127,8 +131,23 @@ struct AutoDiscreteEvent {
    f32 *params;
 };
 
+//NOTE: DVTA table kept alongside the velocity datapoints, 
+//      anything that edits the datapoints has to call InvalidateDVTA
+struct DVTA_Cache {
+   MemoryArena *arena; //NOTE: the arena the pathlike lives in, NULL means dont cache
+   MemoryArena *table_arena; //NOTE: pool arena the table is in, see GetDVTA & FreePathlikeData
+   u32 capacity;
+   bool valid;
+   DVTA_Data table;
+};
+
 struct AutoPathlikeData {
    AutoVelocityDatapoints velocity;
+   DVTA_Cache dvta;
+
+   //NOTE: pool arena GenerateVelocityProfile writes the datapoints into, reused until it's too small
+   MemoryArena *generated_arena;
+   u32 generated_capacity;
 
    u32 continuous_event_count;
    AutoContinuousEvent *continuous_events;
@@ -172,6 +191,11 @@ struct AutoNode {
    
    u32 path_count;
    AutoPath **out_paths;
+
+   //NOTE: pivots only depend on in_path->out_tangent & the node's own commands,
+   //      so the chain is only recalculated when one of those changes
+   bool pivots_dirty;
+   f32 pivots_start_angle;
 };
 
 struct AutoRobotPose {
@@ -205,6 +229,19 @@ v2 CubicHermiteSplineTangent(North_HermiteControlPoint a, North_HermiteControlPo
    return CubicHermiteSplineTangent(a.pos, a.tangent, b.pos, b.tangent, t);
 }
 
+//NOTE: samples_per_segment evenly spaced samples (including both ends) of every segment, 
+//      so positions & tangents need (point_count - 1) * samples_per_segment elements
+void CubicHermiteSplineBatch(North_HermiteControlPoint *points, u32 point_count, u32 samples_per_segment,
+                             v2 *positions, v2 *tangents = NULL) 
+{
+   for(u32 i = 0; i < (point_count - 1); i++) {
+      u32 offset = i * samples_per_segment;
+      CubicHermiteSplineBatch(points[i].pos, points[i].tangent, points[i + 1].pos, points[i + 1].tangent, 
+                              samples_per_segment, positions ? (positions + offset) : NULL, 
+                              tangents ? (tangents + offset) : NULL);
+   }
+}
+
 struct AutoPathData {
    AutoRobotPose pose;
    f32 dtheta_ds;
@@ -223,57 +260,302 @@ void path_data_lerp(InterpolatingMap_Leaf *leaf_a, InterpolatingMap_Leaf *leaf_b
    result->d2theta_ds2 = lerp(a->d2theta_ds2, t, b->d2theta_ds2);
 }
 
-f32 BuildPathMap(InterpolatingMap *len_to_data, North_HermiteControlPoint *points, u32 point_count) {
-   InterpolatingMapSamples samples = ResetMap(len_to_data);
-   f32 t_step = (f32)(point_count - 1) / (f32)(samples.count - 1);
-   
-   f32 length = 0;
-   v2 last_pos = points[0].pos;
-   for(u32 i = 0; i < samples.count; i++) {
-      f32 t_full = t_step * i;
-      u32 spline_i = Clamp(0, point_count - 2, (u32) t_full);
-      v2 pos = CubicHermiteSpline(points[spline_i], points[spline_i + 1], t_full - (f32)spline_i);
+//NOTE: same as MapLookupMany(map, ..., sizeof(AutoPathData)) with path_data_lerp inlined
+void MapLookupMany(InterpolatingMap *map, f32 *distances, u32 count, AutoPathData *results) {
+   u32 i = 0;
+   for(u32 j = 0; j < count; j++) {
+      i = MapSearchFrom(map, i, distances[j]);
+      f32 t = MapLerpT(map, i, distances[j]);
+      AutoPathData *a = (AutoPathData *) map->samples[i].data_ptr;
+      AutoPathData *b = (AutoPathData *) map->samples[i + 1].data_ptr;
+
+      results[j].pose = lerp(a->pose, t, b->pose);
+      results[j].dtheta_ds = lerp(a->dtheta_ds, t, b->dtheta_ds);
+      results[j].d2theta_ds2 = lerp(a->d2theta_ds2, t, b->d2theta_ds2);
+   }
+}
+
+//NOTE: dtheta_ds & d2theta_ds2 are calculated analytically from the spline derivatives
+//      instead of finite differencing the samples, so they dont depend on sample spacing
+AutoPathData GetAutoPathData(North_HermiteControlPoint a, North_HermiteControlPoint b, f32 t) {
+   v2 d1 = CubicHermiteSplineTangent(a, b, t);
+   v2 d2 = CubicHermiteSplineSecondDerivative(a.pos, a.tangent, b.pos, b.tangent, t);
+   v2 d3 = CubicHermiteSplineThirdDerivative(a.pos, a.tangent, b.pos, b.tangent);
+
+   AutoPathData result = {};
+   result.pose.pos = CubicHermiteSpline(a, b, t);
+   result.pose.angle = ToRadians(Angle(d1));
+
+   f32 speed = Length(d1);
+   if(speed > 0.00001) {
+      //NOTE: Angle is atan2(-y, x) so the cross products are flipped from the usual curvature formula
+      f32 c = d1.y * d2.x - d1.x * d2.y;
+      f32 dc_dt = d1.y * d3.x - d1.x * d3.y;
+      f32 speed3 = speed * speed * speed;
+
+      result.dtheta_ds = c / speed3;
+      f32 dk_dt = dc_dt / speed3 - 3 * c * Dot(d1, d2) / (speed3 * speed * speed);
+      result.d2theta_ds2 = dk_dt / speed;
+   }
+
+   return result;
+}
+
+//NOTE: tolerance is in the same units as the control points (usually ft)
+#define PATH_MAP_DEFAULT_TOLERANCE 0.005
+#define PATH_MAP_MAX_DEPTH 12
+#define PATH_MAP_MAX_SAMPLES 4096
+
+struct PathMapInfo {
+   f32 length;
+   f32 length_error; //NOTE: estimated error of length, summed over every sample
+   f32 pose_error; //NOTE: worst estimated distance between a lerped MapLookup & the actual spline
+   u32 sample_count;
+};
+
+struct PathMapBuilder {
+   f32 tolerance;
+   North_HermiteControlPoint a;
+   North_HermiteControlPoint b;
+   u32 spline_i;
+
+   u32 sample_count;
+   u32 max_sample_count;
+   u32 pending_count; //NOTE: intervals that still have to emit a sample
+   u32 *spline_indices;
+   f32 *ts;
+   f32 *lens;
+
+   PathMapInfo info;
+};
+
+void AddPathMapSample(PathMapBuilder *builder, f32 t, f32 length) {
+   Assert(builder->sample_count < builder->max_sample_count);
+   u32 i = builder->sample_count++;
+   builder->spline_indices[i] = builder->spline_i;
+   builder->ts[i] = t;
+   builder->lens[i] = length;
+}
+
+//NOTE: splits [t0, t1] until the quadrature has converged & lerping between the
+//      endpoints by distance stays within tolerance of the spline at the midpoint
+void SubdividePathMapSegment(PathMapBuilder *builder, f32 t0, f32 t1, f32 segment_length, u32 depth) {
+   North_HermiteControlPoint a = builder->a;
+   North_HermiteControlPoint b = builder->b;
+   f32 tm = (t0 + t1) / 2;
+   f32 left_length, right_length;
+   CubicHermiteSplineArcLengths(a.pos, a.tangent, b.pos, b.tangent, t0, tm, t1, &left_length, &right_length);
+   f32 split_length = left_length + right_length;
+
+   f32 ts[3] = { t0, tm, t1 };
+   v2 positions[3];
+   CubicHermiteSplineBatch(a.pos, a.tangent, b.pos, b.tangent, ts, 3, positions);
+
+   f32 length_error = abs(split_length - segment_length);
+   v2 lerped_mid = lerp(positions[0], (split_length > 0) ? (left_length / split_length) : 0.5f, positions[2]);
+   f32 pose_error = Length(positions[1] - lerped_mid);
+
+   bool can_split = (depth < PATH_MAP_MAX_DEPTH) && 
+                    ((builder->sample_count + builder->pending_count) < PATH_MAP_MAX_SAMPLES);
+   if(can_split && ((pose_error > builder->tolerance) || (length_error > builder->tolerance))) {
+      builder->pending_count++;
+      SubdividePathMapSegment(builder, t0, tm, left_length, depth + 1);
+      SubdividePathMapSegment(builder, tm, t1, right_length, depth + 1);
+   } else {
+      builder->pending_count--;
+      builder->info.length += split_length;
+      builder->info.length_error += length_error;
+      builder->info.pose_error = Max(builder->info.pose_error, pose_error);
+      AddPathMapSample(builder, t1, builder->info.length);
+   }
+}
+
+//PATH-BOUNDS-----------------------------------------------
+//NOTE: the map samples are already a polyline within tolerance of the spline, so the 
+//      closest point & hit testing queries just run on them, with a bounding box for 
+//      every PATH_BOUNDS_CHUNK_SIZE segments & one for the whole path to skip most of it
+#define PATH_BOUNDS_CHUNK_SIZE 16
+
+struct PathBoundsChunk {
+   rect2 bounds;
+   u32 first_sample; //NOTE: covers the segments from first_sample to first_sample + PATH_BOUNDS_CHUNK_SIZE
+};
+
+struct PathBounds {
+   rect2 bounds;
+   u32 chunk_count;
+   PathBoundsChunk *chunks;
+};
+
+u32 PathBoundsChunkCount(u32 sample_count) {
+   return (sample_count - 2) / PATH_BOUNDS_CHUNK_SIZE + 1;
+}
+
+inline v2 GetMapSamplePos(InterpolatingMap *map, u32 i) {
+   return ((AutoPathData *) map->samples[i].data_ptr)->pose.pos;
+}
 
-      AutoPathData *data = PushStruct(samples.arena, AutoPathData);
-      data->pose.pos = pos;
-      data->pose.angle = ToRadians(Angle(CubicHermiteSplineTangent(points[spline_i], points[spline_i + 1], t_full - (f32)spline_i)));
+//NOTE: map has to be a f32 -> AutoPathData map
+PathBounds BuildPathBounds(InterpolatingMap *map, MemoryArena *arena) {
+   PathBounds result = {};
+   result.chunk_count = PathBoundsChunkCount(map->sample_count);
+   result.chunks = PushArray(arena, PathBoundsChunk, result.chunk_count);
 
-      length += Length(pos - last_pos);
-      last_pos = pos;
+   u32 last_sample = map->sample_count - 1;
+   for(u32 i = 0; i < result.chunk_count; i++) {
+      PathBoundsChunk *chunk = result.chunks + i;
+      chunk->first_sample = i * PATH_BOUNDS_CHUNK_SIZE;
       
-      samples.data[i].len = length;
-      samples.data[i].data_ptr = data;
+      v2 first_pos = GetMapSamplePos(map, chunk->first_sample);
+      chunk->bounds = RectMinMax(first_pos, first_pos);
+      u32 end_sample = Min(chunk->first_sample + PATH_BOUNDS_CHUNK_SIZE, last_sample);
+      for(u32 j = chunk->first_sample + 1; j <= end_sample; j++) {
+         chunk->bounds = Union(chunk->bounds, GetMapSamplePos(map, j));
+      }
+
+      result.bounds = (i == 0) ? chunk->bounds : Union(result.bounds, chunk->bounds);
    }
 
-   f32 ds = length / (f32)(samples.count - 1);
-   for(u32 i = 0; i < samples.count; i++) {
-      AutoPathData *data = ((AutoPathData *) samples.data[i].data_ptr);
-      AutoRobotPose curr_pose = data->pose;
+   return result;
+}
 
-      f32 dtheta_ds = 0;
-      f32 d2theta_ds2 = 0;
+struct PathClosestPoint {
+   bool found;
+   f32 distance;
+   f32 s;
+   v2 pos;
+};
 
-      if(i == 0) {
-         AutoRobotPose next_pose = ((AutoPathData *) samples.data[i + 1].data_ptr)->pose;
-         dtheta_ds = ShortestAngleBetween_Radians(curr_pose.angle, next_pose.angle) / ds;
-      } else {
-         AutoRobotPose last_pose = ((AutoPathData *) samples.data[i - 1].data_ptr)->pose;
-         dtheta_ds = ShortestAngleBetween_Radians(last_pose.angle, curr_pose.angle) / ds;
+//NOTE: only finds points closer than max_distance
+PathClosestPoint GetClosestPoint(PathBounds *bounds, InterpolatingMap *map, v2 p, f32 max_distance = F32_MAX) {
+   PathClosestPoint result = {};
+   f32 best_dist_sq = max_distance * max_distance; //NOTE: F32_MAX just goes to infinity here
+   if(DistanceSquared(bounds->bounds, p) >= best_dist_sq)
+      return result;
+
+   u32 last_sample = map->sample_count - 1;
+   for(u32 i = 0; i < bounds->chunk_count; i++) {
+      PathBoundsChunk *chunk = bounds->chunks + i;
+      if(DistanceSquared(chunk->bounds, p) >= best_dist_sq)
+         continue;
+      
+      u32 end_sample = Min(chunk->first_sample + PATH_BOUNDS_CHUNK_SIZE, last_sample);
+      for(u32 j = chunk->first_sample; j < end_sample; j++) {
+         f32 t = 0;
+         v2 closest = ClosestPointOnSegment(GetMapSamplePos(map, j), GetMapSamplePos(map, j + 1), p, &t);
+         v2 offset = closest - p;
+         f32 dist_sq = Dot(offset, offset);
+
+         if(dist_sq < best_dist_sq) {
+            best_dist_sq = dist_sq;
+            result.found = true;
+            result.pos = closest;
+            result.s = map->lens[j] + t * (map->lens[j + 1] - map->lens[j]);
+         }
       }
+   }
+
+   if(result.found)
+      result.distance = sqrtf(best_dist_sq);
+   
+   return result;
+}
 
-      if((i != 0) && (i != samples.count - 1)) {
-         AutoRobotPose next_pose = ((AutoPathData *) samples.data[i + 1].data_ptr)->pose;
-         AutoRobotPose last_pose = ((AutoPathData *) samples.data[i - 1].data_ptr)->pose;
+bool PathIntersects(PathBounds *bounds, InterpolatingMap *map, rect2 r) {
+   if(!Intersects(bounds->bounds, r))
+      return false;
 
-         d2theta_ds2 = (ShortestAngleBetween_Radians(curr_pose.angle, next_pose.angle) / ds - ShortestAngleBetween_Radians(last_pose.angle, curr_pose.angle) / ds) / ds;
+   u32 last_sample = map->sample_count - 1;
+   for(u32 i = 0; i < bounds->chunk_count; i++) {
+      PathBoundsChunk *chunk = bounds->chunks + i;
+      if(!Intersects(chunk->bounds, r))
+         continue;
+
+      u32 end_sample = Min(chunk->first_sample + PATH_BOUNDS_CHUNK_SIZE, last_sample);
+      for(u32 j = chunk->first_sample; j < end_sample; j++) {
+         if(SegmentIntersects(GetMapSamplePos(map, j), GetMapSamplePos(map, j + 1), r))
+            return true;
       }
-      
-      data->dtheta_ds = dtheta_ds;
-      data->d2theta_ds2 = d2theta_ds2;
+   }
+
+   return false;
+}
+//PATH-BOUNDS-----------------------------------------------
+
+//NOTE: everything BuildPathMap & BuildPathBounds push into the map's arena
+u64 PathMapSize(u32 sample_count) {
+   return sample_count * (sizeof(InterpolatingMap_Leaf) + sizeof(AutoPathData) + sizeof(f32)) + 
+          PathBoundsChunkCount(sample_count) * sizeof(PathBoundsChunk);
+}
+
+//NOTE: projects get loaded on worker threads (see ReadProjectsStartingAt) 
+//      so path map arenas get alloc'd & freed under this
+Mutex path_map_pool_lock = {};
+
+//NOTE: swaps the map's arena for a pool arena that fits sample_count samples, 
+//      also gives back arenas that are way too big so memory follows the actual sample counts
+void ReservePathMap(InterpolatingMap *map, MemoryPool *pool, u32 sample_count) {
+   u64 size = PathMapSize(sample_count);
+   if(map->arena != NULL) {
+      u64 curr_size = PoolArenaSize(map->arena);
+      if((size <= curr_size) && (curr_size <= 4 * size))
+         return;
+   }
+
+   BeginMutex(&path_map_pool_lock);
+   if(map->arena != NULL)
+      PoolFreeArena(pool, map->arena);
+
+   map->arena = PoolAllocArena(pool, size);
+   EndMutex(&path_map_pool_lock);
+}
+
+//NOTE: if pool is NULL the map is built into its own arena
+PathMapInfo BuildPathMap(InterpolatingMap *len_to_data, North_HermiteControlPoint *points, u32 point_count,
+                         f32 tolerance = PATH_MAP_DEFAULT_TOLERANCE, MemoryPool *pool = NULL)
+{
+   Assert(point_count >= 2);
+   TempArena temp;
+
+   PathMapBuilder builder = {};
+   builder.tolerance = tolerance;
+   builder.pending_count = 2 * (point_count - 1);
+   //NOTE: every segment emits at least 2 samples even if that goes over PATH_MAP_MAX_SAMPLES
+   builder.max_sample_count = Max(PATH_MAP_MAX_SAMPLES, builder.pending_count + 1);
+   builder.spline_indices = PushArray(&temp.arena, u32, builder.max_sample_count);
+   builder.ts = PushArray(&temp.arena, f32, builder.max_sample_count);
+   builder.lens = PushArray(&temp.arena, f32, builder.max_sample_count);
+   AddPathMapSample(&builder, 0, 0);
+
+   for(u32 i = 0; i < (point_count - 1); i++) {
+      builder.spline_i = i;
+      builder.a = points[i];
+      builder.b = points[i + 1];
+
+      //NOTE: always split once so a segment with an S-bend cant look straight at its midpoint
+      f32 left_length, right_length;
+      CubicHermiteSplineArcLengths(builder.a.pos, builder.a.tangent, builder.b.pos, builder.b.tangent, 
+                                   0, 0.5, 1, &left_length, &right_length);
+      SubdividePathMapSegment(&builder, 0, 0.5, left_length, 1);
+      SubdividePathMapSegment(&builder, 0.5, 1, right_length, 1);
+   }
+
+   if(pool != NULL)
+      ReservePathMap(len_to_data, pool, builder.sample_count);
+   
+   InterpolatingMapSamples samples = ResetMap(len_to_data, builder.sample_count);
+   AutoPathData *data = PushArray(samples.arena, AutoPathData, samples.count);
+   for(u32 i = 0; i < samples.count; i++) {
+      u32 spline_i = builder.spline_indices[i];
+      data[i] = GetAutoPathData(points[spline_i], points[spline_i + 1], builder.ts[i]);
+
+      samples.data[i].len = builder.lens[i];
+      samples.data[i].data_ptr = data + i;
    }
 
    BuildMap(len_to_data);
-   return length;
+   builder.info.sample_count = builder.sample_count;
+   return builder.info;
 }
 
 struct AutoPath {   
@@ -294,27 +576,337 @@ struct AutoPath {
    North_HermiteControlPoint *control_points;
 
    InterpolatingMap len_to_data;
+   PathMapInfo map_info;
+   PathBounds bounds;
    f32 length;
+
+   //NOTE: regenerate the velocity profile every time the path changes, not saved
+   bool auto_velocity;
+   RobotMotionLimits velocity_limits;
 };
 
+//NOTE: every AutoPath's len_to_data & every pathlike's DVTA table lives in here, 
+//      FreeAutoPath/FreeAutoNode give the memory back when paths get deleted or a project gets unloaded
+MemoryPool *path_map_pool = NULL;
+
+MemoryPool *GetPathMapPool() {
+   if(path_map_pool == NULL)
+      path_map_pool = PushPool(PlatformAllocArena(Megabyte(1), "Path Maps"));
+   
+   return path_map_pool;
+}
+
 void InitAutoPath(AutoPath *path) {
-   //TODO: properly do this, BIG HACK
-   path->len_to_data.arena = PlatformAllocArena(Megabyte(2), "AutoPathHACK");
-   path->len_to_data.sample_exp = 7;
+   path->len_to_data.arena = NULL;
    path->len_to_data.lerp_callback = path_data_lerp;
 }
 
+//NOTE: bumped every time a path's bounds get rebuilt or a path gets freed, see UpdatePathIndex
+volatile u32 path_bounds_generation = 0;
+
+//NOTE: just the cached table, the datapoints (which can be in generated_arena) stay put
+void FreeDVTACache(DVTA_Cache *cache) {
+   if(cache->table_arena != NULL) {
+      BeginMutex(&path_map_pool_lock);
+      PoolFreeArena(GetPathMapPool(), cache->table_arena);
+      EndMutex(&path_map_pool_lock);
+      cache->table_arena = NULL;
+   }
+
+   cache->capacity = 0;
+   cache->valid = false;
+}
+
+//NOTE: only when the pathlike itself is going away, this frees the datapoints if they were generated
+void FreePathlikeData(AutoPathlikeData *data) {
+   FreeDVTACache(&data->dvta);
+
+   if(data->generated_arena != NULL) {
+      BeginMutex(&path_map_pool_lock);
+      PoolFreeArena(GetPathMapPool(), data->generated_arena);
+      EndMutex(&path_map_pool_lock);
+      data->generated_arena = NULL;
+   }
+   
+   data->generated_capacity = 0;
+}
+
+void FreeAutoNode(AutoNode *node);
+void FreeAutoPath(AutoPath *path) {
+   FreePathlikeData(&path->data);
+   if(path->len_to_data.arena != NULL) {
+      BeginMutex(&path_map_pool_lock);
+      PoolFreeArena(GetPathMapPool(), path->len_to_data.arena);
+      EndMutex(&path_map_pool_lock);
+      path->len_to_data.arena = NULL;
+      path->bounds = {};
+      AtomicIncrement(&path_bounds_generation);
+   }
+
+   if(path->out_node != NULL)
+      FreeAutoNode(path->out_node);
+}
+
+//NOTE: frees the path maps & DVTA tables of everything after node, the node & paths themselves are in the project arena
+void FreeAutoNode(AutoNode *node) {
+   for(u32 i = 0; i < node->command_count; i++) {
+      if(node->commands[i]->type == North_CommandType::Pivot)
+         FreePathlikeData(&node->commands[i]->pivot.data);
+   }
+
+   for(u32 i = 0; i < node->path_count; i++) {
+      FreeAutoPath(node->out_paths[i]);
+   }
+}
+
+//NOTE: bounding box hierarchy over every path in a project, leaves point at the paths & each path's 
+//      PathBounds does the rest of the query. It only depends on the path bounds so it's rebuilt 
+//      when they change (path_bounds_generation), not every frame
+#define PATH_INDEX_LEAF_SIZE 4
+
+struct PathIndexNode {
+   rect2 bounds;
+   u32 first; //NOTE: leaves: first path in PathIndex::paths, inner nodes: first child (the second is right after it)
+   u32 count; //NOTE: 0 for inner nodes
+};
+
+struct PathIndex {
+   MemoryArena *arena;
+   AutoNode *starting_node;
+   u32 generation;
+   bool valid;
+
+   u32 path_count;
+   AutoPath **paths;
+   u32 node_count;
+   PathIndexNode *nodes;
+};
+
+u32 CountAutoPaths(AutoNode *node) {
+   u32 result = node->path_count;
+   for(u32 i = 0; i < node->path_count; i++) {
+      result += CountAutoPaths(node->out_paths[i]->out_node);
+   }
+   return result;
+}
+
+//NOTE: paths that dont have bounds yet are left out, they get picked up by the rebuild after RecalculateAutoPathLength
+void AddToPathIndex(PathIndex *index, AutoNode *node) {
+   for(u32 i = 0; i < node->path_count; i++) {
+      AutoPath *path = node->out_paths[i];
+      if(path->bounds.chunk_count > 0)
+         index->paths[index->path_count++] = path;
+      AddToPathIndex(index, path->out_node);
+   }
+}
+
+inline v2 PathIndexCenter(AutoPath *path) {
+   return 0.5 * (path->bounds.bounds.min + path->bounds.bounds.max);
+}
+
+inline f32 PathIndexKey(AutoPath *path, bool split_x) {
+   v2 center = PathIndexCenter(path);
+   return split_x ? center.x : center.y;
+}
+
+//NOTE: quickselect, afterwards paths[k] is the path that would be there if they were sorted along the axis 
+//      & everything before it is <= it, so the tree is always balanced & depth stays log2(path_count)
+void SelectPathIndexSplit(AutoPath **paths, s32 count, s32 k, bool split_x) {
+   s32 lo = 0;
+   s32 hi = count - 1;
+   while(lo < hi) {
+      f32 pivot = PathIndexKey(paths[(lo + hi) / 2], split_x);
+      s32 i = lo;
+      s32 j = hi;
+      while(i <= j) {
+         while(PathIndexKey(paths[i], split_x) < pivot) i++;
+         while(PathIndexKey(paths[j], split_x) > pivot) j--;
+         if(i <= j) {
+            AutoPath *temp = paths[i];
+            paths[i] = paths[j];
+            paths[j] = temp;
+            i++;
+            j--;
+         }
+      }
+
+      if(k <= j) {
+         hi = j;
+      } else if(k >= i) {
+         lo = i;
+      } else {
+         break;
+      }
+   }
+}
+
+//NOTE: splits the paths in half along the longest axis of their centers
+void BuildPathIndexNode(PathIndex *index, u32 node_i, u32 first, u32 count) {
+   PathIndexNode *node = index->nodes + node_i;
+   node->bounds = index->paths[first]->bounds.bounds;
+   rect2 centers = RectMinMax(PathIndexCenter(index->paths[first]), PathIndexCenter(index->paths[first]));
+   for(u32 i = first + 1; i < (first + count); i++) {
+      node->bounds = Union(node->bounds, index->paths[i]->bounds.bounds);
+      centers = Union(centers, PathIndexCenter(index->paths[i]));
+   }
+
+   if(count <= PATH_INDEX_LEAF_SIZE) {
+      node->first = first;
+      node->count = count;
+      return;
+   }
+
+   bool split_x = (centers.max.x - centers.min.x) >= (centers.max.y - centers.min.y);
+   u32 left_count = count / 2;
+   SelectPathIndexSplit(index->paths + first, count, left_count, split_x);
+
+   u32 child_i = index->node_count;
+   index->node_count += 2;
+   node->first = child_i;
+   node->count = 0;
+   
+   BuildPathIndexNode(index, child_i, first, left_count);
+   BuildPathIndexNode(index, child_i + 1, first + left_count, count - left_count);
+}
+
+//NOTE: call this before querying, only does work if a path was recalculated or freed since the last build
+void UpdatePathIndex(PathIndex *index, AutoNode *starting_node) {
+   u32 generation = path_bounds_generation;
+   if(index->valid && (index->starting_node == starting_node) && (index->generation == generation))
+      return;
+   
+   if(index->arena == NULL)
+      index->arena = PlatformAllocArena(Kilobyte(64), "Path Index");
+   
+   Reset(index->arena);
+   index->starting_node = starting_node;
+   index->generation = generation;
+   index->valid = true;
+
+   u32 max_path_count = CountAutoPaths(starting_node);
+   index->path_count = 0;
+   index->paths = PushArray(index->arena, AutoPath *, max_path_count);
+   AddToPathIndex(index, starting_node);
+
+   //NOTE: a binary tree with path_count leaves has at most 2 * path_count - 1 nodes
+   index->node_count = 0;
+   index->nodes = PushArray(index->arena, PathIndexNode, Max(1, 2 * index->path_count));
+   if(index->path_count > 0) {
+      index->node_count = 1;
+      BuildPathIndexNode(index, 0, 0, index->path_count);
+   }
+}
+
+struct PathIndexHit {
+   AutoPath *path; //NOTE: NULL if nothing was within max_distance
+   f32 distance;
+   f32 s;
+   v2 pos;
+};
+
+//NOTE: hidden paths are skipped
+PathIndexHit GetClosestPath(PathIndex *index, v2 p, f32 max_distance = F32_MAX) {
+   PathIndexHit result = {};
+   f32 best_distance = max_distance;
+   if(index->node_count == 0)
+      return result;
+
+   u32 stack[64];
+   u32 stack_count = 0;
+   stack[stack_count++] = 0;
+
+   while(stack_count > 0) {
+      PathIndexNode *node = index->nodes + stack[--stack_count];
+      if(DistanceSquared(node->bounds, p) >= (best_distance * best_distance))
+         continue;
+
+      if(node->count == 0) {
+         //NOTE: push the further child first so the closer one is searched first & tightens best_distance
+         u32 near_i = node->first;
+         u32 far_i = node->first + 1;
+         if(DistanceSquared(index->nodes[far_i].bounds, p) < DistanceSquared(index->nodes[near_i].bounds, p)) {
+            near_i = node->first + 1;
+            far_i = node->first;
+         }
+
+         Assert((stack_count + 2) <= ArraySize(stack));
+         stack[stack_count++] = far_i;
+         stack[stack_count++] = near_i;
+         continue;
+      }
+
+      for(u32 i = node->first; i < (node->first + node->count); i++) {
+         AutoPath *path = index->paths[i];
+         if(path->hidden)
+            continue;
+
+         PathClosestPoint closest = GetClosestPoint(&path->bounds, &path->len_to_data, p, best_distance);
+         if(closest.found) {
+            best_distance = closest.distance;
+            result.path = path;
+            result.distance = closest.distance;
+            result.s = closest.s;
+            result.pos = closest.pos;
+         }
+      }
+   }
+
+   return result;
+}
+
+//NOTE: results needs space for index->path_count paths, returns how many were written
+u32 GetPathsIntersecting(PathIndex *index, rect2 r, AutoPath **results) {
+   u32 result_count = 0;
+   if(index->node_count == 0)
+      return result_count;
+
+   u32 stack[64];
+   u32 stack_count = 0;
+   stack[stack_count++] = 0;
+
+   while(stack_count > 0) {
+      PathIndexNode *node = index->nodes + stack[--stack_count];
+      if(!Intersects(node->bounds, r))
+         continue;
+
+      if(node->count == 0) {
+         Assert((stack_count + 2) <= ArraySize(stack));
+         stack[stack_count++] = node->first;
+         stack[stack_count++] = node->first + 1;
+         continue;
+      }
+
+      for(u32 i = node->first; i < (node->first + node->count); i++) {
+         AutoPath *path = index->paths[i];
+         if(!path->hidden && PathIntersects(&path->bounds, &path->len_to_data, r))
+            results[result_count++] = path;
+      }
+   }
+
+   return result_count;
+}
+
 struct AutoProjectLink {
    AutoNode *starting_node;
    f32 starting_angle;
    string name;
 
+   //NOTE: see ParseAutoProjectView
+   bool is_view;
+   MappedFile view_file;
+
    AutoProjectLink *next;
 };
 
+#define PROJECT_LOADER_MAX_WORKERS 8
+
 struct AutoProjectList {
    MemoryArena *arena;
-   AutoProjectLink *first;
+   AutoProjectLink *first; //NOTE: these are read only views, CopyAutoProject one before editing it
+
+   //NOTE: ReadProjectsStartingAt's worker threads parse into these, they're allocated the first time they get used
+   MemoryArena *worker_arenas[PROJECT_LOADER_MAX_WORKERS - 1];
+   MemoryArena *worker_temp_arenas[PROJECT_LOADER_MAX_WORKERS - 1];
 };
 
 struct AutoPathSpline {
@@ -333,9 +925,53 @@ AutoPathSpline GetAutoPathSpline(AutoPath *path, MemoryArena *arena = __temp_are
    return result;
 }
 
+//NOTE: arena is where the cached table gets allocated, should be the arena the pathlike lives in
+void InitPathlikeData(AutoPathlikeData *data, MemoryArena *arena) {
+   data->dvta = {};
+   data->dvta.arena = arena;
+   data->generated_arena = NULL;
+   data->generated_capacity = 0;
+}
+
+void InvalidateDVTA(AutoPathlikeData *data) {
+   data->dvta.valid = false;
+}
+
+DVTA_Data GetDVTA(AutoPathlikeData *data, MemoryArena *uncached_arena = __temp_arena) {
+   DVTA_Cache *cache = &data->dvta;
+   if(cache->valid)
+      return cache->table;
+   
+   //NOTE: pathlikes that were never given an arena just dont get cached
+   if(cache->arena == NULL)
+      return GetDVTA(&data->velocity, uncached_arena);
+
+   u32 count = data->velocity.datapoint_count;
+   Assert(count >= 2);
+   if(cache->capacity < count) {
+      //NOTE: grow with some slack so adding datapoints in the editor doesnt reallocate every time,
+      //      the old table goes back to the pool instead of piling up in the project arena
+      FreeDVTACache(cache);
+      u32 capacity = Max(8, 2 * count);
+      
+      BeginMutex(&path_map_pool_lock);
+      cache->table_arena = PoolAllocArena(GetPathMapPool(), 4 * capacity * sizeof(f32));
+      EndMutex(&path_map_pool_lock);
+      
+      cache->capacity = capacity;
+      cache->table.d = PushArray(cache->table_arena, f32, capacity);
+      cache->table.v = PushArray(cache->table_arena, f32, capacity);
+      cache->table.t = PushArray(cache->table_arena, f32, capacity);
+      cache->table.a = PushArray(cache->table_arena, f32, capacity);
+   }
+
+   FillDVTA(&cache->table, &data->velocity);
+   cache->valid = true;
+   return cache->table;
+}
+
 f32 GetVelocityAt(AutoPathlikeData *data, f32 distance) {
-   DVTA_Data dvta = GetDVTA(&data->velocity);
-   return GetVelocityAt(dvta, distance);
+   return GetVelocityAt(GetDVTA(data), distance);
 }
 
 f32 GetVelocityAt(AutoPath *path, f32 distance) {
@@ -344,11 +980,16 @@ f32 GetVelocityAt(AutoPath *path, f32 distance) {
 
 void RecalculateAutoPathLength(AutoPath *path) {
    AutoPathSpline spline = GetAutoPathSpline(path);
-   path->length = BuildPathMap(&path->len_to_data, spline.points, spline.point_count);
+   path->map_info = BuildPathMap(&path->len_to_data, spline.points, spline.point_count, 
+                                 PATH_MAP_DEFAULT_TOLERANCE, GetPathMapPool());
+   path->bounds = BuildPathBounds(&path->len_to_data, path->len_to_data.arena);
+   path->length = path->map_info.length;
+   AtomicIncrement(&path_bounds_generation);
 }
 
 void RecalculatePathlikeData(AutoPathlikeData *pathlike, f32 length) {
    Assert(pathlike->velocity.datapoint_count >= 2);
+   InvalidateDVTA(pathlike);
    pathlike->velocity.datapoints[0].distance = 0;
    pathlike->velocity.datapoints[0].value = 0;
    pathlike->velocity.datapoints[pathlike->velocity.datapoint_count - 1].distance = length;
@@ -370,39 +1011,220 @@ void RecalculatePathlikeData(AutoPathlikeData *pathlike, f32 length) {
    });
 }
 
-void RecalculateAutoPath(AutoPath *path) {
-   RecalculateAutoPathLength(path);
-   RecalculatePathlikeData(&path->data, path->length);
-}
-
-AutoRobotPose GetAutoPathPose(AutoPath *path, f32 distance) {
-   AutoPathData data = {};
-   MapLookup(&path->len_to_data, distance, &data);
-   return data.pose;
-}
-
-v2 GetAutoPathPoint(AutoPath *path, f32 distance) {
-   return GetAutoPathPose(path, distance).pos;
-}
+#define VELOCITY_PROFILE_TOLERANCE 0.05
 
-void RecalculateAutoNode(AutoNode *node) {
-   if(node->in_path != NULL) {
-      f32 start_angle = Angle(node->in_path->out_tangent);
-      for(u32 i = 0; i < node->command_count; i++) {
-         AutoCommand *command = node->commands[i];
-         if(command->type == North_CommandType::Pivot) {
-            command->pivot.start_angle = start_angle;
-            f32 pivot_length = abs(AngleBetween(command->pivot.start_angle, command->pivot.end_angle, command->pivot.turns_clockwise));
+//NOTE: minimum time profile at the map samples, the forward pass limits acceleration & the backward 
+//      pass deceleration, both make v^2 linear in s between samples which is exactly what DVTA 
+//      interpolates. Then samples are dropped as long as the lerped profile stays within 
+//      VELOCITY_PROFILE_TOLERANCE under (and never over) the optimal one.
+//      Everything is one pass over the samples, ~25us for a 1000 sample path
+void GenerateVelocityProfile(AutoPathlikeData *data, InterpolatingMap *len_to_data, RobotMotionLimits limits) {
+   TempArena temp;
 
-            RecalculatePathlikeData(&command->pivot.data, pivot_length);
-            
-            start_angle = command->pivot.end_angle;
-         }
-      }
+   u32 n = len_to_data->sample_count;
+   f32 *s = len_to_data->lens;
+   f32 *v_sq = PushArray(&temp.arena, f32, n);
+   
+   f32 max_v_sq = limits.max_velocity * limits.max_velocity;
+   for(u32 i = 0; i < n; i++) {
+      f32 curvature = abs(((AutoPathData *) len_to_data->samples[i].data_ptr)->dtheta_ds);
+      v_sq[i] = (curvature > 0) ? Min(max_v_sq, limits.max_centripetal_acceleration / curvature) : max_v_sq;
    }
 
-   for(u32 i = 0; i < node->path_count; i++) {
-      RecalculateAutoNode(node->out_paths[i]->out_node);
+   v_sq[0] = 0;
+   v_sq[n - 1] = 0;
+   for(u32 i = 1; i < n; i++) {
+      v_sq[i] = Min(v_sq[i], v_sq[i - 1] + 2 * limits.max_acceleration * (s[i] - s[i - 1]));
+   }
+   for(u32 i = n - 1; i > 0; i--) {
+      v_sq[i - 1] = Min(v_sq[i - 1], v_sq[i] + 2 * limits.max_acceleration * (s[i] - s[i - 1]));
+   }
+
+   u32 *kept = PushArray(&temp.arena, u32, n);
+   u32 kept_count = 0;
+   kept[kept_count++] = 0;
+   
+   //NOTE: a line from the anchor fits sample k if its v^2 slope is in [min_slope, max_slope] for k, 
+   //      so the slopes that fit every sample so far are just the intersection of those ranges
+   u32 anchor = 0;
+   while(anchor < (n - 1)) {
+      u32 end = anchor + 1;
+      f32 min_slope = -F32_MAX;
+      f32 max_slope = F32_MAX;
+      
+      for(u32 candidate = anchor + 1; candidate < n; candidate++) {
+         f32 ds = s[candidate] - s[anchor];
+         if(ds <= 0)
+            break;
+         
+         f32 slope = (v_sq[candidate] - v_sq[anchor]) / ds;
+         if((slope < min_slope) || (slope > max_slope))
+            break;
+         
+         end = candidate;
+
+         f32 v = sqrtf(v_sq[candidate]);
+         f32 v_lo = Max(0, v - VELOCITY_PROFILE_TOLERANCE);
+         f32 v_hi = v + 0.0001;
+         min_slope = Max(min_slope, (v_lo * v_lo - v_sq[anchor]) / ds);
+         max_slope = Min(max_slope, (v_hi * v_hi - v_sq[anchor]) / ds);
+      }
+      
+      kept[kept_count++] = end;
+      anchor = end;
+   }
+
+   //NOTE: a profile that's 0 everywhere has no arrival time, so keep the fastest sample
+   if((kept_count == 2) && (n > 2)) {
+      u32 fastest = 1;
+      for(u32 i = 1; i < (n - 1); i++) {
+         if(v_sq[i] > v_sq[fastest])
+            fastest = i;
+      }
+
+      kept[2] = kept[1];
+      kept[1] = fastest;
+      kept_count = 3;
+   }
+
+   if(data->generated_capacity < kept_count) {
+      //NOTE: slack so small edits to the path dont need a new arena every time
+      u32 capacity = 2 * kept_count;
+      BeginMutex(&path_map_pool_lock);
+      if(data->generated_arena != NULL)
+         PoolFreeArena(GetPathMapPool(), data->generated_arena);
+      data->generated_arena = PoolAllocArena(GetPathMapPool(), capacity * sizeof(North_PathDataPoint));
+      EndMutex(&path_map_pool_lock);
+      data->generated_capacity = capacity;
+   }
+   
+   Reset(data->generated_arena);
+   data->velocity.datapoints = PushArray(data->generated_arena, North_PathDataPoint, kept_count);
+   data->velocity.datapoint_count = kept_count;
+   for(u32 i = 0; i < kept_count; i++) {
+      data->velocity.datapoints[i].distance = s[kept[i]];
+      data->velocity.datapoints[i].value = sqrtf(v_sq[kept[i]]);
+   }
+
+   InvalidateDVTA(data);
+}
+
+//NOTE: for when only the velocity changed (eg. new limits), the map doesnt need to be rebuilt
+void RecalculateAutoPathVelocity(AutoPath *path) {
+   if(path->auto_velocity)
+      GenerateVelocityProfile(&path->data, &path->len_to_data, path->velocity_limits);
+   
+   RecalculatePathlikeData(&path->data, path->length);
+}
+
+void RecalculateAutoPath(AutoPath *path) {
+   RecalculateAutoPathLength(path);
+   RecalculateAutoPathVelocity(path);
+}
+
+//NOTE: SoA so callers can stream straight through whichever channels they need
+struct AutoPathSamples {
+   u32 count;
+   f32 *distance;
+   f32 *x;
+   f32 *y;
+   f32 *angle; //NOTE: in radians
+   f32 *velocity;
+   f32 *time;
+};
+
+//NOTE: count evenly spaced samples from start_distance to end_distance (inclusive), 
+//      the map & velocity segments are walked with cursors instead of searched per sample
+AutoPathSamples SampleAutoPath(AutoPath *path, f32 start_distance, f32 end_distance, u32 count,
+                               MemoryArena *arena = __temp_arena)
+{
+   Assert(count >= 2);
+   AutoPathSamples result = {};
+   result.count = count;
+   result.distance = PushArray(arena, f32, count);
+   result.x = PushArray(arena, f32, count);
+   result.y = PushArray(arena, f32, count);
+   result.angle = PushArray(arena, f32, count);
+   result.velocity = PushArray(arena, f32, count);
+   result.time = PushArray(arena, f32, count);
+
+   f32 step = (end_distance - start_distance) / (f32)(count - 1);
+   for(u32 i = 0; i < count; i++) {
+      result.distance[i] = start_distance + step * i;
+   }
+
+   InterpolatingMap *map = &path->len_to_data;
+   u32 map_i = 0;
+   for(u32 i = 0; i < count; i++) {
+      f32 distance = result.distance[i];
+      map_i = MapSearchFrom(map, map_i, distance);
+      f32 t = MapLerpT(map, map_i, distance);
+      AutoRobotPose pose = lerp(((AutoPathData *) map->samples[map_i].data_ptr)->pose, t, 
+                                ((AutoPathData *) map->samples[map_i + 1].data_ptr)->pose);
+      
+      result.x[i] = pose.pos.x;
+      result.y[i] = pose.pos.y;
+      result.angle[i] = pose.angle;
+   }
+
+   DVTA_Data dvta = GetDVTA(&path->data, arena);
+   u32 segment_i = 0;
+   for(u32 i = 0; i < count; i++) {
+      f32 distance = Clamp(0, GetTotalLength(dvta), result.distance[i]);
+      segment_i = DVTASearchFrom(dvta.d, dvta.datapoint_count, segment_i, distance);
+
+      f32 delta_t = GetSegmentDeltaT(dvta, segment_i, distance);
+      result.velocity[i] = dvta.v[segment_i] + dvta.a[segment_i]*delta_t;
+      result.time[i] = dvta.t[segment_i] + delta_t;
+   }
+
+   return result;
+}
+
+AutoRobotPose GetAutoPathPose(AutoPath *path, f32 distance) {
+   AutoPathData data = {};
+   MapLookup(&path->len_to_data, distance, &data);
+   return data.pose;
+}
+
+v2 GetAutoPathPoint(AutoPath *path, f32 distance) {
+   return GetAutoPathPose(path, distance).pos;
+}
+
+//NOTE: call this after editing a node's commands (adding, removing, reordering or changing a pivot)
+void MarkPivotsDirty(AutoNode *node) {
+   node->pivots_dirty = true;
+}
+
+void RecalculateAutoNodePivots(AutoNode *node) {
+   f32 start_angle = node->pivots_start_angle;
+   for(u32 i = 0; i < node->command_count; i++) {
+      AutoCommand *command = node->commands[i];
+      if(command->type == North_CommandType::Pivot) {
+         command->pivot.start_angle = start_angle;
+         f32 pivot_length = abs(AngleBetween(command->pivot.start_angle, command->pivot.end_angle, command->pivot.turns_clockwise));
+
+         RecalculatePathlikeData(&command->pivot.data, pivot_length);
+         
+         start_angle = command->pivot.end_angle;
+      }
+   }
+}
+
+//NOTE: paths are rebuilt where they're edited (RecalculateAutoPath), 
+//      this just walks the tree & updates the pivot chains that are out of date
+void RecalculateAutoNode(AutoNode *node) {
+   if(node->in_path != NULL) {
+      f32 start_angle = Angle(node->in_path->out_tangent);
+      if(node->pivots_dirty || (start_angle != node->pivots_start_angle)) {
+         node->pivots_start_angle = start_angle;
+         RecalculateAutoNodePivots(node);
+      }
+   }
+
+   node->pivots_dirty = false;
+   for(u32 i = 0; i < node->path_count; i++) {
+      RecalculateAutoNode(node->out_paths[i]->out_node);
    }
 }
 
@@ -465,30 +1287,64 @@ bool IsProjectCompatible(AutoProjectLink *proj, RobotProfile *bot) {
 }
 
 //FILE-READING----------------------------------------------
-AutoContinuousEvent ParseAutoContinuousEvent(buffer *file, MemoryArena *arena) {
+//NOTE: a u8 in version 0, a varint after that
+u32 ConsumeAutoCount(buffer *file, u32 version) {
+   if(version == AUTONOMOUS_PROGRAM_V0_VERSION)
+      return *ConsumeStruct(file, u8);
+   return ConsumeVarint(file);
+}
+
+AutoContinuousEvent ParseAutoContinuousEvent(buffer *file, u32 version) {
    AutoContinuousEvent result = {};
    AutonomousProgram_ContinuousEvent *file_event = ConsumeStruct(file, AutonomousProgram_ContinuousEvent);
+   u32 datapoint_count = ConsumeAutoCount(file, version);
    
-   result.command_name = PushCopy(arena, ConsumeString(file, file_event->command_name_length));
-   result.sample_count = file_event->datapoint_count;
-   result.samples = ConsumeAndCopyArray(arena, file, North_PathDataPoint, file_event->datapoint_count);
+   result.command_name = ConsumeString(file, file_event->command_name_length);
+   result.sample_count = datapoint_count;
+   result.samples = ConsumeArray(file, North_PathDataPoint, datapoint_count);
    
    return result;
 }
 
-AutoDiscreteEvent ParseAutoDiscreteEvent(buffer *file, MemoryArena *arena) {
+AutoDiscreteEvent ParseAutoDiscreteEvent(buffer *file, u32 version) {
    AutoDiscreteEvent result = {};
    AutonomousProgram_DiscreteEvent *file_event = ConsumeStruct(file, AutonomousProgram_DiscreteEvent);
+   u32 parameter_count = ConsumeAutoCount(file, version);
             
-   result.command_name = PushCopy(arena, ConsumeString(file, file_event->command_name_length));
-   result.param_count = file_event->parameter_count;
-   result.params = ConsumeAndCopyArray(arena, file, f32, file_event->parameter_count);
+   result.command_name = ConsumeString(file, file_event->command_name_length);
+   result.param_count = parameter_count;
+   result.params = ConsumeArray(file, f32, parameter_count);
    result.distance = file_event->distance;
 
    return result;
 }
 
-AutoCommand *ParseAutoCommand(buffer *file, MemoryArena *arena) {
+//NOTE: counts is velocity, continuous events & discrete events, they come before the rest of the path or pivot
+void ParseAutoPathlikeCounts(buffer *file, u32 version, u32 *counts) {
+   for(u32 i = 0; i < 3; i++)
+      counts[i] = ConsumeAutoCount(file, version);
+}
+
+void ParseAutoPathlikeData(buffer *file, AutoPathlikeData *data, u32 *counts, MemoryArena *arena, u32 version) {
+   InitPathlikeData(data, arena);
+   data->velocity.datapoint_count = counts[0];
+   Assert(data->velocity.datapoint_count >= 2);
+   data->velocity.datapoints = ConsumeArray(file, North_PathDataPoint, counts[0]);
+
+   data->continuous_event_count = counts[1];
+   data->continuous_events = PushArray(arena, AutoContinuousEvent, counts[1]);
+   for(u32 i = 0; i < counts[1]; i++) {
+      data->continuous_events[i] = ParseAutoContinuousEvent(file, version);
+   }
+
+   data->discrete_event_count = counts[2];
+   data->discrete_events = PushArray(arena, AutoDiscreteEvent, counts[2]);
+   for(u32 i = 0; i < counts[2]; i++) {
+      data->discrete_events[i] = ParseAutoDiscreteEvent(file, version);
+   }
+}
+
+AutoCommand *ParseAutoCommand(buffer *file, MemoryArena *arena, u32 version) {
    AutoCommand *result = PushStruct(arena, AutoCommand);
    
    AutonomousProgram_CommandHeader *header = ConsumeStruct(file, AutonomousProgram_CommandHeader);
@@ -497,9 +1353,10 @@ AutoCommand *ParseAutoCommand(buffer *file, MemoryArena *arena) {
    switch(result->type) {
       case North_CommandType::Generic: {
          AutonomousProgram_CommandBody_Generic *body = ConsumeStruct(file, AutonomousProgram_CommandBody_Generic);
-         result->generic.command_name = PushCopy(arena, ConsumeString(file, body->command_name_length));
-         result->generic.param_count = body->parameter_count;
-         result->generic.params = ConsumeAndCopyArray(arena, file, f32, body->parameter_count);
+         u32 parameter_count = ConsumeAutoCount(file, version);
+         result->generic.command_name = ConsumeString(file, body->command_name_length);
+         result->generic.param_count = parameter_count;
+         result->generic.params = ConsumeArray(file, f32, parameter_count);
       } break;
 
       case North_CommandType::Wait: {
@@ -513,21 +1370,9 @@ AutoCommand *ParseAutoCommand(buffer *file, MemoryArena *arena) {
          result->pivot.end_angle = body->end_angle;
          result->pivot.turns_clockwise = body->turns_clockwise ? true : false;
 
-         result->pivot.data.velocity.datapoint_count = body->velocity_datapoint_count;
-         Assert(result->pivot.data.velocity.datapoint_count >= 2);
-         result->pivot.data.velocity.datapoints = ConsumeAndCopyArray(arena, file, North_PathDataPoint, body->velocity_datapoint_count);
-
-         result->pivot.data.continuous_event_count = body->continuous_event_count;
-         result->pivot.data.continuous_events = PushArray(arena, AutoContinuousEvent, body->continuous_event_count);
-         for(u32 i = 0; i < body->continuous_event_count; i++) {
-            result->pivot.data.continuous_events[i] = ParseAutoContinuousEvent(file, arena);
-         }
-
-         result->pivot.data.discrete_event_count = body->discrete_event_count;
-         result->pivot.data.discrete_events = PushArray(arena, AutoDiscreteEvent, body->discrete_event_count);
-         for(u32 i = 0; i < body->discrete_event_count; i++) {
-            result->pivot.data.discrete_events[i] = ParseAutoDiscreteEvent(file, arena);
-         }
+         u32 counts[3] = {};
+         ParseAutoPathlikeCounts(file, version, counts);
+         ParseAutoPathlikeData(file, &result->pivot.data, counts, arena, version);
       } break;
 
       default: Assert(false);
@@ -536,269 +1381,1597 @@ AutoCommand *ParseAutoCommand(buffer *file, MemoryArena *arena) {
    return result;
 }
 
-AutoPath *ParseAutoPath(buffer *file, MemoryArena *arena);
-AutoNode *ParseAutoNode(buffer *file, MemoryArena *arena) {
-   AutoNode *result = PushStruct(arena, AutoNode);
+//NOTE: everything but the paths, returns the path count
+u32 ParseAutoNodeData(buffer *file, AutoNode *node, MemoryArena *arena, u32 version) {
    AutonomousProgram_Node *file_node = ConsumeStruct(file, AutonomousProgram_Node);
-   
-   result->pos = file_node->pos;
-   result->path_count = file_node->path_count;
-   result->out_paths = PushArray(arena, AutoPath *, file_node->path_count);
-   result->command_count = file_node->command_count;
-   result->commands = PushArray(arena, AutoCommand *, result->command_count);
-
-   for(u32 i = 0; i < file_node->command_count; i++) {
-      result->commands[i] = ParseAutoCommand(file, arena);
+   u32 command_count = ConsumeAutoCount(file, version);
+   u32 path_count = ConsumeAutoCount(file, version);
+
+   node->pos = file_node->pos;
+   node->command_count = command_count;
+   node->commands = PushArray(arena, AutoCommand *, command_count);
+   for(u32 i = 0; i < command_count; i++) {
+      node->commands[i] = ParseAutoCommand(file, arena, version);
    }
+
+   return path_count;
+}
+
+AutoPath *ParseAutoPath(buffer *file, MemoryArena *arena, u32 version);
+AutoNode *ParseAutoNode(buffer *file, MemoryArena *arena, u32 version) {
+   AutoNode *result = PushStruct(arena, AutoNode);
+   u32 path_count = ParseAutoNodeData(file, result, arena, version);
    
-   for(u32 i = 0; i < file_node->path_count; i++) {
-      AutoPath *path = ParseAutoPath(file, arena);
-      path->in_node = result;
-      RecalculateAutoPath(path);
+   result->path_count = path_count;
+   result->out_paths = PushArray(arena, AutoPath *, path_count);
+   result->pivots_dirty = true;
 
+   for(u32 i = 0; i < path_count; i++) {
+      AutoPath *path = ParseAutoPath(file, arena, version);
+      path->in_node = result;
       result->out_paths[i] = path;
    }
 
    return result;
 }
 
-AutoPath *ParseAutoPath(buffer *file, MemoryArena *arena) {
-   AutoPath *path = PushStruct(arena, AutoPath);
+North_HermiteControlPoint DequantizeControlPoint(AutonomousProgram_QuantizedControlPoint point) {
+   f32 scale = 1.0f / AUTONOMOUS_PROGRAM_QUANTIZE_SCALE;
+   North_HermiteControlPoint result = {};
+   result.pos = V2(point.pos_x * scale, point.pos_y * scale);
+   result.tangent = V2(point.tangent_x * scale, point.tangent_y * scale);
+   return result;
+}
+
+//NOTE: everything but the end node
+void ParseAutoPathData(buffer *file, AutoPath *path, MemoryArena *arena, u32 version) {
    AutonomousProgram_Path *file_path = ConsumeStruct(file, AutonomousProgram_Path);
+   u32 control_point_count = ConsumeAutoCount(file, version);
+   u32 counts[3] = {};
+   ParseAutoPathlikeCounts(file, version, counts);
    
    path->in_tangent = file_path->in_tangent;
    path->out_tangent = file_path->out_tangent;
-   path->is_reverse = file_path->is_reverse ? true : false;
+
+   bool quantized = false;
+   if(version == AUTONOMOUS_PROGRAM_V0_VERSION) {
+      path->is_reverse = file_path->flags ? true : false;
+   } else {
+      path->is_reverse = (file_path->flags & AutonomousProgram_PathFlags::IS_REVERSE) ? true : false;
+      quantized = (file_path->flags & AutonomousProgram_PathFlags::QUANTIZED_CONTROL_POINTS) ? true : false;
+   }
 
    if(file_path->conditional_length == 0) {
       path->conditional = EMPTY_STRING;
       path->has_conditional = false;
    } else {
-      path->conditional =  PushCopy(arena, ConsumeString(file, file_path->conditional_length));
+      path->conditional = ConsumeString(file, file_path->conditional_length);
       path->has_conditional = true;
    }
 
-   path->control_point_count = file_path->control_point_count;
-   path->control_points = ConsumeAndCopyArray(arena, file, North_HermiteControlPoint, file_path->control_point_count);
-   
-   path->data.velocity.datapoint_count = file_path->velocity_datapoint_count;
-   Assert(path->data.velocity.datapoint_count >= 2);
-   path->data.velocity.datapoints = ConsumeAndCopyArray(arena, file, North_PathDataPoint, file_path->velocity_datapoint_count);
-
-   path->data.continuous_event_count = file_path->continuous_event_count;
-   path->data.continuous_events = PushArray(arena, AutoContinuousEvent, path->data.continuous_event_count);
-   for(u32 i = 0; i < file_path->continuous_event_count; i++) {
-      path->data.continuous_events[i] = ParseAutoContinuousEvent(file, arena);
-   }
-
-   path->data.discrete_event_count = file_path->discrete_event_count;
-   path->data.discrete_events = PushArray(arena, AutoDiscreteEvent, path->data.discrete_event_count);
-   for(u32 i = 0; i < file_path->discrete_event_count; i++) {
-      path->data.discrete_events[i] = ParseAutoDiscreteEvent(file, arena);
+   path->control_point_count = control_point_count;
+   if(quantized) {
+      //NOTE: these cant point into the file like everything else
+      AutonomousProgram_QuantizedControlPoint *points = ConsumeArray(file, AutonomousProgram_QuantizedControlPoint, control_point_count);
+      path->control_points = PushArray(arena, North_HermiteControlPoint, control_point_count);
+      for(u32 i = 0; i < control_point_count; i++) {
+         path->control_points[i] = DequantizeControlPoint(points[i]);
+      }
+   } else {
+      path->control_points = ConsumeArray(file, North_HermiteControlPoint, control_point_count);
    }
+   
+   ParseAutoPathlikeData(file, &path->data, counts, arena, version);
+}
 
+AutoPath *ParseAutoPath(buffer *file, MemoryArena *arena, u32 version) {
+   AutoPath *path = PushStruct(arena, AutoPath);
+   ParseAutoPathData(file, path, arena, version);
    InitAutoPath(path);
    
-   path->out_node = ParseAutoNode(file, arena);
+   path->out_node = ParseAutoNode(file, arena, version);
    path->out_node->in_path = path;
    return path;
 }
 
-AutoProjectLink *ReadAutoProject(string file_name, MemoryArena *arena) {
-   buffer file = ReadEntireFile(Concat(file_name, Literal(".ncap")));
-   if(file.data != NULL) {
-      FileHeader *file_numbers = ConsumeStruct(&file, FileHeader);
-      AutonomousProgram_FileHeader *header = ConsumeStruct(&file, AutonomousProgram_FileHeader);
-
-      AutoProjectLink *result = PushStruct(arena, AutoProjectLink);
-      result->name = PushCopy(arena, file_name);
-      result->starting_angle = header->starting_angle;
-      result->starting_node = ParseAutoNode(&file, arena);
-      return result;
+//NOTE: the parsed project is a read only view, strings & arrays point straight into the mapped file 
+//      (other than quantized control points) & no path maps get built, CopyAutoProject makes an editable copy
+//      (the packed arrays arent necessarily aligned, thats fine on x86)
+AutoProjectLink *ParseAutoProjectView(MappedFile file, string name, MemoryArena *arena) {
+   buffer data = file.data;
+   FileHeader *file_numbers = ConsumeStruct(&data, FileHeader);
+   AutonomousProgram_FileHeader *header = ConsumeStruct(&data, AutonomousProgram_FileHeader);
+
+   AutoProjectLink *result = PushStruct(arena, AutoProjectLink);
+   result->name = PushCopy(arena, name);
+   result->starting_angle = header->starting_angle;
+   result->starting_node = ParseAutoNode(&data, arena, file_numbers->version_number);
+   result->is_view = true;
+   result->view_file = file;
+   return result;
+}
+
+//NOTE: builds the path maps of a view (or anything else that doesnt have them yet), 
+//      this only writes to the AutoPaths so the file can stay mapped read only
+void BuildAutoNodePathMaps(AutoNode *node) {
+   for(u32 i = 0; i < node->path_count; i++) {
+      RecalculateAutoPathLength(node->out_paths[i]);
+      BuildAutoNodePathMaps(node->out_paths[i]->out_node);
    }
+}
+
+AutoProjectLink *ReadAutoProjectView(string file_name, MemoryArena *arena = __temp_arena) {
+   MappedFile file = MapEntireFile(Concat(file_name, Literal(".ncap")));
+   if(ValidateAutoProjectFile(file.data))
+      return ParseAutoProjectView(file, file_name, arena);
 
+   UnmapFile(&file);
    return NULL;
 }
 
-void ReadProjectsStartingAt(AutoProjectList *list, u32 field_flags, v2 pos, RobotProfile *bot) {
-   Reset(list->arena);
-   list->first = NULL;
+void FreeAutoProject(AutoProjectLink *project) {
+   if(project != NULL) {
+      FreeAutoNode(project->starting_node);
+      if(project->is_view)
+         UnmapFile(&project->view_file);
+   }
+}
 
-   for(FileListLink *file = ListFilesWithExtension("*.ncap"); file; file = file->next) {
-      AutoProjectLink *auto_proj = ReadAutoProject(file->name, list->arena);
-      if(auto_proj && IsProjectCompatible(auto_proj, bot)) {
-         //TODO: do reflecting and stuff in here
-         bool valid = false;
+AutoContinuousEvent CopyAutoContinuousEvent(AutoContinuousEvent *event, MemoryArena *arena) {
+   AutoContinuousEvent result = {};
+   result.command_name = PushCopy(arena, event->command_name);
+   result.sample_count = event->sample_count;
+   result.samples = PushArrayCopy(arena, North_PathDataPoint, event->samples, event->sample_count);
+   return result;
+}
 
-         if(Length(auto_proj->starting_node->pos - pos) < 0.5) {
-            valid = true;
-         }
+AutoDiscreteEvent CopyAutoDiscreteEvent(AutoDiscreteEvent *event, MemoryArena *arena) {
+   AutoDiscreteEvent result = {};
+   result.command_name = PushCopy(arena, event->command_name);
+   result.param_count = event->param_count;
+   result.params = PushArrayCopy(arena, f32, event->params, event->param_count);
+   result.distance = event->distance;
+   return result;
+}
 
-         if(valid) {
-            auto_proj->next = list->first;
-            list->first = auto_proj;
-         }
-      }
+void CopyPathlikeData(AutoPathlikeData *dest, AutoPathlikeData *src, MemoryArena *arena) {
+   InitPathlikeData(dest, arena);
+   dest->velocity.datapoint_count = src->velocity.datapoint_count;
+   dest->velocity.datapoints = PushArrayCopy(arena, North_PathDataPoint, src->velocity.datapoints, src->velocity.datapoint_count);
+
+   dest->continuous_event_count = src->continuous_event_count;
+   dest->continuous_events = PushArray(arena, AutoContinuousEvent, src->continuous_event_count);
+   for(u32 i = 0; i < src->continuous_event_count; i++) {
+      dest->continuous_events[i] = CopyAutoContinuousEvent(src->continuous_events + i, arena);
    }
-}
-//FILE-READING----------------------------------------------
 
-//FILE-WRITING----------------------------------------------
-void WriteAutoContinuousEvent(buffer *file, AutoContinuousEvent *event) {
-   WriteStructData(file, AutonomousProgram_ContinuousEvent, event_header, {
-      event_header.command_name_length = event->command_name.length;
-      event_header.datapoint_count = event->sample_count;
-   });
-   WriteString(file, event->command_name);
-   WriteArray(file, event->samples, event->sample_count);
+   dest->discrete_event_count = src->discrete_event_count;
+   dest->discrete_events = PushArray(arena, AutoDiscreteEvent, src->discrete_event_count);
+   for(u32 i = 0; i < src->discrete_event_count; i++) {
+      dest->discrete_events[i] = CopyAutoDiscreteEvent(src->discrete_events + i, arena);
+   }
 }
 
-void WriteAutoDiscreteEvent(buffer *file, AutoDiscreteEvent *event) {
-   WriteStructData(file, AutonomousProgram_DiscreteEvent, event_header, {
-      event_header.distance = event->distance;
-      event_header.command_name_length = event->command_name.length;
-      event_header.parameter_count = event->param_count;
-   });
-   WriteString(file, event->command_name);
-   WriteArray(file, event->params, event->param_count);
-}
+AutoCommand *CopyAutoCommand(AutoCommand *command, MemoryArena *arena) {
+   AutoCommand *result = PushStruct(arena, AutoCommand);
+   result->type = command->type;
 
-void WriteAutoCommand(buffer *file, AutoCommand *command) {
-   WriteStructData(file, AutonomousProgram_CommandHeader, header, {
-      header.type = (u8) command->type;
-   });
-   
    switch(command->type) {
       case North_CommandType::Generic: {
-         WriteStructData(file, AutonomousProgram_CommandBody_Generic, body, {
-            body.command_name_length = command->generic.command_name.length;
-            body.parameter_count = command->generic.param_count;
-         });
-         WriteString(file, command->generic.command_name);
-         WriteArray(file, command->generic.params, command->generic.param_count);
+         result->generic.command_name = PushCopy(arena, command->generic.command_name);
+         result->generic.param_count = command->generic.param_count;
+         result->generic.params = PushArrayCopy(arena, f32, command->generic.params, command->generic.param_count);
       } break;
 
       case North_CommandType::Wait: {
-         WriteStructData(file, AutonomousProgram_CommandBody_Wait, body, {
-            body.duration = command->wait.duration;
-         });
+         result->wait.duration = command->wait.duration;
       } break;
 
       case North_CommandType::Pivot: {
-         WriteStructData(file, AutonomousProgram_CommandBody_Pivot, body, {
-            body.start_angle = command->pivot.start_angle;
-            body.end_angle = command->pivot.end_angle;
-            body.turns_clockwise = command->pivot.turns_clockwise;
-            
-            body.velocity_datapoint_count = command->pivot.data.velocity.datapoint_count;
-            body.continuous_event_count = command->pivot.data.continuous_event_count;
-            body.discrete_event_count = command->pivot.data.discrete_event_count;
-         });
-         
-         WriteArray(file, command->pivot.data.velocity.datapoints, command->pivot.data.velocity.datapoint_count);
-         ForEachArray(i, event, command->pivot.data.continuous_event_count, command->pivot.data.continuous_events, {
-            WriteAutoContinuousEvent(file, event);
-         });
-         ForEachArray(i, event, command->pivot.data.discrete_event_count, command->pivot.data.discrete_events, {
-            WriteAutoDiscreteEvent(file, event);
-         });
+         result->pivot.start_angle = command->pivot.start_angle;
+         result->pivot.end_angle = command->pivot.end_angle;
+         result->pivot.turns_clockwise = command->pivot.turns_clockwise;
+         CopyPathlikeData(&result->pivot.data, &command->pivot.data, arena);
       } break;
+
+      default: Assert(false);
    }
+
+   return result;
 }
 
-void WriteAutoPath(buffer *file, AutoPath *path);
-void WriteAutoNode(buffer *file, AutoNode *node) {
-   WriteStructData(file, AutonomousProgram_Node, node_header, {
-      node_header.pos = node->pos;
-      node_header.command_count = node->command_count;
-      node_header.path_count = node->path_count;
-   });
+AutoPath *CopyAutoPath(AutoPath *path, MemoryArena *arena);
+AutoNode *CopyAutoNode(AutoNode *node, MemoryArena *arena) {
+   AutoNode *result = PushStruct(arena, AutoNode);
+   result->pos = node->pos;
+   result->pivots_dirty = true;
 
-   ForEachArray(i, command, node->command_count, node->commands, {
-      WriteAutoCommand(file, *command);
-   });
+   result->command_count = node->command_count;
+   result->commands = PushArray(arena, AutoCommand *, node->command_count);
+   for(u32 i = 0; i < node->command_count; i++) {
+      result->commands[i] = CopyAutoCommand(node->commands[i], arena);
+   }
 
-   ForEachArray(i, path, node->path_count, node->out_paths, {
-      WriteAutoPath(file, *path);
-   });
+   result->path_count = node->path_count;
+   result->out_paths = PushArray(arena, AutoPath *, node->path_count);
+   for(u32 i = 0; i < node->path_count; i++) {
+      AutoPath *path = CopyAutoPath(node->out_paths[i], arena);
+      path->in_node = result;
+      RecalculateAutoPath(path);
+
+      result->out_paths[i] = path;
+   }
+
+   return result;
 }
 
-void WriteAutoPath(buffer *file, AutoPath *path) {
-   WriteStructData(file, AutonomousProgram_Path, path_header, {
-      path_header.in_tangent = path->in_tangent;
-      path_header.out_tangent = path->out_tangent;
-      path_header.is_reverse = path->is_reverse ? 1 : 0;
-      
-      path_header.conditional_length = path->has_conditional ? path->conditional.length : 0;
-      path_header.control_point_count = path->control_point_count;
+//NOTE: everything but the nodes & the path map
+void CopyAutoPathData(AutoPath *dest, AutoPath *src, MemoryArena *arena) {
+   dest->in_tangent = src->in_tangent;
+   dest->out_tangent = src->out_tangent;
+   dest->is_reverse = src->is_reverse;
+   dest->hidden = src->hidden;
+   dest->has_conditional = src->has_conditional;
+   dest->conditional = src->has_conditional ? PushCopy(arena, src->conditional) : EMPTY_STRING;
+
+   dest->control_point_count = src->control_point_count;
+   dest->control_points = PushArrayCopy(arena, North_HermiteControlPoint, src->control_points, src->control_point_count);
+   CopyPathlikeData(&dest->data, &src->data, arena);
+}
 
-      path_header.velocity_datapoint_count = path->data.velocity.datapoint_count;
-      path_header.continuous_event_count = path->data.continuous_event_count;
-      path_header.discrete_event_count = path->data.discrete_event_count;
-   });
+AutoPath *CopyAutoPath(AutoPath *path, MemoryArena *arena) {
+   AutoPath *result = PushStruct(arena, AutoPath);
+   CopyAutoPathData(result, path, arena);
+   InitAutoPath(result);
 
-   if(path->has_conditional)
-      WriteString(file, path->conditional);
-   
-   WriteArray(file, path->control_points, path->control_point_count);
-   
-   WriteArray(file, path->data.velocity.datapoints, path->data.velocity.datapoint_count);
-   ForEachArray(i, event, path->data.continuous_event_count, path->data.continuous_events, {
-      WriteAutoContinuousEvent(file, event);
-   });
-   ForEachArray(i, event, path->data.discrete_event_count, path->data.discrete_events, {
-      WriteAutoDiscreteEvent(file, event);
-   });
+   result->out_node = CopyAutoNode(path->out_node, arena);
+   result->out_node->in_path = result;
+   return result;
+}
 
-   WriteAutoNode(file, path->out_node);
+//NOTE: deep copy into arena with path maps built, use this on a view before editing it
+AutoProjectLink *CopyAutoProject(AutoProjectLink *project, MemoryArena *arena) {
+   AutoProjectLink *result = PushStruct(arena, AutoProjectLink);
+   result->name = PushCopy(arena, project->name);
+   result->starting_angle = project->starting_angle;
+   result->starting_node = CopyAutoNode(project->starting_node, arena);
+   return result;
 }
 
-void WriteProject(AutoProjectLink *project) {
-   buffer file = PushTempBuffer(Megabyte(10));
-   
-   FileHeader file_numbers = header(AUTONOMOUS_PROGRAM_MAGIC_NUMBER, AUTONOMOUS_PROGRAM_CURR_VERSION);
-   WriteStruct(&file, &file_numbers);
-   
-   AutonomousProgram_FileHeader header = {};
-   header.starting_angle = project->starting_angle;
-   WriteStruct(&file, &header);
+AutoProjectLink *ReadAutoProject(string file_name, MemoryArena *arena) {
+   AutoProjectLink *result = NULL;
+   AutoProjectLink *view = ReadAutoProjectView(file_name);
+   if(view != NULL) {
+      result = CopyAutoProject(view, arena);
+      FreeAutoProject(view);
+   }
 
-   WriteAutoNode(&file, project->starting_node);
-   WriteEntireFile(Concat(project->name, Literal(".ncap")), file);
+   return result;
 }
-//FILE-WRITING----------------------------------------------
 
-//NETWORKING------------------------------------------------
-buffer MakeSetStatePacket(v2 pos, f32 angle) {
-   buffer packet = PushTempBuffer(Kilobyte(5));
+//PROJECT-INDEX---------------------------------------------
+#define AUTO_PROJECT_INDEX_FILE_NAME "projects.ncai"
 
-   PacketHeader p_header = { sizeof(SetState_PacketHeader), (u8)PacketType::SetState };
-   WriteStruct(&packet, &p_header);
+struct AutoProjectIndexCommand {
+   AutonomousProgramIndex_CommandUse::type use;
+   u32 param_count;
+   string name;
+};
+
+struct AutoProjectIndexEntry {
+   AutoProjectIndexEntry *next;
+   string name;
+   u64 timestamp;
+   u32 file_size;
+
+   v2 starting_pos;
+   f32 starting_angle;
+   f32 path_length;
+   f32 run_time;
+
+   u32 command_count;
+   AutoProjectIndexCommand *commands;
    
-   SetState_PacketHeader header = {};
-   header.pos = pos;
-   header.angle = angle;
-   WriteStruct(&packet, &header);
+   u32 conditional_count;
+   string *conditionals;
+};
+
+struct AutoProjectIndex {
+   //NOTE: updates rebuild the entries into back_arena & swap, so replaced entries dont pile up
+   MemoryArena *arena;
+   MemoryArena *back_arena;
+   MemoryArena *scratch_arena; //NOTE: projects get loaded into here to be summarized
    
-   return packet;
+   u32 entry_count;
+   AutoProjectIndexEntry *first;
+};
+
+AutoProjectIndexEntry *GetIndexEntry(AutoProjectIndex *index, string name) {
+   for(AutoProjectIndexEntry *entry = index->first; entry; entry = entry->next) {
+      if(entry->name == name)
+         return entry;
+   }
+
+   return NULL;
 }
 
-buffer MakeUploadAutonomousPacket(AutoProjectLink *project) {
-   //TODO: this uses 10MB, make it more efficient
-   buffer data = PushTempBuffer(Megabyte(5));
-   WriteAutoNode(&data, project->starting_node);
+bool IsProjectCompatible(AutoProjectIndexEntry *entry, RobotProfile *bot) {
+   for(u32 i = 0; i < entry->command_count; i++) {
+      AutoProjectIndexCommand *use = entry->commands + i;
+      RobotProfileCommand *command = GetCommand(bot, use->name);
+      if(command == NULL)
+         return false;
+
+      if((use->use == AutonomousProgramIndex_CommandUse::ContinuousEvent) &&
+         (command->type != North_CommandExecutionType::Continuous))
+      {
+         return false;
+      }
+
+      if((use->use == AutonomousProgramIndex_CommandUse::DiscreteEvent) &&
+         ((command->type != North_CommandExecutionType::NonBlocking) || (command->param_count != use->param_count)))
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+//NOTE: the arrays are sized by CountSummaryItems, so they fit even if nothing in the project repeats
+struct AutoProjectSummary {
+   MemoryArena *arena;
+   f32 path_length;
+
+   u32 command_count;
+   u32 max_command_count;
+   AutoProjectIndexCommand *commands;
+   
+   u32 conditional_count;
+   u32 max_conditional_count;
+   string *conditionals;
+};
+
+void CountSummaryItems(AutoPathlikeData *data, u32 *command_count) {
+   *command_count += data->continuous_event_count + data->discrete_event_count;
+}
+
+void CountSummaryItems(AutoNode *node, u32 *command_count, u32 *conditional_count) {
+   for(u32 i = 0; i < node->command_count; i++) {
+      AutoCommand *command = node->commands[i];
+      if(command->type == North_CommandType::Generic) {
+         (*command_count)++;
+      } else if(command->type == North_CommandType::Pivot) {
+         CountSummaryItems(&command->pivot.data, command_count);
+      }
+   }
+
+   for(u32 i = 0; i < node->path_count; i++) {
+      AutoPath *path = node->out_paths[i];
+      if(path->has_conditional)
+         (*conditional_count)++;
+      
+      CountSummaryItems(&path->data, command_count);
+      CountSummaryItems(path->out_node, command_count, conditional_count);
+   }
+}
+
+AutoProjectSummary *PushSummary(MemoryArena *arena, AutoNode *starting_node) {
+   AutoProjectSummary *result = PushStruct(arena, AutoProjectSummary);
+   result->arena = arena;
+   CountSummaryItems(starting_node, &result->max_command_count, &result->max_conditional_count);
+   result->commands = PushArray(arena, AutoProjectIndexCommand, result->max_command_count);
+   result->conditionals = PushArray(arena, string, result->max_conditional_count);
+   return result;
+}
+
+void AddIndexCommand(AutoProjectSummary *summary, AutonomousProgramIndex_CommandUse::type use, u32 param_count, string name) {
+   for(u32 i = 0; i < summary->command_count; i++) {
+      AutoProjectIndexCommand *command = summary->commands + i;
+      if((command->use == use) && (command->param_count == param_count) && (command->name == name))
+         return;
+   }
+   
+   Assert(summary->command_count < summary->max_command_count);
+   AutoProjectIndexCommand new_command = { use, param_count, name };
+   summary->commands[summary->command_count++] = new_command;
+}
+
+f32 SummarizePathlikeData(AutoProjectSummary *summary, AutoPathlikeData *data) {
+   for(u32 i = 0; i < data->continuous_event_count; i++) {
+      AddIndexCommand(summary, AutonomousProgramIndex_CommandUse::ContinuousEvent, 0, data->continuous_events[i].command_name);
+   }
+
+   for(u32 i = 0; i < data->discrete_event_count; i++) {
+      AutoDiscreteEvent *event = data->discrete_events + i;
+      AddIndexCommand(summary, AutonomousProgramIndex_CommandUse::DiscreteEvent, event->param_count, event->command_name);
+   }
+
+   DVTA_Data dvta = GetDVTA(data, summary->arena);
+   return dvta.t[dvta.datapoint_count - 1];
+}
+
+//NOTE: returns the time the longest route from node takes
+f32 SummarizeAutoNode(AutoProjectSummary *summary, AutoNode *node) {
+   f32 node_time = 0;
+   for(u32 i = 0; i < node->command_count; i++) {
+      AutoCommand *command = node->commands[i];
+      if(command->type == North_CommandType::Generic) {
+         AddIndexCommand(summary, AutonomousProgramIndex_CommandUse::Command, command->generic.param_count, command->generic.command_name);
+      } else if(command->type == North_CommandType::Wait) {
+         node_time += command->wait.duration;
+      } else if(command->type == North_CommandType::Pivot) {
+         node_time += SummarizePathlikeData(summary, &command->pivot.data);
+      }
+   }
+
+   f32 longest_path_time = 0;
+   for(u32 i = 0; i < node->path_count; i++) {
+      AutoPath *path = node->out_paths[i];
+      summary->path_length += path->length;
+      
+      if(path->has_conditional) {
+         bool found = false;
+         for(u32 j = 0; j < summary->conditional_count; j++) {
+            found = found || (summary->conditionals[j] == path->conditional);
+         }
+
+         if(!found) {
+            Assert(summary->conditional_count < summary->max_conditional_count);
+            summary->conditionals[summary->conditional_count++] = path->conditional;
+         }
+      }
+
+      f32 path_time = SummarizePathlikeData(summary, &path->data) + SummarizeAutoNode(summary, path->out_node);
+      longest_path_time = Max(longest_path_time, path_time);
+   }
+
+   return node_time + longest_path_time;
+}
+
+AutoProjectIndexEntry *PushIndexEntry(MemoryArena *arena, string name, u32 command_count, u32 conditional_count) {
+   AutoProjectIndexEntry *result = PushStruct(arena, AutoProjectIndexEntry);
+   result->name = PushCopy(arena, name);
+   result->command_count = command_count;
+   result->commands = PushArray(arena, AutoProjectIndexCommand, command_count);
+   result->conditional_count = conditional_count;
+   result->conditionals = PushArray(arena, string, conditional_count);
+   return result;
+}
+
+AutoProjectIndexEntry *CopyIndexEntry(AutoProjectIndexEntry *entry, MemoryArena *arena) {
+   AutoProjectIndexEntry *result = PushIndexEntry(arena, entry->name, entry->command_count, entry->conditional_count);
+   result->timestamp = entry->timestamp;
+   result->file_size = entry->file_size;
+   result->starting_pos = entry->starting_pos;
+   result->starting_angle = entry->starting_angle;
+   result->path_length = entry->path_length;
+   result->run_time = entry->run_time;
+
+   for(u32 i = 0; i < entry->command_count; i++) {
+      result->commands[i] = entry->commands[i];
+      result->commands[i].name = PushCopy(arena, entry->commands[i].name);
+   }
+
+   for(u32 i = 0; i < entry->conditional_count; i++) {
+      result->conditionals[i] = PushCopy(arena, entry->conditionals[i]);
+   }
+
+   return result;
+}
+
+//NOTE: loads the whole project (path maps & all) into the scratch arena, so only do this when it changed
+AutoProjectIndexEntry *IndexAutoProject(AutoProjectIndex *index, string name, u64 timestamp, MemoryArena *arena) {
+   Reset(index->scratch_arena);
+   AutoProjectLink *view = ReadAutoProjectView(name, index->scratch_arena);
+   if(view == NULL)
+      return NULL;
+
+   AutoProjectLink *project = CopyAutoProject(view, index->scratch_arena);
+   AutoProjectSummary *summary = PushSummary(index->scratch_arena, project->starting_node);
+   f32 run_time = SummarizeAutoNode(summary, project->starting_node);
+   
+   AutoProjectIndexEntry *result = PushIndexEntry(arena, name, summary->command_count, summary->conditional_count);
+   for(u32 i = 0; i < summary->command_count; i++) {
+      result->commands[i] = summary->commands[i];
+      result->commands[i].name = PushCopy(arena, summary->commands[i].name);
+   }
+
+   for(u32 i = 0; i < summary->conditional_count; i++) {
+      result->conditionals[i] = PushCopy(arena, summary->conditionals[i]);
+   }
+
+   result->timestamp = timestamp;
+   result->file_size = view->view_file.data.size;
+   result->starting_pos = project->starting_node->pos;
+   result->starting_angle = project->starting_angle;
+   result->path_length = summary->path_length;
+   result->run_time = run_time;
+
+   FreeAutoProject(project);
+   FreeAutoProject(view);
+   return result;
+}
+
+//NOTE: the in memory entries dont have the file's limits, entries that dont fit just dont get written 
+//      (instead of being truncated) so those projects are indexed again every time the index is loaded
+bool IndexEntryFitsFile(AutoProjectIndexEntry *entry) {
+   if((entry->name.length > 0xFF) || (entry->command_count > 0xFFFF) || (entry->conditional_count > 0xFFFF))
+      return false;
+
+   for(u32 i = 0; i < entry->command_count; i++) {
+      if((entry->commands[i].param_count > 0xFF) || (entry->commands[i].name.length > 0xFF))
+         return false;
+   }
+
+   for(u32 i = 0; i < entry->conditional_count; i++) {
+      if(entry->conditionals[i].length > 0xFF)
+         return false;
+   }
+
+   return true;
+}
+
+void WriteProjectIndex(buffer *file, AutoProjectIndex *index) {
+   FileHeader file_numbers = header(AUTONOMOUS_PROGRAM_INDEX_MAGIC_NUMBER, AUTONOMOUS_PROGRAM_INDEX_CURR_VERSION);
+   WriteStruct(file, &file_numbers);
+
+   u32 project_count = 0;
+   for(AutoProjectIndexEntry *entry = index->first; entry; entry = entry->next) {
+      if(IndexEntryFitsFile(entry))
+         project_count++;
+   }
+
+   WriteStructData(file, AutonomousProgramIndex_FileHeader, index_header, {
+      index_header.project_count = project_count;
+   });
+
+   for(AutoProjectIndexEntry *entry = index->first; entry; entry = entry->next) {
+      if(!IndexEntryFitsFile(entry))
+         continue;
+
+      WriteStructData(file, AutonomousProgramIndex_Project, project, {
+         project.timestamp = entry->timestamp;
+         project.file_size = entry->file_size;
+         project.starting_pos = entry->starting_pos;
+         project.starting_angle = entry->starting_angle;
+         project.path_length = entry->path_length;
+         project.run_time = entry->run_time;
+         project.name_length = entry->name.length;
+         project.command_count = entry->command_count;
+         project.conditional_count = entry->conditional_count;
+      });
+      WriteString(file, entry->name);
+
+      for(u32 i = 0; i < entry->command_count; i++) {
+         AutoProjectIndexCommand *command = entry->commands + i;
+         WriteStructData(file, AutonomousProgramIndex_Command, file_command, {
+            file_command.use = (u8) command->use;
+            file_command.parameter_count = command->param_count;
+            file_command.command_name_length = command->name.length;
+         });
+         WriteString(file, command->name);
+      }
+
+      for(u32 i = 0; i < entry->conditional_count; i++) {
+         u8 length = entry->conditionals[i].length;
+         WriteStruct(file, &length);
+         WriteString(file, entry->conditionals[i]);
+      }
+   }
+
+}
+
+void WriteProjectIndex(AutoProjectIndex *index) {
+   buffer sizer = {};
+   WriteProjectIndex(&sizer, index);
+   
+   buffer file = PushTempBuffer(sizer.offset);
+   WriteProjectIndex(&file, index);
+   ReplaceEntireFile(AUTO_PROJECT_INDEX_FILE_NAME, file);
+}
+
+void ReadProjectIndex(AutoProjectIndex *index) {
+   Reset(index->arena);
+   index->first = NULL;
+   index->entry_count = 0;
+
+   buffer file = ReadEntireFile(AUTO_PROJECT_INDEX_FILE_NAME);
+   if(!ValidateAutoProjectIndexFile(file))
+      return;
+   
+   ConsumeStruct(&file, FileHeader);
+   AutonomousProgramIndex_FileHeader *index_header = ConsumeStruct(&file, AutonomousProgramIndex_FileHeader);
+   for(u32 i = 0; i < index_header->project_count; i++) {
+      AutonomousProgramIndex_Project *project = ConsumeStruct(&file, AutonomousProgramIndex_Project);
+      string name = ConsumeString(&file, project->name_length);
+      
+      AutoProjectIndexEntry *entry = PushIndexEntry(index->arena, name, project->command_count, project->conditional_count);
+      entry->timestamp = project->timestamp;
+      entry->file_size = project->file_size;
+      entry->starting_pos = project->starting_pos;
+      entry->starting_angle = project->starting_angle;
+      entry->path_length = project->path_length;
+      entry->run_time = project->run_time;
+
+      for(u32 j = 0; j < project->command_count; j++) {
+         AutonomousProgramIndex_Command *file_command = ConsumeStruct(&file, AutonomousProgramIndex_Command);
+         entry->commands[j].use = (AutonomousProgramIndex_CommandUse::type) file_command->use;
+         entry->commands[j].param_count = file_command->parameter_count;
+         entry->commands[j].name = PushCopy(index->arena, ConsumeString(&file, file_command->command_name_length));
+      }
+
+      for(u32 j = 0; j < project->conditional_count; j++) {
+         u8 *length = ConsumeStruct(&file, u8);
+         entry->conditionals[j] = PushCopy(index->arena, ConsumeString(&file, *length));
+      }
+
+      entry->next = index->first;
+      index->first = entry;
+      index->entry_count++;
+   }
+}
+
+void InitProjectIndex(AutoProjectIndex *index) {
+   index->arena = PlatformAllocArena(Kilobyte(256), "Project Index");
+   index->back_arena = PlatformAllocArena(Kilobyte(256), "Project Index Back");
+   index->scratch_arena = PlatformAllocArena(Megabyte(1), "Project Index Scratch");
+   ReadProjectIndex(index);
+}
+
+//NOTE: call after CheckFiles, only .ncaps that are new or have a different timestamp get parsed,
+//      the index file gets rewritten if anything changed
+bool UpdateProjectIndex(AutoProjectIndex *index, FileWatcher *watcher) {
+   Reset(index->back_arena);
+   
+   bool changed = false;
+   u32 entry_count = 0;
+   u32 kept_count = 0;
+   AutoProjectIndexEntry *first = NULL;
+   for(FileWatcherLink *link = watcher->first_in_list; link; link = link->next_in_list) {
+      //NOTE: same naming as ListFilesWithExtension, everything before the first '.'
+      u32 name_length = 0;
+      while((name_length < link->name.length) && (link->name.text[name_length] != '.'))
+         name_length++;
+      
+      string name = String(link->name.text, name_length);
+      string extension = String(link->name.text + name_length, link->name.length - name_length);
+      if(!link->found || !(extension == Literal(".ncap")))
+         continue;
+
+      AutoProjectIndexEntry *existing = GetIndexEntry(index, name);
+      AutoProjectIndexEntry *entry = NULL;
+      if(existing && (existing->timestamp == link->timestamp)) {
+         entry = CopyIndexEntry(existing, index->back_arena);
+         kept_count++;
+      } else {
+         entry = IndexAutoProject(index, name, link->timestamp, index->back_arena);
+         changed = true;
+      }
+
+      if(entry != NULL) {
+         entry->next = first;
+         first = entry;
+         entry_count++;
+      }
+   }
+
+   //NOTE: anything in the old index we didnt keep got deleted
+   changed = changed || (kept_count != index->entry_count);
+
+   MemoryArena *old_arena = index->arena;
+   index->arena = index->back_arena;
+   index->back_arena = old_arena;
+   index->first = first;
+   index->entry_count = entry_count;
+
+   if(changed)
+      WriteProjectIndex(index);
+   
+   return changed;
+}
+//PROJECT-INDEX---------------------------------------------
+
+//NOTE: reads the starting node's position without parsing (& building path maps for) the whole project
+bool GetAutoProjectStartingPos(buffer file, v2 *pos) {
+   if(file.size < (sizeof(FileHeader) + sizeof(AutonomousProgram_FileHeader) + sizeof(AutonomousProgram_Node)))
+      return false;
+
+   ConsumeStruct(&file, FileHeader);
+   ConsumeStruct(&file, AutonomousProgram_FileHeader);
+   AutonomousProgram_Node *starting_node = PeekStruct(&file, AutonomousProgram_Node);
+   *pos = starting_node->pos;
+   return true;
+}
+
+struct ProjectLoader {
+   u32 file_count;
+   string *file_names;
+   AutoProjectLink **results; //NOTE: indexed by file, so the merge order doesnt depend on which worker got what
+   volatile u32 next_file;
+
+   v2 pos;
+   RobotProfile *bot;
+};
+
+struct ProjectLoaderWorker {
+   ProjectLoader *loader;
+   MemoryArena *arena;
+   MemoryArena *temp_arena; //NOTE: NULL for the calling thread, it keeps using its own __temp_arena
+   PlatformThread thread;
+};
+
+void LoadProjectsWorker(void *data) {
+   ProjectLoaderWorker *worker = (ProjectLoaderWorker *) data;
+   ProjectLoader *loader = worker->loader;
+   if(worker->temp_arena != NULL)
+      __temp_arena = worker->temp_arena;
+
+   for(u32 i = AtomicIncrement(&loader->next_file) - 1; i < loader->file_count; 
+       i = AtomicIncrement(&loader->next_file) - 1) 
+   {
+      string file_name = loader->file_names[i];
+      MappedFile file = MapEntireFile(Concat(file_name, Literal(".ncap")));
+      
+      //TODO: do reflecting and stuff in here
+      v2 starting_pos = V2(0, 0);
+      if(GetAutoProjectStartingPos(file.data, &starting_pos) && (Length(starting_pos - loader->pos) < 0.5) &&
+         ValidateAutoProjectFile(file.data)) 
+      {
+         //NOTE: the results stay views of the mapped files with path maps built, 
+         //      nothing gets copied out until a project is opened for editing (CopyAutoProject)
+         AutoProjectLink *view = ParseAutoProjectView(file, file_name, worker->arena);
+         if(IsProjectCompatible(view, loader->bot)) {
+            BuildAutoNodePathMaps(view->starting_node);
+            loader->results[i] = view;
+         } else {
+            FreeAutoProject(view);
+         }
+      } else {
+         UnmapFile(&file);
+      }
+
+      if(worker->temp_arena != NULL)
+         Reset(worker->temp_arena);
+   }
+}
+
+//NOTE: with an (up to date) index only the projects that pass its start pos & compatibility checks get opened
+void ReadProjectsStartingAt(AutoProjectList *list, v2 pos, RobotProfile *bot, 
+                            AutoProjectIndex *index = NULL) 
+{
+   for(AutoProjectLink *project = list->first; project; project = project->next) {
+      FreeAutoProject(project);
+   }
+   
+   Reset(list->arena);
+   for(u32 i = 0; i < ArraySize(list->worker_arenas); i++) {
+      if(list->worker_arenas[i] != NULL) {
+         Reset(list->worker_arenas[i]);
+         Reset(list->worker_temp_arenas[i]);
+      }
+   }
+   list->first = NULL;
+
+   ProjectLoader loader = {};
+   loader.pos = pos;
+   loader.bot = bot;
+
+   if(index != NULL) {
+      loader.file_names = PushTempArray(string, index->entry_count);
+      for(AutoProjectIndexEntry *entry = index->first; entry; entry = entry->next) {
+         if((Length(entry->starting_pos - pos) < 0.5) && IsProjectCompatible(entry, bot))
+            loader.file_names[loader.file_count++] = entry->name;
+      }
+   } else {
+      FileListLink *files = ListFilesWithExtension("*.ncap");
+      for(FileListLink *file = files; file; file = file->next) {
+         loader.file_count++;
+      }
+      
+      loader.file_names = PushTempArray(string, loader.file_count);
+      u32 file_i = 0;
+      for(FileListLink *file = files; file; file = file->next) {
+         loader.file_names[file_i++] = file->name;
+      }
+   }
+
+   loader.results = PushTempArray(AutoProjectLink *, loader.file_count);
+   for(u32 i = 0; i < loader.file_count; i++) {
+      loader.results[i] = NULL;
+   }
+
+   //NOTE: these arent thread safe to set up lazily so do it before any workers start
+   GetPathMapPool();
+   GetHermiteBatchKernel();
+
+   u32 worker_count = Clamp(1, PROJECT_LOADER_MAX_WORKERS, Min(GetProcessorCount(), loader.file_count));
+   ProjectLoaderWorker workers[PROJECT_LOADER_MAX_WORKERS] = {};
+   for(u32 i = 0; i < worker_count; i++) {
+      workers[i].loader = &loader;
+      if(i == 0) {
+         workers[i].arena = list->arena;
+      } else {
+         if(list->worker_arenas[i - 1] == NULL) {
+            list->worker_arenas[i - 1] = PlatformAllocArena(Megabyte(1), "Project Loader");
+            list->worker_temp_arenas[i - 1] = PlatformAllocArena(Megabyte(1), "Project Loader Temp");
+         }
+
+         workers[i].arena = list->worker_arenas[i - 1];
+         workers[i].temp_arena = list->worker_temp_arenas[i - 1];
+         StartThread(&workers[i].thread, LoadProjectsWorker, workers + i);
+      }
+   }
+
+   LoadProjectsWorker(workers + 0);
+   for(u32 i = 1; i < worker_count; i++) {
+      JoinThread(&workers[i].thread);
+   }
+
+   for(u32 i = 0; i < loader.file_count; i++) {
+      AutoProjectLink *auto_proj = loader.results[i];
+      if(auto_proj != NULL) {
+         auto_proj->next = list->first;
+         list->first = auto_proj;
+      }
+   }
+}
+//FILE-READING----------------------------------------------
+
+//FILE-WRITING----------------------------------------------
+struct AutoProjectEncoding {
+   u32 version; //NOTE: only UploadAutonomous still gets written as version 0
+   bool quantize_control_points; //NOTE: lossy, so only for uploads (& north_tool --quantize)
+};
+
+AutoProjectEncoding AutoProjectFileEncoding(bool quantize_control_points = false) {
+   AutoProjectEncoding result = {};
+   result.version = AUTONOMOUS_PROGRAM_CURR_VERSION;
+   result.quantize_control_points = quantize_control_points;
+   return result;
+}
+
+//NOTE: a u8 in version 0, a varint after that
+void WriteAutoCount(buffer *file, u32 count, AutoProjectEncoding encoding) {
+   if(encoding.version == AUTONOMOUS_PROGRAM_V0_VERSION) {
+      //NOTE: check FitsAutoProjectV0 before writing version 0
+      Assert(count <= 0xFF);
+      u8 count_u8 = (u8) count;
+      WriteStruct(file, &count_u8);
+   } else {
+      WriteVarint(file, count);
+   }
+}
+
+void WriteAutoContinuousEvent(buffer *file, AutoContinuousEvent *event, AutoProjectEncoding encoding) {
+   WriteStructData(file, AutonomousProgram_ContinuousEvent, event_header, {
+      event_header.command_name_length = event->command_name.length;
+   });
+   WriteAutoCount(file, event->sample_count, encoding);
+   WriteString(file, event->command_name);
+   WriteArray(file, event->samples, event->sample_count);
+}
+
+void WriteAutoDiscreteEvent(buffer *file, AutoDiscreteEvent *event, AutoProjectEncoding encoding) {
+   WriteStructData(file, AutonomousProgram_DiscreteEvent, event_header, {
+      event_header.distance = event->distance;
+      event_header.command_name_length = event->command_name.length;
+   });
+   WriteAutoCount(file, event->param_count, encoding);
+   WriteString(file, event->command_name);
+   WriteArray(file, event->params, event->param_count);
+}
+
+void WriteAutoPathlikeCounts(buffer *file, AutoPathlikeData *data, AutoProjectEncoding encoding) {
+   WriteAutoCount(file, data->velocity.datapoint_count, encoding);
+   WriteAutoCount(file, data->continuous_event_count, encoding);
+   WriteAutoCount(file, data->discrete_event_count, encoding);
+}
+
+void WriteAutoPathlikeData(buffer *file, AutoPathlikeData *data, AutoProjectEncoding encoding) {
+   WriteArray(file, data->velocity.datapoints, data->velocity.datapoint_count);
+   ForEachArray(i, event, data->continuous_event_count, data->continuous_events, {
+      WriteAutoContinuousEvent(file, event, encoding);
+   });
+   ForEachArray(i, event, data->discrete_event_count, data->discrete_events, {
+      WriteAutoDiscreteEvent(file, event, encoding);
+   });
+}
+
+void WriteAutoCommand(buffer *file, AutoCommand *command, AutoProjectEncoding encoding) {
+   WriteStructData(file, AutonomousProgram_CommandHeader, header, {
+      header.type = (u8) command->type;
+   });
+   
+   switch(command->type) {
+      case North_CommandType::Generic: {
+         WriteStructData(file, AutonomousProgram_CommandBody_Generic, body, {
+            body.command_name_length = command->generic.command_name.length;
+         });
+         WriteAutoCount(file, command->generic.param_count, encoding);
+         WriteString(file, command->generic.command_name);
+         WriteArray(file, command->generic.params, command->generic.param_count);
+      } break;
+
+      case North_CommandType::Wait: {
+         WriteStructData(file, AutonomousProgram_CommandBody_Wait, body, {
+            body.duration = command->wait.duration;
+         });
+      } break;
+
+      case North_CommandType::Pivot: {
+         WriteStructData(file, AutonomousProgram_CommandBody_Pivot, body, {
+            body.start_angle = command->pivot.start_angle;
+            body.end_angle = command->pivot.end_angle;
+            body.turns_clockwise = command->pivot.turns_clockwise;
+         });
+         
+         WriteAutoPathlikeCounts(file, &command->pivot.data, encoding);
+         WriteAutoPathlikeData(file, &command->pivot.data, encoding);
+      } break;
+   }
+}
+
+//NOTE: everything but the paths
+void WriteAutoNodeData(buffer *file, AutoNode *node, AutoProjectEncoding encoding) {
+   WriteStructData(file, AutonomousProgram_Node, node_header, {
+      node_header.pos = node->pos;
+   });
+   WriteAutoCount(file, node->command_count, encoding);
+   WriteAutoCount(file, node->path_count, encoding);
+
+   ForEachArray(i, command, node->command_count, node->commands, {
+      WriteAutoCommand(file, *command, encoding);
+   });
+}
+
+void WriteAutoPath(buffer *file, AutoPath *path, AutoProjectEncoding encoding);
+void WriteAutoNode(buffer *file, AutoNode *node, AutoProjectEncoding encoding) {
+   WriteAutoNodeData(file, node, encoding);
+   ForEachArray(i, path, node->path_count, node->out_paths, {
+      WriteAutoPath(file, *path, encoding);
+   });
+}
+
+//NOTE: written so NaN fails the range check too (every comparison with it is false), same as inf
+bool QuantizeControlValue(f32 value, s16 *result) {
+   f32 scaled = value * AUTONOMOUS_PROGRAM_QUANTIZE_SCALE;
+   if(!((scaled >= -32768.0f) && (scaled <= 32767.0f)))
+      return false;
+
+   *result = (s16)(scaled + ((scaled < 0) ? -0.5f : 0.5f));
+   return true;
+}
+
+//NOTE: false if any of them are out of range, then the path gets written as f32s
+bool QuantizeControlPoints(North_HermiteControlPoint *points, u32 count, AutonomousProgram_QuantizedControlPoint *result) {
+   for(u32 i = 0; i < count; i++) {
+      if(!QuantizeControlValue(points[i].pos.x, &result[i].pos_x) ||
+         !QuantizeControlValue(points[i].pos.y, &result[i].pos_y) ||
+         !QuantizeControlValue(points[i].tangent.x, &result[i].tangent_x) ||
+         !QuantizeControlValue(points[i].tangent.y, &result[i].tangent_y))
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+//NOTE: everything but the end node
+void WriteAutoPathData(buffer *file, AutoPath *path, AutoProjectEncoding encoding) {
+   AutonomousProgram_QuantizedControlPoint *quantized_points = NULL;
+   if(encoding.quantize_control_points && (encoding.version != AUTONOMOUS_PROGRAM_V0_VERSION)) {
+      quantized_points = PushTempArray(AutonomousProgram_QuantizedControlPoint, path->control_point_count);
+      if(!QuantizeControlPoints(path->control_points, path->control_point_count, quantized_points))
+         quantized_points = NULL;
+   }
+
+   WriteStructData(file, AutonomousProgram_Path, path_header, {
+      path_header.in_tangent = path->in_tangent;
+      path_header.out_tangent = path->out_tangent;
+      path_header.flags = (path->is_reverse ? AutonomousProgram_PathFlags::IS_REVERSE : 0) |
+                          (quantized_points ? AutonomousProgram_PathFlags::QUANTIZED_CONTROL_POINTS : 0);
+      path_header.conditional_length = path->has_conditional ? path->conditional.length : 0;
+   });
+   WriteAutoCount(file, path->control_point_count, encoding);
+   WriteAutoPathlikeCounts(file, &path->data, encoding);
+
+   if(path->has_conditional)
+      WriteString(file, path->conditional);
+   
+   if(quantized_points) {
+      WriteArray(file, quantized_points, path->control_point_count);
+   } else {
+      WriteArray(file, path->control_points, path->control_point_count);
+   }
+   
+   WriteAutoPathlikeData(file, &path->data, encoding);
+}
+
+void WriteAutoPath(buffer *file, AutoPath *path, AutoProjectEncoding encoding) {
+   WriteAutoPathData(file, path, encoding);
+   WriteAutoNode(file, path->out_node, encoding);
+}
+
+void WriteAutoProject(buffer *file, AutoProjectLink *project, AutoProjectEncoding encoding) {
+   FileHeader file_numbers = header(AUTONOMOUS_PROGRAM_MAGIC_NUMBER, encoding.version);
+   WriteStruct(file, &file_numbers);
+   
+   AutonomousProgram_FileHeader header = {};
+   header.starting_angle = project->starting_angle;
+   WriteStruct(file, &header);
+
+   WriteAutoNode(file, project->starting_node, encoding);
+}
+
+buffer EncodeAutoProject(AutoProjectLink *project, AutoProjectEncoding encoding = AutoProjectFileEncoding()) {
+   //NOTE: size it first so the temp buffer is exactly as big as the file
+   buffer sizer = {};
+   WriteAutoProject(&sizer, project, encoding);
+
+   buffer file = PushTempBuffer(sizer.offset);
+   WriteAutoProject(&file, project, encoding);
+   return file;
+}
+
+bool WriteProject(AutoProjectLink *project) {
+   return ReplaceEntireFile(Concat(project->name, Literal(".ncap")), EncodeAutoProject(project));
+}
+//FILE-WRITING----------------------------------------------
+
+//PROJECT-JOURNAL-------------------------------------------
+//NOTE: autosave, edits get appended to "name.ncaj" as small records instead of rewriting the whole .ncap
+//      so an autosave costs about as much as the edit. the journal gets compacted (the .ncap rewritten 
+//      & the journal emptied) on save, when the project gets closed & when it outgrows the project
+#define AUTO_PROJECT_JOURNAL_WATCH_COUNT 32
+#define AUTO_PROJECT_JOURNAL_MIN_COMPACT_SIZE Kilobyte(16)
+
+struct AutoProjectJournalWatch {
+   AutonomousProgramJournal_RecordType::type type; //NOTE: Node or Path
+   void *item;
+   u32 hash;
+   bool dirty;
+};
+
+struct AutoProjectJournal {
+   MemoryArena *arena; //NOTE: owned by AutoProjectJournal, just holds the name
+   string name; //NOTE: empty if there's no journal open
+   AutoProjectLink *project;
+
+   u64 size;
+   u64 project_size;
+   u32 version; //NOTE: of the file, records only get appended to a AUTONOMOUS_PROGRAM_JOURNAL_CURR_VERSION journal
+   bool needs_compact;
+   //NOTE: an edit couldnt be journaled, the records after it wouldnt replay right without it 
+   //      so nothing gets appended until the compact puts it all in the .ncap
+   bool skipping_records;
+
+   //NOTE: the nodes & paths being edited get hashed every frame, their records only get written 
+   //      once they stop changing (eg. at the end of a drag) instead of every frame
+   bool changed;
+   u32 watch_count;
+   u32 next_evicted;
+   AutoProjectJournalWatch watches[AUTO_PROJECT_JOURNAL_WATCH_COUNT];
+};
+
+void InitAutoProjectJournal(AutoProjectJournal *journal) {
+   journal->arena = PlatformAllocArena(Kilobyte(4), "Project Journal");
+}
+
+bool IsOpen(AutoProjectJournal *journal) {
+   return journal->name.length > 0;
+}
+
+string AutoProjectJournalFileName(string name) {
+   return Concat(name, Literal(".ncaj"));
+}
+
+u32 GetAutoNodeDepth(AutoNode *node) {
+   u32 result = 0;
+   for(; node->in_path != NULL; node = node->in_path->in_node)
+      result++;
+   return result;
+}
+
+u32 GetAutoPathIndex(AutoPath *path) {
+   AutoNode *node = path->in_node;
+   for(u32 i = 0; i < node->path_count; i++) {
+      if(node->out_paths[i] == path)
+         return i;
+   }
+
+   Assert(false);
+   return 0;
+}
+
+AutoNode *GetAutoNodeAt(AutoProjectLink *project, u8 *address, u32 address_length) {
+   AutoNode *node = project->starting_node;
+   for(u32 i = 0; i < address_length; i++) {
+      if(address[i] >= node->path_count)
+         return NULL;
+      
+      node = node->out_paths[address[i]]->out_node;
+   }
+
+   return node;
+}
+
+//NOTE: Node & AddPath records are addressed by a node, Path & RemovePath by a path
+bool AddressedByPath(AutonomousProgramJournal_RecordType::type type) {
+   return (type == AutonomousProgramJournal_RecordType::Path) || 
+          (type == AutonomousProgramJournal_RecordType::RemovePath);
+}
+
+//NOTE: item is an AutoNode for Node records & an AutoPath for the rest
+void WriteAutoProjectJournalBody(buffer *file, AutonomousProgramJournal_RecordType::type type, void *item) {
+   AutoProjectEncoding encoding = AutoProjectFileEncoding();
+   switch(type) {
+      case AutonomousProgramJournal_RecordType::Node: WriteAutoNodeData(file, (AutoNode *) item, encoding); break;
+      case AutonomousProgramJournal_RecordType::Path: WriteAutoPathData(file, (AutoPath *) item, encoding); break;
+      case AutonomousProgramJournal_RecordType::AddPath: WriteAutoPath(file, (AutoPath *) item, encoding); break;
+      case AutonomousProgramJournal_RecordType::RemovePath: break;
+   }
+}
+
+u32 GetAutoProjectJournalAddressLength(AutonomousProgramJournal_RecordType::type type, void *item) {
+   if(type == AutonomousProgramJournal_RecordType::Node)
+      return GetAutoNodeDepth((AutoNode *) item);
+   
+   AutoPath *path = (AutoPath *) item;
+   return GetAutoNodeDepth(path->in_node) + (AddressedByPath(type) ? 1 : 0);
+}
+
+//NOTE: the address is a u8 per node & there can only be 0xFF of them, 
+//      anything deeper or past the 256th path of a node cant be journaled
+bool FitsAutoProjectJournalAddress(AutonomousProgramJournal_RecordType::type type, void *item) {
+   if(GetAutoProjectJournalAddressLength(type, item) > 0xFF)
+      return false;
+
+   AutoNode *node = (type == AutonomousProgramJournal_RecordType::Node) ? (AutoNode *) item : ((AutoPath *) item)->in_node;
+   if(AddressedByPath(type) && (GetAutoPathIndex((AutoPath *) item) > 0xFF))
+      return false;
+
+   for(; node->in_path != NULL; node = node->in_path->in_node) {
+      if(GetAutoPathIndex(node->in_path) > 0xFF)
+         return false;
+   }
+
+   return true;
+}
+
+//NOTE: only for items that FitsAutoProjectJournalAddress
+void WriteAutoProjectJournalRecord(buffer *file, AutonomousProgramJournal_RecordType::type type, void *item) {
+   u32 address_length = GetAutoProjectJournalAddressLength(type, item);
+   u8 *address = PushTempArray(u8, address_length);
+   
+   AutoNode *node = (type == AutonomousProgramJournal_RecordType::Node) ? (AutoNode *) item : ((AutoPath *) item)->in_node;
+   u32 depth = GetAutoNodeDepth(node);
+   if(AddressedByPath(type))
+      address[depth] = (u8) GetAutoPathIndex((AutoPath *) item);
+   
+   for(u32 i = depth; i > 0; i--) {
+      address[i - 1] = (u8) GetAutoPathIndex(node->in_path);
+      node = node->in_path->in_node;
+   }
+
+   buffer body_sizer = {};
+   WriteAutoProjectJournalBody(&body_sizer, type, item);
+
+   WriteStructData(file, AutonomousProgramJournal_Record, record, {
+      record.type = (u8) type;
+      record.address_length = (u8) address_length;
+      record.size = body_sizer.offset;
+   });
+   WriteArray(file, address, address_length);
+   WriteAutoProjectJournalBody(file, type, item);
+}
+
+//NOTE: writes project_file as name.ncap's base, any old records in the journal get dropped
+void StartAutoProjectJournal(AutoProjectJournal *journal, string name, buffer project_file) {
+   //NOTE: name might be journal->name, which goes away with the reset
+   name = PushTempCopy(name);
+   Reset(journal->arena);
+   journal->name = PushCopy(journal->arena, name);
+   journal->project_size = project_file.size;
+   journal->version = AUTONOMOUS_PROGRAM_JOURNAL_CURR_VERSION;
+   journal->needs_compact = false;
+   journal->skipping_records = false;
+   journal->changed = false;
+   journal->watch_count = 0;
+
+   buffer file = PushTempBuffer(sizeof(FileHeader) + sizeof(AutonomousProgramJournal_FileHeader));
+   FileHeader numbers = header(AUTONOMOUS_PROGRAM_JOURNAL_MAGIC_NUMBER, AUTONOMOUS_PROGRAM_JOURNAL_CURR_VERSION);
+   WriteStruct(&file, &numbers);
+
+   WriteStructData(&file, AutonomousProgramJournal_FileHeader, journal_header, {
+      journal_header.project_size = project_file.size;
+      journal_header.project_hash = Hash(String((char *) project_file.data, project_file.size));
+   });
+
+   ReplaceEntireFile(AutoProjectJournalFileName(journal->name), file);
+   journal->size = file.offset;
+}
+
+//NOTE: rewrites the whole .ncap from the project & empties the journal
+bool CompactAutoProjectJournal(AutoProjectJournal *journal) {
+   buffer file = EncodeAutoProject(journal->project);
+   if(!ReplaceEntireFile(Concat(journal->name, Literal(".ncap")), file))
+      return false;
+
+   StartAutoProjectJournal(journal, journal->name, file);
+   return true;
+}
+
+void AppendAutoProjectJournal(AutoProjectJournal *journal, AutonomousProgramJournal_RecordType::type type, void *item) {
+   if(journal->skipping_records)
+      return;
+
+   //NOTE: anything the address cant reach goes into the .ncap instead (see FitsAutoProjectJournalAddress)
+   //      same for replayed journals from older versions, the new records wouldnt match their header.
+   //      the compact waits for UpdateAutoProjectJournal, RemovePath gets here before the path is actually removed
+   if(!FitsAutoProjectJournalAddress(type, item) || 
+      (journal->version != AUTONOMOUS_PROGRAM_JOURNAL_CURR_VERSION)) 
+   {
+      journal->needs_compact = true;
+      journal->skipping_records = true;
+      return;
+   }
+
+   buffer sizer = {};
+   WriteAutoProjectJournalRecord(&sizer, type, item);
+
+   buffer record = PushTempBuffer(sizer.offset);
+   WriteAutoProjectJournalRecord(&record, type, item);
+   WriteFileAppend(AutoProjectJournalFileName(journal->name), record);
+   journal->size += record.offset;
+}
+
+void FlushAutoProjectJournal(AutoProjectJournal *journal) {
+   for(u32 i = 0; i < journal->watch_count; i++) {
+      AutoProjectJournalWatch *watch = journal->watches + i;
+      if(watch->dirty) {
+         watch->dirty = false;
+         AppendAutoProjectJournal(journal, watch->type, watch->item);
+      }
+   }
+}
+
+u32 HashAutoProjectJournalBody(AutonomousProgramJournal_RecordType::type type, void *item) {
+   buffer sizer = {};
+   WriteAutoProjectJournalBody(&sizer, type, item);
+
+   buffer body = PushTempBuffer(sizer.offset);
+   WriteAutoProjectJournalBody(&body, type, item);
+   return Hash(String((char *) body.data, body.offset));
+}
+
+void WatchAutoProjectItem(AutoProjectJournal *journal, AutonomousProgramJournal_RecordType::type type, void *item) {
+   if(!IsOpen(journal))
+      return;
+   
+   u32 hash = HashAutoProjectJournalBody(type, item);
+   for(u32 i = 0; i < journal->watch_count; i++) {
+      AutoProjectJournalWatch *watch = journal->watches + i;
+      if(watch->item == item) {
+         if(watch->hash != hash) {
+            watch->hash = hash;
+            watch->dirty = true;
+            journal->changed = true;
+         }
+         return;
+      }
+   }
+
+   AutoProjectJournalWatch *watch = NULL;
+   if(journal->watch_count < ArraySize(journal->watches)) {
+      watch = journal->watches + journal->watch_count++;
+   } else {
+      //NOTE: replace one that's already been written, if they're all waiting to be written write them now
+      for(u32 i = 0; (i < ArraySize(journal->watches)) && (watch == NULL); i++) {
+         AutoProjectJournalWatch *curr = journal->watches + ((journal->next_evicted + i) % ArraySize(journal->watches));
+         if(!curr->dirty)
+            watch = curr;
+      }
+
+      if(watch == NULL) {
+         FlushAutoProjectJournal(journal);
+         watch = journal->watches + (journal->next_evicted % ArraySize(journal->watches));
+      }
+      journal->next_evicted = (u32)(watch - journal->watches) + 1;
+   }
+
+   //NOTE: we dont know what it looked like before this frame so it counts as changed
+   watch->type = type;
+   watch->item = item;
+   watch->hash = hash;
+   watch->dirty = true;
+   journal->changed = true;
+}
+
+//NOTE: call these every frame for anything that could have been edited
+void WatchAutoNode(AutoProjectJournal *journal, AutoNode *node) {
+   WatchAutoProjectItem(journal, AutonomousProgramJournal_RecordType::Node, node);
+}
+
+void WatchAutoPath(AutoProjectJournal *journal, AutoPath *path) {
+   WatchAutoProjectItem(journal, AutonomousProgramJournal_RecordType::Path, path);
+}
+
+//NOTE: call after the path has been added to its node
+void JournalAddedPath(AutoProjectJournal *journal, AutoPath *path) {
+   if(IsOpen(journal)) {
+      FlushAutoProjectJournal(journal);
+      AppendAutoProjectJournal(journal, AutonomousProgramJournal_RecordType::AddPath, path);
+   }
+}
+
+//NOTE: call before the path gets removed from its node, the paths after it get new addresses
+void JournalRemovedPath(AutoProjectJournal *journal, AutoPath *path) {
+   if(IsOpen(journal)) {
+      FlushAutoProjectJournal(journal);
+      AppendAutoProjectJournal(journal, AutonomousProgramJournal_RecordType::RemovePath, path);
+      
+      //NOTE: some of the watched items are about to be freed, anything still around gets picked up again next frame
+      journal->watch_count = 0;
+   }
+}
+
+//NOTE: call once a frame after the editing UI, writes the edits that have settled
+void UpdateAutoProjectJournal(AutoProjectJournal *journal) {
+   if(!IsOpen(journal))
+      return;
+
+   if(!journal->changed)
+      FlushAutoProjectJournal(journal);
+   journal->changed = false;
+
+   if(journal->needs_compact || (journal->size > Max(AUTO_PROJECT_JOURNAL_MIN_COMPACT_SIZE, 2 * journal->project_size)))
+      CompactAutoProjectJournal(journal);
+}
+
+//NOTE: record has to have been validated, returns false if it doesnt fit the project
+bool ApplyAutoProjectJournalRecord(AutoProjectLink *project, buffer *file, MemoryArena *arena, u32 version) {
+   AutonomousProgramJournal_Record *record = ConsumeStruct(file, AutonomousProgramJournal_Record);
+   AutonomousProgramJournal_RecordType::type type = (AutonomousProgramJournal_RecordType::type) record->type;
+   u8 *address = ConsumeArray(file, u8, record->address_length);
+   
+   buffer body = {};
+   body.data = ConsumeSize(file, record->size);
+   body.size = record->size;
+
+   u32 node_address_length = record->address_length - (AddressedByPath(type) ? 1 : 0);
+   AutoNode *node = GetAutoNodeAt(project, address, node_address_length);
+   if(node == NULL)
+      return false;
+
+   AutoPath *path = NULL;
+   if(AddressedByPath(type)) {
+      if(address[node_address_length] >= node->path_count)
+         return false;
+
+      path = node->out_paths[address[node_address_length]];
+   }
+
+   switch(type) {
+      case AutonomousProgramJournal_RecordType::Node: {
+         AutoNode parsed = {};
+         ParseAutoNodeData(&body, &parsed, __temp_arena, version);
+         node->pos = parsed.pos;
+         node->command_count = parsed.command_count;
+         node->commands = PushArray(arena, AutoCommand *, parsed.command_count);
+         for(u32 i = 0; i < parsed.command_count; i++) {
+            node->commands[i] = CopyAutoCommand(parsed.commands[i], arena);
+         }
+         MarkPivotsDirty(node);
+
+         if(node->in_path != NULL)
+            RecalculateAutoPath(node->in_path);
+
+         for(u32 i = 0; i < node->path_count; i++) {
+            RecalculateAutoPath(node->out_paths[i]);
+         }
+      } break;
+
+      case AutonomousProgramJournal_RecordType::Path: {
+         AutoPath parsed = {};
+         ParseAutoPathData(&body, &parsed, __temp_arena, version);
+
+         //NOTE: hidden isnt saved so it stays the way it was
+         parsed.hidden = path->hidden;
+         CopyAutoPathData(path, &parsed, arena);
+         RecalculateAutoPath(path);
+      } break;
+
+      case AutonomousProgramJournal_RecordType::AddPath: {
+         AutoPath *new_path = CopyAutoPath(ParseAutoPath(&body, __temp_arena, version), arena);
+         new_path->in_node = node;
+         RecalculateAutoPath(new_path);
+
+         AutoPath **new_out_paths = PushArray(arena, AutoPath *, node->path_count + 1);
+         Copy(node->out_paths, node->path_count * sizeof(AutoPath *), new_out_paths);
+         new_out_paths[node->path_count] = new_path;
+         node->out_paths = new_out_paths;
+         node->path_count++;
+      } break;
+
+      case AutonomousProgramJournal_RecordType::RemovePath: {
+         u32 remove_index = address[node_address_length];
+         AutoPath **new_out_paths = PushArray(arena, AutoPath *, node->path_count - 1);
+         Copy(node->out_paths, remove_index * sizeof(AutoPath *), new_out_paths);
+         Copy(node->out_paths + (remove_index + 1), (node->path_count - remove_index - 1) * sizeof(AutoPath *), 
+              new_out_paths + remove_index);
+         node->out_paths = new_out_paths;
+         node->path_count--;
+         FreeAutoPath(path);
+      } break;
+   }
+
+   return true;
+}
+
+//NOTE: project is the editable copy of project_file, if name.ncaj was written on top of project_file 
+//      (eg. the editor crashed with unsaved edits) its records get replayed onto project & folded into the .ncap
+void OpenAutoProjectJournal(AutoProjectJournal *journal, AutoProjectLink *project, buffer project_file, MemoryArena *arena) {
+   journal->project = project;
+
+   u32 replayed_count = 0;
+   u64 replayed_size = 0;
+   u32 version = 0;
+   buffer file = ReadEntireFile(AutoProjectJournalFileName(project->name));
+   FileHeader *file_numbers = ValidateStruct(&file, FileHeader);
+   
+   //NOTE: journal versions match the .ncap versions, so any version we can read a .ncap of we can replay
+   if((file_numbers != NULL) && (file_numbers->magic_number == AUTONOMOUS_PROGRAM_JOURNAL_MAGIC_NUMBER) &&
+      ValidateAutoProjectVersion(file_numbers->version_number)) 
+   {
+      version = file_numbers->version_number;
+      AutonomousProgramJournal_FileHeader *header = ValidateStruct(&file, AutonomousProgramJournal_FileHeader);
+      if((header != NULL) && (header->project_size == project_file.size) &&
+         (header->project_hash == Hash(String((char *) project_file.data, project_file.size))))
+      {
+         //NOTE: stops at the first record that got cut off, that's where the editor crashed
+         while(file.offset < file.size) {
+            buffer record = file;
+            if(!ValidateAutoProjectJournalRecord(&file, version) || 
+               !ApplyAutoProjectJournalRecord(project, &record, arena, version))
+            {
+               break;
+            }
+
+            replayed_count++;
+            replayed_size = file.offset;
+         }
+      }
+   }
+
+   if(replayed_count > 0) {
+      //NOTE: project_file is usually still mapped so the .ncap can't be replaced yet, 
+      //      keep the records that replayed (dropping anything cut off) & compact on the next update
+      Reset(journal->arena);
+      journal->name = PushCopy(journal->arena, project->name);
+      journal->project_size = project_file.size;
+      journal->version = version;
+      journal->skipping_records = false;
+      journal->changed = false;
+      journal->watch_count = 0;
+
+      file.offset = replayed_size;
+      ReplaceEntireFile(AutoProjectJournalFileName(journal->name), file);
+      journal->size = replayed_size;
+      journal->needs_compact = true;
+   } else {
+      StartAutoProjectJournal(journal, project->name, project_file);
+   }
+}
+
+//NOTE: writes project->name.ncap & moves the journal there, if the project got renamed 
+//      the old journal's edits are in the new file now so the old journal goes
+bool SaveAutoProject(AutoProjectJournal *journal, AutoProjectLink *project) {
+   buffer file = EncodeAutoProject(project);
+   if(!ReplaceEntireFile(Concat(project->name, Literal(".ncap")), file))
+      return false;
+
+   if(IsOpen(journal) && (journal->name != project->name))
+      RemoveFile(AutoProjectJournalFileName(journal->name));
+
+   journal->project = project;
+   StartAutoProjectJournal(journal, project->name, file);
+   return true;
+}
+
+//NOTE: folds the journal into the .ncap, call this before the project gets freed
+void CloseAutoProjectJournal(AutoProjectJournal *journal) {
+   if(IsOpen(journal)) {
+      if(CompactAutoProjectJournal(journal))
+         RemoveFile(AutoProjectJournalFileName(journal->name));
+      
+      journal->name = EMPTY_STRING;
+      journal->project = NULL;
+   }
+}
+//PROJECT-JOURNAL-------------------------------------------
+
+//NETWORKING------------------------------------------------
+buffer MakeSetStatePacket(v2 pos, f32 angle) {
+   buffer packet = PushTempBuffer(Kilobyte(5));
+
+   PacketHeader p_header = { sizeof(SetState_PacketHeader), (u8)PacketType::SetState };
+   WriteStruct(&packet, &p_header);
+   
+   SetState_PacketHeader header = {};
+   header.pos = pos;
+   header.angle = angle;
+   WriteStruct(&packet, &header);
+   
+   return packet;
+}
+
+//NOTE: the biggest count anywhere in the node & everything after it
+u32 GetAutoPathlikeMaxCount(AutoPathlikeData *data) {
+   u32 result = Max(data->velocity.datapoint_count, Max(data->continuous_event_count, data->discrete_event_count));
+   for(u32 i = 0; i < data->continuous_event_count; i++)
+      result = Max(result, data->continuous_events[i].sample_count);
+   for(u32 i = 0; i < data->discrete_event_count; i++)
+      result = Max(result, data->discrete_events[i].param_count);
+   return result;
+}
+
+u32 GetAutoNodeMaxCount(AutoNode *node) {
+   u32 result = Max(node->command_count, node->path_count);
+   for(u32 i = 0; i < node->command_count; i++) {
+      AutoCommand *command = node->commands[i];
+      if(command->type == North_CommandType::Generic) {
+         result = Max(result, command->generic.param_count);
+      } else if(command->type == North_CommandType::Pivot) {
+         result = Max(result, GetAutoPathlikeMaxCount(&command->pivot.data));
+      }
+   }
+
+   for(u32 i = 0; i < node->path_count; i++) {
+      AutoPath *path = node->out_paths[i];
+      result = Max(result, Max(path->control_point_count, GetAutoPathlikeMaxCount(&path->data)));
+      result = Max(result, GetAutoNodeMaxCount(path->out_node));
+   }
+   return result;
+}
+
+//NOTE: version 0 has u8 counts
+bool FitsAutoProjectV0(AutoProjectLink *project) {
+   return GetAutoNodeMaxCount(project->starting_node) <= 0xFF;
+}
+
+bool CanUploadAutoProject(AutoProjectLink *project, RobotProfile *bot) {
+   return (bot->flags & Welcome_Flags::ACCEPTS_UPLOAD_AUTONOMOUS_V1) || FitsAutoProjectV0(project);
+}
+
+//NOTE: robots that take UploadAutonomous_V1 get the smaller version 1 layout with quantized control points,
+//      the rest get version 0. returns an empty buffer if the project doesnt fit in version 0 (see CanUploadAutoProject)
+buffer MakeUploadAutonomousPacket(AutoProjectLink *project, RobotProfile *bot) {
+   PacketType::type type = PacketType::UploadAutonomous_V1;
+   AutoProjectEncoding encoding = AutoProjectFileEncoding(true);
+   if(!(bot->flags & Welcome_Flags::ACCEPTS_UPLOAD_AUTONOMOUS_V1)) {
+      if(!FitsAutoProjectV0(project))
+         return Buffer(0, NULL);
+
+      type = PacketType::UploadAutonomous;
+      encoding.version = AUTONOMOUS_PROGRAM_V0_VERSION;
+      encoding.quantize_control_points = false;
+   }
+
+   buffer sizer = {};
+   WriteAutoNode(&sizer, project->starting_node, encoding);
 
-   //Write packet
-   buffer packet = PushTempBuffer(Megabyte(5));   
-   u32 size = sizeof(UploadAutonomous_PacketHeader) + data.offset;
-   PacketHeader p_header = { size, (u8)PacketType::UploadAutonomous };
+   //Write packet, UploadAutonomous_V1_PacketHeader is the same as UploadAutonomous_PacketHeader
+   u32 size = sizeof(UploadAutonomous_PacketHeader) + sizer.offset;
+   buffer packet = PushTempBuffer(sizeof(PacketHeader) + size);
+   PacketHeader p_header = { size, (u8)type };
    WriteStruct(&packet, &p_header);
    
    UploadAutonomous_PacketHeader header = {};
    header.starting_angle = project->starting_angle;
    WriteStruct(&packet, &header);
 
-   WriteSize(&packet, data.data, data.offset);
+   WriteAutoNode(&packet, project->starting_node, encoding);
    return packet;
 }
 //NETWORKING------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,721 @@
+//NOTE: the robot link, one nonblocking TCP connection to the robot on NORTH_PORT
+//      the platform layer below just wraps the socket & a readiness poll (epoll on linux, WSAEventSelect on winsock)
+//      that another thread can wake up, everything after it is shared so the editor's network path runs 
+//      (& can be tested) on both
+#define NORTH_PORT 5800
+
+namespace NetworkEvent_Flags {
+   enum type {
+      READABLE = (1 << 0),
+      WRITABLE = (1 << 1), //NOTE: while connecting this means the connect finished (check NetworkSocketConnectFinished)
+      CLOSED = (1 << 2), //NOTE: hung up, errored or the connect failed
+   };
+};
+
+//PLATFORM-SOCKET-------------------------------------------
+#if defined(_WIN32)
+   //NOTE: needs ws2_32.lib, winsock comes in with "windows.h"
+   struct NetworkSocket {
+      SOCKET handle; //NOTE: INVALID_SOCKET if closed
+      WSAEVENT event; //NOTE: WSAEventSelect signals this for handle's network events
+      HANDLE wake; //NOTE: auto reset, NetworkSocketWake signals it
+   };
+
+   void InitNetworking() {
+      WSADATA winsock_data = {};
+      WSAStartup(MAKEWORD(2, 2), &winsock_data);
+   }
+
+   void InitNetworkSocket(NetworkSocket *s) {
+      s->handle = INVALID_SOCKET;
+      s->event = WSACreateEvent();
+      s->wake = CreateEventA(NULL, FALSE, FALSE, NULL);
+      Assert((s->event != WSA_INVALID_EVENT) && (s->wake != NULL));
+   }
+
+   bool IsOpen(NetworkSocket *s) {
+      return s->handle != INVALID_SOCKET;
+   }
+
+   void NetworkSocketClose(NetworkSocket *s) {
+      if(IsOpen(s)) {
+         closesocket(s->handle);
+         s->handle = INVALID_SOCKET;
+         WSAResetEvent(s->event);
+      }
+   }
+
+   //NOTE: thread safe, makes the NetworkSocketPoll that's waiting (or the next one) return right away
+   void NetworkSocketWake(NetworkSocket *s) {
+      SetEvent(s->wake);
+   }
+
+   //NOTE: starts a nonblocking connect, it finishes (or fails) in a later NetworkSocketPoll
+   bool NetworkSocketConnect(NetworkSocket *s, u32 ip, u16 port) {
+      s->handle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+      if(s->handle == INVALID_SOCKET)
+         return false;
+
+      //NOTE: this makes the socket nonblocking too
+      if(WSAEventSelect(s->handle, s->event, FD_READ | FD_WRITE | FD_CONNECT | FD_CLOSE) != 0) {
+         NetworkSocketClose(s);
+         return false;
+      }
+
+      BOOL no_delay = TRUE;
+      setsockopt(s->handle, IPPROTO_TCP, TCP_NODELAY, (char *) &no_delay, sizeof(no_delay));
+
+      struct sockaddr_in server_addr = {};
+      server_addr.sin_family = AF_INET;
+      server_addr.sin_addr.s_addr = ip;
+      server_addr.sin_port = htons(port);
+      if((connect(s->handle, (SOCKADDR *) &server_addr, sizeof(server_addr)) != 0) &&
+         (WSAGetLastError() != WSAEWOULDBLOCK))
+      {
+         NetworkSocketClose(s);
+         return false;
+      }
+
+      return true;
+   }
+
+   bool NetworkSocketConnectFinished(NetworkSocket *s) {
+      int error = 0;
+      int error_size = sizeof(error);
+      return (getsockopt(s->handle, SOL_SOCKET, SO_ERROR, (char *) &error, &error_size) == 0) && (error == 0);
+   }
+
+   //NOTE: returns NetworkEvent_Flags, timeout_ms of 0 just checks & -1 waits until something happens (or a wake)
+   //      if the socket is closed it just waits out the timeout
+   //      unlike epoll the events are edge triggered, FD_READ only comes back after a recv that left data behind 
+   //      & FD_WRITE after a send that would have blocked, which is all the connection needs. so wants_write
+   //      doesnt change anything here, FD_WRITE only shows up when there's a backlog anyway
+   u32 NetworkSocketPoll(NetworkSocket *s, bool wants_write, s32 timeout_ms) {
+      WSAEVENT events[2] = { s->wake, s->event };
+      DWORD event_count = IsOpen(s) ? 2 : 1;
+      DWORD wait = WSAWaitForMultipleEvents(event_count, events, FALSE, (timeout_ms < 0) ? WSA_INFINITE : (DWORD) timeout_ms, FALSE);
+      
+      //NOTE: if the wake & the socket both went off, the socket's events are still there next poll
+      if(!IsOpen(s) || (wait != (WSA_WAIT_EVENT_0 + 1)))
+         return 0;
+
+      WSANETWORKEVENTS network_events = {};
+      if(WSAEnumNetworkEvents(s->handle, s->event, &network_events) != 0)
+         return NetworkEvent_Flags::CLOSED;
+
+      u32 result = 0;
+      if(network_events.lNetworkEvents & FD_READ)
+         result |= NetworkEvent_Flags::READABLE;
+      if(network_events.lNetworkEvents & FD_WRITE)
+         result |= NetworkEvent_Flags::WRITABLE;
+      if(network_events.lNetworkEvents & FD_CONNECT) {
+         //NOTE: a failed connect only shows up here
+         result |= (network_events.iErrorCode[FD_CONNECT_BIT] == 0) ? NetworkEvent_Flags::WRITABLE : NetworkEvent_Flags::CLOSED;
+      }
+      if(network_events.lNetworkEvents & FD_CLOSE)
+         result |= NetworkEvent_Flags::CLOSED;
+      return result;
+   }
+
+   //NOTE: these return how many bytes went through, 0 if it would block & -1 if the connection is gone
+   s32 NetworkSocketRecv(NetworkSocket *s, void *data, u32 size, bool peek) {
+      int result = recv(s->handle, (char *) data, size, peek ? MSG_PEEK : 0);
+      if(result == SOCKET_ERROR)
+         return (WSAGetLastError() == WSAEWOULDBLOCK) ? 0 : -1;
+      return (result == 0) ? -1 : result;
+   }
+
+   s32 NetworkSocketSend(NetworkSocket *s, void *data, u32 size) {
+      int result = send(s->handle, (char *) data, size, 0);
+      if(result == SOCKET_ERROR)
+         return (WSAGetLastError() == WSAEWOULDBLOCK) ? 0 : -1;
+      return result;
+   }
+#elif defined(__linux__)
+   #include <errno.h>
+   #include <sys/socket.h>
+   #include <sys/epoll.h>
+   #include <sys/eventfd.h>
+   #include <netinet/in.h>
+   #include <netinet/tcp.h>
+   #include <arpa/inet.h>
+
+   struct NetworkSocket {
+      int handle; //NOTE: -1 if closed
+      int epoll;
+      int wake; //NOTE: eventfd, always in the epoll set, NetworkSocketWake writes to it
+      u32 registered; //NOTE: the epoll events handle is registered for, so they only get changed when they need to
+   };
+
+   void InitNetworking() {
+   }
+
+   void InitNetworkSocket(NetworkSocket *s) {
+      s->handle = -1;
+      s->epoll = epoll_create1(EPOLL_CLOEXEC);
+      s->wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      Assert((s->epoll >= 0) && (s->wake >= 0));
+
+      struct epoll_event event = {};
+      event.events = EPOLLIN;
+      event.data.fd = s->wake;
+      epoll_ctl(s->epoll, EPOLL_CTL_ADD, s->wake, &event);
+   }
+
+   bool IsOpen(NetworkSocket *s) {
+      return s->handle >= 0;
+   }
+
+   //NOTE: closing takes it out of the epoll set too
+   void NetworkSocketClose(NetworkSocket *s) {
+      if(IsOpen(s)) {
+         close(s->handle);
+         s->handle = -1;
+         s->registered = 0;
+      }
+   }
+
+   //NOTE: thread safe, makes the NetworkSocketPoll that's waiting (or the next one) return right away
+   void NetworkSocketWake(NetworkSocket *s) {
+      u64 one = 1;
+      ssize_t written = write(s->wake, &one, sizeof(one));
+      (void) written; //NOTE: only fails if the counter is about to overflow, then its already awake
+   }
+
+   //NOTE: starts a nonblocking connect, it finishes (or fails) in a later NetworkSocketPoll
+   bool NetworkSocketConnect(NetworkSocket *s, u32 ip, u16 port) {
+      s->handle = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+      if(s->handle < 0)
+         return false;
+
+      int no_delay = 1;
+      setsockopt(s->handle, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+      struct sockaddr_in server_addr = {};
+      server_addr.sin_family = AF_INET;
+      server_addr.sin_addr.s_addr = ip;
+      server_addr.sin_port = htons(port);
+      if((connect(s->handle, (struct sockaddr *) &server_addr, sizeof(server_addr)) != 0) && (errno != EINPROGRESS)) {
+         NetworkSocketClose(s);
+         return false;
+      }
+
+      struct epoll_event event = {};
+      event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP;
+      event.data.fd = s->handle;
+      if(epoll_ctl(s->epoll, EPOLL_CTL_ADD, s->handle, &event) != 0) {
+         NetworkSocketClose(s);
+         return false;
+      }
+      s->registered = event.events;
+      return true;
+   }
+
+   bool NetworkSocketConnectFinished(NetworkSocket *s) {
+      int error = 0;
+      socklen_t error_size = sizeof(error);
+      return (getsockopt(s->handle, SOL_SOCKET, SO_ERROR, &error, &error_size) == 0) && (error == 0);
+   }
+
+   //NOTE: returns NetworkEvent_Flags, timeout_ms of 0 just checks & -1 waits until something happens (or a wake)
+   //      if the socket is closed it just waits out the timeout (only the wake is in the epoll set)
+   //      level triggered, so anything left unread gets reported again next time
+   u32 NetworkSocketPoll(NetworkSocket *s, bool wants_write, s32 timeout_ms) {
+      //NOTE: only ask for EPOLLOUT when there's something to write, otherwise every poll would wake up for it
+      u32 wanted = EPOLLIN | EPOLLRDHUP | (wants_write ? EPOLLOUT : 0);
+      if(IsOpen(s) && (wanted != s->registered)) {
+         struct epoll_event event = {};
+         event.events = wanted;
+         event.data.fd = s->handle;
+         epoll_ctl(s->epoll, EPOLL_CTL_MOD, s->handle, &event);
+         s->registered = wanted;
+      }
+
+      struct epoll_event events[2] = {};
+      s32 event_count = epoll_wait(s->epoll, events, ArraySize(events), timeout_ms);
+
+      u32 result = 0;
+      for(s32 i = 0; i < event_count; i++) {
+         struct epoll_event *event = events + i;
+         if(event->data.fd == s->wake) {
+            u64 wake_count = 0;
+            ssize_t wake_read = read(s->wake, &wake_count, sizeof(wake_count));
+            (void) wake_read; //NOTE: just resets the counter
+            continue;
+         }
+
+         if(event->events & EPOLLIN)
+            result |= NetworkEvent_Flags::READABLE;
+         if(event->events & EPOLLOUT)
+            result |= NetworkEvent_Flags::WRITABLE;
+         if(event->events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP))
+            result |= NetworkEvent_Flags::CLOSED;
+      }
+      return result;
+   }
+
+   //NOTE: these return how many bytes went through, 0 if it would block & -1 if the connection is gone
+   s32 NetworkSocketRecv(NetworkSocket *s, void *data, u32 size, bool peek) {
+      ssize_t result = recv(s->handle, data, size, peek ? MSG_PEEK : 0);
+      if(result < 0)
+         return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) ? 0 : -1;
+      return (result == 0) ? -1 : (s32) result;
+   }
+
+   s32 NetworkSocketSend(NetworkSocket *s, void *data, u32 size) {
+      ssize_t result = send(s->handle, data, size, MSG_NOSIGNAL);
+      if(result < 0)
+         return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) ? 0 : -1;
+      return (s32) result;
+   }
+#else
+   #error "we dont support that platform yet"
+#endif
+//PLATFORM-SOCKET-------------------------------------------
+
+//RING------------------------------------------------------
+//NOTE: read & write only ever go up, they get wrapped with (size - 1) when they index data
+//      between 2 threads it's single producer/single consumer, the producer only ever writes `write` &
+//      the consumer only ever writes `read`, so the barriers are all it needs
+struct NetworkRing {
+   u8 *data;
+   u32 size; //NOTE: has to be a power of 2
+   volatile u64 read;
+   volatile u64 write;
+};
+
+void InitNetworkRing(NetworkRing *ring, u32 size) {
+   Assert((size & (size - 1)) == 0);
+   ring->data = PlatformAllocMemory(size);
+   ring->size = size;
+   ring->read = 0;
+   ring->write = 0;
+}
+
+//NOTE: everything before `write` is safe to read once this returns
+u32 RingUsedSize(NetworkRing *ring) {
+   u32 used = (u32)(ring->write - ring->read);
+   READ_BARRIER;
+   return used;
+}
+
+//NOTE: the 2 pieces of the ring from pos, the second one is empty unless it wraps
+void RingCopy(NetworkRing *ring, u64 pos, u32 size, void *dest) {
+   u32 start = (u32)(pos & (ring->size - 1));
+   u32 first_size = Min(size, ring->size - start);
+   Copy(ring->data + start, first_size, dest);
+   Copy(ring->data, size - first_size, (u8 *) dest + first_size);
+}
+
+void RingWrite(NetworkRing *ring, u64 pos, void *src, u32 size) {
+   u32 start = (u32)(pos & (ring->size - 1));
+   u32 first_size = Min(size, ring->size - start);
+   Copy(src, first_size, ring->data + start);
+   Copy((u8 *) src + first_size, size - first_size, ring->data);
+}
+
+//NOTE: points straight into the ring unless it wraps, then it gets copied into temp memory
+buffer RingView(NetworkRing *ring, u64 pos, u32 size) {
+   u32 start = (u32)(pos & (ring->size - 1));
+   if((start + size) <= ring->size)
+      return Buffer(size, ring->data + start);
+
+   buffer result = PushTempBuffer(size);
+   RingCopy(ring, pos, size, result.data);
+   return result;
+}
+
+//NOTE: producer side, header & data go in back to back & show up to the consumer together
+//      returns false (without writing anything) if there isnt room
+bool RingPush(NetworkRing *ring, void *header, u32 header_size, void *data, u32 size) {
+   u64 write = ring->write;
+   if((ring->size - RingUsedSize(ring)) < (header_size + size))
+      return false;
+
+   RingWrite(ring, write, header, header_size);
+   RingWrite(ring, write + header_size, data, size);
+   WRITE_BARRIER;
+   ring->write = write + header_size + size;
+   return true;
+}
+
+//NOTE: consumer side, anything read out of the ring has to be done with before it gets popped
+void RingPop(NetworkRing *ring, u32 size) {
+   WRITE_BARRIER;
+   ring->read = ring->read + size;
+}
+//RING------------------------------------------------------
+
+//CONNECTION------------------------------------------------
+//NOTE: the connection only makes syscalls when something happens, a connect attempt every
+//      NETWORK_RECONNECT_INTERVAL, a heartbeat every NETWORK_HEARTBEAT_INTERVAL & one poll per HandleConnectionStatus
+#define NETWORK_RECONNECT_INTERVAL 1.0f
+#define NETWORK_CONNECT_TIMEOUT 1.0f
+#define NETWORK_HEARTBEAT_INTERVAL 0.5f
+#define NETWORK_RECV_TIMEOUT 2.0f
+#define NETWORK_SEND_QUEUE_SIZE Megabyte(1)
+#define NETWORK_RECV_RING_SIZE Megabyte(1)
+#define NETWORK_MAX_PACKET_SIZE (NETWORK_RECV_RING_SIZE - sizeof(PacketHeader)) //NOTE: a whole packet has to fit in the ring
+
+namespace NetworkConnectionState {
+   enum type {
+      Disconnected,
+      Connecting,
+      Connected,
+   };
+};
+
+struct NetworkConnection {
+   NetworkConnectionState::type state;
+   NetworkSocket socket;
+   u32 target_ip;
+
+   f32 state_time; //NOTE: when state last changed
+   f32 last_recv_time;
+   f32 last_heartbeat_time;
+   u32 events; //NOTE: NetworkEvent_Flags from the last poll
+
+   //NOTE: whatever the socket couldnt take yet, it gets sent once the socket is writable again
+   buffer send_queue;
+   //NOTE: the socket gets drained into here & packets get framed in place
+   NetworkRing recv_ring;
+};
+
+void InitNetworkConnection(NetworkConnection *conn) {
+   InitNetworkSocket(&conn->socket);
+   conn->state = NetworkConnectionState::Disconnected;
+   conn->state_time = -NETWORK_RECONNECT_INTERVAL;
+   conn->send_queue = Buffer(NETWORK_SEND_QUEUE_SIZE, PlatformAllocMemory(NETWORK_SEND_QUEUE_SIZE));
+   InitNetworkRing(&conn->recv_ring, NETWORK_RECV_RING_SIZE);
+}
+
+bool IsConnected(NetworkConnection *conn) {
+   return conn->state == NetworkConnectionState::Connected;
+}
+
+void CloseNetworkConnection(NetworkConnection *conn, f32 curr_time) {
+   NetworkSocketClose(&conn->socket);
+   conn->state = NetworkConnectionState::Disconnected;
+   conn->state_time = curr_time;
+   conn->events = 0;
+   conn->send_queue.offset = 0;
+   conn->recv_ring.read = 0;
+   conn->recv_ring.write = 0;
+}
+
+void FlushSendQueue(NetworkConnection *conn) {
+   while(conn->send_queue.offset > 0) {
+      s32 sent = NetworkSocketSend(&conn->socket, conn->send_queue.data, conn->send_queue.offset);
+      if(sent <= 0) {
+         if(sent < 0)
+            conn->events |= NetworkEvent_Flags::CLOSED;
+         return;
+      }
+
+      Advance(&conn->send_queue, sent);
+   }
+}
+
+//NOTE: packets only get sent while connected, anything sent before that gets dropped
+void QueuePacket(NetworkConnection *conn, buffer packet) {
+   if(!IsConnected(conn))
+      return;
+
+   if((conn->send_queue.size - conn->send_queue.offset) < packet.offset) {
+      OutputDebugStringA("Send queue full, dropping packet\n");
+      return;
+   }
+
+   //NOTE: if there's a backlog the socket isnt writable, the next poll picks it up
+   bool was_empty = (conn->send_queue.offset == 0);
+   WriteSize(&conn->send_queue, packet.data, packet.offset);
+   if(was_empty)
+      FlushSendQueue(conn);
+}
+
+//NOTE: how long HandleConnectionStatus can wait before the next reconnect, connect timeout, heartbeat or receive timeout,
+//      rounded up (& then some) so we dont wake up just before it & spin until it actually passes
+s32 NetworkConnectionWaitMs(NetworkConnection *conn, f32 curr_time) {
+   f32 deadline = 0;
+   switch(conn->state) {
+      case NetworkConnectionState::Disconnected: {
+         deadline = conn->state_time + NETWORK_RECONNECT_INTERVAL;
+      } break;
+
+      case NetworkConnectionState::Connecting: {
+         deadline = conn->state_time + NETWORK_CONNECT_TIMEOUT;
+      } break;
+
+      case NetworkConnectionState::Connected: {
+         deadline = Min(conn->last_heartbeat_time + NETWORK_HEARTBEAT_INTERVAL, conn->last_recv_time + NETWORK_RECV_TIMEOUT);
+      } break;
+   }
+
+   f32 wait = deadline - curr_time;
+   return (wait > 0) ? ((s32) ceilf(wait * 1000.0f) + 1) : 0;
+}
+
+//NOTE: call before HasPackets, waits up to wait_ms (-1 for no limit) for the socket or a NetworkSocketWake
+//      returns true if we were connected & just got disconnected
+bool HandleConnectionStatus(NetworkConnection *conn, u32 target_ip, f32 curr_time, s32 wait_ms) {
+   bool disconnected = false;
+   if((target_ip != conn->target_ip) && (conn->state != NetworkConnectionState::Disconnected)) {
+      disconnected = IsConnected(conn);
+      CloseNetworkConnection(conn, curr_time - NETWORK_RECONNECT_INTERVAL);
+   }
+   conn->target_ip = target_ip;
+
+   switch(conn->state) {
+      case NetworkConnectionState::Disconnected: {
+         if((curr_time - conn->state_time) >= NETWORK_RECONNECT_INTERVAL) {
+            conn->state_time = curr_time;
+            if(NetworkSocketConnect(&conn->socket, target_ip, NORTH_PORT))
+               conn->state = NetworkConnectionState::Connecting;
+         } else {
+            NetworkSocketPoll(&conn->socket, false, wait_ms);
+         }
+      } break;
+
+      case NetworkConnectionState::Connecting: {
+         conn->events = NetworkSocketPoll(&conn->socket, true, wait_ms);
+         if(conn->events & NetworkEvent_Flags::CLOSED) {
+            CloseNetworkConnection(conn, curr_time);
+         } else if(conn->events & NetworkEvent_Flags::WRITABLE) {
+            if(NetworkSocketConnectFinished(&conn->socket)) {
+               conn->state = NetworkConnectionState::Connected;
+               conn->state_time = curr_time;
+               conn->last_recv_time = curr_time;
+               conn->last_heartbeat_time = curr_time;
+            } else {
+               CloseNetworkConnection(conn, curr_time);
+            }
+         } else if((curr_time - conn->state_time) > NETWORK_CONNECT_TIMEOUT) {
+            CloseNetworkConnection(conn, curr_time);
+         }
+      } break;
+
+      case NetworkConnectionState::Connected: {
+         //NOTE: HasPackets sets CLOSED if the last reads found the connection gone
+         u32 closed = conn->events & NetworkEvent_Flags::CLOSED;
+         conn->events = closed | NetworkSocketPoll(&conn->socket, conn->send_queue.offset > 0, closed ? 0 : wait_ms);
+         if(conn->events & NetworkEvent_Flags::WRITABLE)
+            FlushSendQueue(conn);
+
+         if((curr_time - conn->last_heartbeat_time) > NETWORK_HEARTBEAT_INTERVAL) {
+            //NOTE: send to maintain connection
+            PacketHeader heartbeat = {0, PacketType::Heartbeat};
+            QueuePacket(conn, Buffer(sizeof(heartbeat), (u8 *) &heartbeat, sizeof(heartbeat)));
+            conn->last_heartbeat_time = curr_time;
+         }
+
+         //NOTE: anything left to read gets dropped with the connection, there's no one to answer it
+         if((conn->events & NetworkEvent_Flags::CLOSED) || ((curr_time - conn->last_recv_time) > NETWORK_RECV_TIMEOUT)) {
+            OutputDebugStringA(ToCString("Disconnecting, t = " + ToString(curr_time - conn->last_recv_time) + "\n"));
+            CloseNetworkConnection(conn, curr_time);
+            disconnected = true;
+         }
+      } break;
+   }
+
+   return disconnected;
+}
+
+//NOTE: reads as much as the ring has room for, a short read means the socket is empty so we stop there
+//      instead of making another recv just to hear it would block
+void DrainSocket(NetworkConnection *conn, f32 curr_time) {
+   NetworkRing *ring = &conn->recv_ring;
+   while(conn->events & NetworkEvent_Flags::READABLE) {
+      u32 free_size = ring->size - RingUsedSize(ring);
+      if(free_size == 0)
+         return;
+
+      u32 start = (u32)(ring->write & (ring->size - 1));
+      u32 size = Min(free_size, ring->size - start);
+      s32 received = NetworkSocketRecv(&conn->socket, ring->data + start, size, false);
+      if(received < 0) {
+         conn->events &= ~NetworkEvent_Flags::READABLE;
+         conn->events |= NetworkEvent_Flags::CLOSED;
+         return;
+      }
+
+      //NOTE: anything from the robot counts, not just whole packets
+      if(received > 0)
+         conn->last_recv_time = curr_time;
+
+      ring->write += received;
+      if((u32) received < size)
+         conn->events &= ~NetworkEvent_Flags::READABLE;
+   }
+}
+
+//NOTE: packet points straight into the ring (unless it wraps, then it gets copied into temp memory),
+//      so it's only good until the next HasPackets
+bool HasPackets(NetworkConnection *conn, f32 curr_time, PacketHeader *header, buffer *packet) {
+   if(!IsConnected(conn))
+      return false;
+
+   NetworkRing *ring = &conn->recv_ring;
+   if(RingUsedSize(ring) < sizeof(PacketHeader))
+      DrainSocket(conn, curr_time);
+
+   if(RingUsedSize(ring) < sizeof(PacketHeader))
+      return false;
+
+   RingCopy(ring, ring->read, sizeof(PacketHeader), header);
+   if(header->size > NETWORK_MAX_PACKET_SIZE) {
+      //NOTE: either the robot is broken or we lost track of the packets, either way start over
+      OutputDebugStringA(ToCString("Packet too big (" + ToString(header->size) + " bytes), disconnecting\n"));
+      conn->events |= NetworkEvent_Flags::CLOSED;
+      return false;
+   }
+
+   u32 packet_size = sizeof(PacketHeader) + header->size;
+   if(RingUsedSize(ring) < packet_size) {
+      DrainSocket(conn, curr_time);
+      if(RingUsedSize(ring) < packet_size)
+         return false;
+   }
+
+   *packet = RingView(ring, ring->read + sizeof(PacketHeader), header->size);
+   RingPop(ring, packet_size);
+   return true;
+}
+//CONNECTION------------------------------------------------
+
+//NETWORK-THREAD--------------------------------------------
+//NOTE: the network thread owns the connection, so heartbeats, reconnects & the receive timeout run on real time
+//      instead of whenever the UI gets around to a frame, the UI only talks to it through target_ip & the 2 queues
+//      it sleeps until the socket, the next connection deadline or a wake from the UI (a packet to send, a new target or stopping)
+#define NETWORK_THREAD_RETRY_MS 5 //NOTE: while a disconnect is waiting on room in the UI queue, the UI doesnt wake us when it pops
+#define NETWORK_UI_QUEUE_SIZE Megabyte(2)
+#define NETWORK_ROBOT_QUEUE_SIZE Megabyte(1)
+
+namespace NetworkMessageType {
+   enum type {
+      Packet,
+      Disconnected,
+   };
+};
+
+//NOTE: what the network thread hands the UI, followed by size bytes of packet
+struct NetworkMessageHeader {
+   u32 size;
+   u8 type;
+   u8 packet_type; //NOTE: PacketType, only for NetworkMessageType::Packet
+};
+
+struct NetworkThread {
+   NetworkConnection conn; //NOTE: only the network thread touches this
+   MemoryArena *temp_arena;
+   PlatformThread thread;
+
+   volatile u32 running;
+   volatile u32 target_ip;
+   NetworkRing to_ui; //NOTE: NetworkMessageHeader then the packet
+   NetworkRing to_robot; //NOTE: whole packets, PacketHeader included
+   u32 ui_pop_size; //NOTE: the UI's last message, it gets popped once the UI is done with it
+};
+
+void NetworkThreadProc(void *data) {
+   NetworkThread *net = (NetworkThread *) data;
+   NetworkConnection *conn = &net->conn;
+   __temp_arena = net->temp_arena;
+
+   Timer timer = InitTimer();
+   f32 curr_time = 0;
+   //NOTE: the UI has to hear about a disconnect before anything from the next connection,
+   //      if its queue is full that has to wait
+   bool disconnect_pending = false;
+   while(net->running) {
+      Reset(__temp_arena);
+
+      //NOTE: QueuePacket copies it into the send queue, so it can be popped right away
+      while(RingUsedSize(&net->to_robot) >= sizeof(PacketHeader)) {
+         PacketHeader header = {};
+         RingCopy(&net->to_robot, net->to_robot.read, sizeof(header), &header);
+         u32 packet_size = sizeof(PacketHeader) + header.size;
+         buffer packet = RingView(&net->to_robot, net->to_robot.read, packet_size);
+         QueuePacket(conn, Buffer(packet_size, packet.data, packet_size));
+         RingPop(&net->to_robot, packet_size);
+      }
+
+      curr_time += GetDT(&timer);
+      s32 wait_ms = disconnect_pending ? Min(NETWORK_THREAD_RETRY_MS, NetworkConnectionWaitMs(conn, curr_time)) : 
+                                         NetworkConnectionWaitMs(conn, curr_time);
+      if(HandleConnectionStatus(conn, net->target_ip, curr_time, wait_ms))
+         disconnect_pending = true;
+
+      if(disconnect_pending) {
+         NetworkMessageHeader message = {0, NetworkMessageType::Disconnected};
+         disconnect_pending = !RingPush(&net->to_ui, &message, sizeof(message), NULL, 0);
+      }
+
+      PacketHeader header = {};
+      buffer packet = {};
+      while(HasPackets(conn, curr_time, &header, &packet)) {
+         //NOTE: heartbeats only keep the connection alive, the UI doesnt need to see them
+         if(header.type == PacketType::Heartbeat)
+            continue;
+
+         NetworkMessageHeader message = {header.size, NetworkMessageType::Packet, header.type};
+         if(disconnect_pending || !RingPush(&net->to_ui, &message, sizeof(message), packet.data, header.size))
+            OutputDebugStringA("UI queue full, dropping packet\n");
+      }
+   }
+
+   CloseNetworkConnection(conn, curr_time);
+}
+
+//NOTE: call from the main thread, InitNetworking has to be called first
+void StartNetworkThread(NetworkThread *net, char *connection_target) {
+   InitNetworkConnection(&net->conn);
+   InitNetworkRing(&net->to_ui, NETWORK_UI_QUEUE_SIZE);
+   InitNetworkRing(&net->to_robot, NETWORK_ROBOT_QUEUE_SIZE);
+   net->temp_arena = PlatformAllocArena(Megabyte(1), "Network Temp");
+   net->target_ip = inet_addr(connection_target);
+   net->running = true;
+   StartThread(&net->thread, NetworkThreadProc, net);
+}
+
+void StopNetworkThread(NetworkThread *net) {
+   net->running = false;
+   NetworkSocketWake(&net->conn.socket);
+   JoinThread(&net->thread);
+}
+
+void SetNetworkTarget(NetworkThread *net, char *connection_target) {
+   u32 target_ip = inet_addr(connection_target);
+   if(target_ip != net->target_ip) {
+      net->target_ip = target_ip;
+      NetworkSocketWake(&net->conn.socket);
+   }
+}
+
+//NOTE: UI side, packet is only good until the next HasNetworkMessages (same as HasPackets)
+bool HasNetworkMessages(NetworkThread *net, NetworkMessageHeader *message, buffer *packet) {
+   NetworkRing *ring = &net->to_ui;
+   if(net->ui_pop_size > 0) {
+      RingPop(ring, net->ui_pop_size);
+      net->ui_pop_size = 0;
+   }
+
+   if(RingUsedSize(ring) < sizeof(NetworkMessageHeader))
+      return false;
+
+   RingCopy(ring, ring->read, sizeof(NetworkMessageHeader), message);
+   *packet = RingView(ring, ring->read + sizeof(NetworkMessageHeader), message->size);
+   net->ui_pop_size = sizeof(NetworkMessageHeader) + message->size;
+   return true;
+}
+//NETWORK-THREAD--------------------------------------------
+
+//NOTE: the network thread the editor talks to the robot through, SendPacket is called all over the UI
+NetworkThread robot_network = {};
+
+void SendPacket(buffer packet) {
+   if(RingPush(&robot_network.to_robot, packet.data, packet.offset, NULL, 0)) {
+      NetworkSocketWake(&robot_network.conn.socket);
+   } else {
+      OutputDebugStringA("Robot queue full, dropping packet\n");
+   }
+}
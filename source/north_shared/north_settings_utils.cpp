@@ -1,3 +1,193 @@
+//FIELD-IMAGE-----------------------------------------------
+//NOTE: the field image gets loaded at the biggest level that fits in this, & all the levels below it for mipmapping
+#define FIELD_IMAGE_MAX_LOAD_SIZE 2048
+
+//NOTE: out is width * height * 4 bytes, each byte minus the same channel of the texel to its left 
+//      (or above it for the first texel in a row) so flat areas turn into runs of 0s
+void FilterFieldImageTile(u32 *texels, u32 stride, u32 width, u32 height, u8 *out) {
+   for(u32 y = 0; y < height; y++) {
+      u8 *row = (u8 *) (texels + y * stride);
+      u8 *prev_row = (y > 0) ? (u8 *) (texels + (y - 1) * stride) : NULL;
+      u8 *out_row = out + y * width * 4;
+
+      for(u32 i = 0; i < 4; i++)
+         out_row[i] = row[i] - ((prev_row != NULL) ? prev_row[i] : 0);
+      
+      for(u32 i = 4; i < width * 4; i++)
+         out_row[i] = row[i] - row[i - 4];
+   }
+}
+
+void UnfilterFieldImageTile(u8 *in, u32 width, u32 height, u32 *texels, u32 stride) {
+   for(u32 y = 0; y < height; y++) {
+      u8 *row = (u8 *) (texels + y * stride);
+      u8 *prev_row = (y > 0) ? (u8 *) (texels + (y - 1) * stride) : NULL;
+      u8 *in_row = in + y * width * 4;
+
+      for(u32 i = 0; i < 4; i++)
+         row[i] = in_row[i] + ((prev_row != NULL) ? prev_row[i] : 0);
+      
+      for(u32 i = 4; i < width * 4; i++)
+         row[i] = in_row[i] + row[i - 4];
+   }
+}
+
+//NOTE: dest is Max(1, width / 2) x Max(1, height / 2), each texel is the average of the (up to) 2x2 under it
+void DownsampleFieldImage(u32 *src, u32 width, u32 height, u32 *dest) {
+   u32 dest_width = Max(1, width / 2);
+   u32 dest_height = Max(1, height / 2);
+   
+   for(u32 y = 0; y < dest_height; y++) {
+      u32 y0 = 2 * y;
+      u32 y1 = Min(2 * y + 1, height - 1);
+      for(u32 x = 0; x < dest_width; x++) {
+         u32 x0 = 2 * x;
+         u32 x1 = Min(2 * x + 1, width - 1);
+         u8 *a = (u8 *) (src + y0 * width + x0);
+         u8 *b = (u8 *) (src + y0 * width + x1);
+         u8 *c = (u8 *) (src + y1 * width + x0);
+         u8 *d = (u8 *) (src + y1 * width + x1);
+         
+         u8 *out = (u8 *) (dest + y * dest_width + x);
+         for(u32 i = 0; i < 4; i++)
+            out[i] = (u8) ((a[i] + b[i] + c[i] + d[i] + 2) / 4);
+      }
+   }
+}
+
+//NOTE: fills in field_header's image fields, texels is image_width x image_height
+buffer EncodeFieldFile(Field_FileHeader *field_header, u32 *texels) {
+   u32 level_count = FieldImageLevelCount(field_header->image_width, field_header->image_height);
+   field_header->image_level_count = level_count;
+
+   Field_ImageLevel *levels = PushTempArray(Field_ImageLevel, level_count);
+   u32 **level_texels = PushTempArray(u32 *, level_count);
+   u32 **level_tile_ends = PushTempArray(u32 *, level_count);
+   u64 *level_tiles_size = PushTempArray(u64, level_count);
+
+   u64 payload_bound = 0;
+   for(u32 i = 0; i < level_count; i++) {
+      levels[i].width = (i == 0) ? field_header->image_width : Max(1, levels[i - 1].width / 2);
+      levels[i].height = (i == 0) ? field_header->image_height : Max(1, levels[i - 1].height / 2);
+      
+      if(i == 0) {
+         level_texels[i] = texels;
+      } else {
+         level_texels[i] = PushTempArray(u32, levels[i].width * levels[i].height);
+         DownsampleFieldImage(level_texels[i - 1], levels[i - 1].width, levels[i - 1].height, level_texels[i]);
+      }
+
+      u32 tile_count = FieldImageTileCount(levels[i].width, levels[i].height);
+      level_tile_ends[i] = PushTempArray(u32, tile_count);
+      payload_bound += tile_count * LZCompressBound(FIELD_IMAGE_TILE_SIZE * FIELD_IMAGE_TILE_SIZE * 4);
+   }
+
+   u8 *payload = PushTempArray(u8, payload_bound);
+   u8 *filtered = PushTempArray(u8, FIELD_IMAGE_TILE_SIZE * FIELD_IMAGE_TILE_SIZE * 4);
+   u64 payload_size = 0;
+   for(u32 i = 0; i < level_count; i++) {
+      Field_ImageLevel *level = levels + i;
+      u64 level_start = payload_size;
+      u32 tile = 0;
+      
+      for(u32 y = 0; y < level->height; y += FIELD_IMAGE_TILE_SIZE) {
+         for(u32 x = 0; x < level->width; x += FIELD_IMAGE_TILE_SIZE) {
+            u32 tile_width = Min(FIELD_IMAGE_TILE_SIZE, level->width - x);
+            u32 tile_height = Min(FIELD_IMAGE_TILE_SIZE, level->height - y);
+            FilterFieldImageTile(level_texels[i] + y * level->width + x, level->width, 
+                                 tile_width, tile_height, filtered);
+            
+            payload_size += LZCompress(filtered, tile_width * tile_height * 4, payload + payload_size);
+            level_tile_ends[i][tile++] = (u32) (payload_size - level_start);
+         }
+      }
+
+      level_tiles_size[i] = payload_size - level_start;
+   }
+
+   u64 offset = sizeof(FileHeader) + sizeof(Field_FileHeader) + level_count * sizeof(Field_ImageLevel);
+   for(u32 i = 0; i < level_count; i++) {
+      levels[i].offset = (u32) offset;
+      offset += FieldImageTileCount(levels[i].width, levels[i].height) * sizeof(u32) + level_tiles_size[i];
+   }
+
+   buffer file = PushTempBuffer(offset);
+   FileHeader numbers = header(FIELD_MAGIC_NUMBER, FIELD_CURR_VERSION);
+   WriteStruct(&file, &numbers);
+   WriteStruct(&file, field_header);
+   WriteArray(&file, levels, level_count);
+   
+   u8 *level_tiles = payload;
+   for(u32 i = 0; i < level_count; i++) {
+      WriteArray(&file, level_tile_ends[i], FieldImageTileCount(levels[i].width, levels[i].height));
+      WriteSize(&file, level_tiles, level_tiles_size[i]);
+      level_tiles += level_tiles_size[i];
+   }
+
+   return file;
+}
+
+//NOTE: file & level have to have been validated, returns false if a tile is bad
+bool DecodeFieldImageLevel(buffer file, Field_ImageLevel *level, u32 *texels) {
+   u32 tile_count = FieldImageTileCount(level->width, level->height);
+   u32 *tile_ends = (u32 *) (file.data + level->offset);
+   u8 *tiles = (u8 *) (tile_ends + tile_count);
+
+   u8 *filtered = PushTempArray(u8, FIELD_IMAGE_TILE_SIZE * FIELD_IMAGE_TILE_SIZE * 4);
+   u32 tile = 0;
+   for(u32 y = 0; y < level->height; y += FIELD_IMAGE_TILE_SIZE) {
+      for(u32 x = 0; x < level->width; x += FIELD_IMAGE_TILE_SIZE) {
+         u32 tile_width = Min(FIELD_IMAGE_TILE_SIZE, level->width - x);
+         u32 tile_height = Min(FIELD_IMAGE_TILE_SIZE, level->height - y);
+         u32 tile_begin = (tile > 0) ? tile_ends[tile - 1] : 0;
+         
+         if(!LZDecompress(tiles + tile_begin, tile_ends[tile] - tile_begin, filtered, tile_width * tile_height * 4))
+            return false;
+         
+         UnfilterFieldImageTile(filtered, tile_width, tile_height, texels + y * level->width + x, level->width);
+         tile++;
+      }
+   }
+
+   return true;
+}
+
+//NOTE: file has to be a validated V0 field file, keeps its header & re-encodes the raw image as tiles & mips
+buffer UpgradeFieldFile(buffer file) {
+   ConsumeStruct(&file, FileHeader);
+   Field_FileHeader_V0 *old_header = ConsumeStruct(&file, Field_FileHeader_V0);
+   Field_StartingPosition *starting_positions = ConsumeArray(&file, Field_StartingPosition, old_header->starting_position_count);
+   
+   Field_FileHeader field_header = {};
+   field_header.width = old_header->width;
+   field_header.height = old_header->height;
+   field_header.flags = old_header->flags;
+   field_header.starting_position_count = Min(old_header->starting_position_count, FIELD_MAX_STARTING_POSITIONS);
+   Copy(starting_positions, field_header.starting_position_count * sizeof(Field_StartingPosition), field_header.starting_positions);
+   field_header.image_width = old_header->image_width;
+   field_header.image_height = old_header->image_height;
+   
+   return EncodeFieldFile(&field_header, (u32 *) ConsumeSize(&file, (u64) field_header.image_width * field_header.image_height * 4));
+}
+//FIELD-IMAGE-----------------------------------------------
+
+//SETTINGS-FILE-----------------------------------------------
+buffer EncodeSettingsFile(u32 team_number, string field_name) {
+   FileHeader settings_numbers = header(SETTINGS_MAGIC_NUMBER, SETTINGS_CURR_VERSION);
+   Settings_FileHeader settings_header = {};
+   settings_header.team_number = (u16) team_number;
+   settings_header.field_name_length = (u16) field_name.length;
+
+   buffer settings_file = PushTempBuffer(sizeof(settings_numbers) + sizeof(settings_header) + field_name.length);
+   WriteStruct(&settings_file, &settings_numbers);
+   WriteStruct(&settings_file, &settings_header);
+   WriteSize(&settings_file, field_name.text, field_name.length);
+   return settings_file;
+}
+//SETTINGS-FILE-----------------------------------------------
+
+//NOTE: everything below needs textures from ui_core, headless tools define NORTH_HEADLESS to leave it out
+#ifndef NORTH_HEADLESS
 struct NorthSettings {
    MemoryArena *arena; //NOTE: owned by NorthSettings 
    
@@ -10,7 +200,7 @@ struct NorthSettings {
          v2 size;
          u32 flags;
          u32 starting_position_count;
-         Field_StartingPosition starting_positions[16];
+         Field_StartingPosition starting_positions[FIELD_MAX_STARTING_POSITIONS];
       } field;
    } saved_data;
 
@@ -22,7 +212,7 @@ struct NorthSettings {
       v2 size;
       u32 flags;
       u32 starting_position_count;
-      Field_StartingPosition starting_positions[16];
+      Field_StartingPosition starting_positions[FIELD_MAX_STARTING_POSITIONS];
       texture image;
    } field;
 };
@@ -46,16 +236,41 @@ bool DifferentThanSaved(NorthSettings *state) {
    return result;
 }
 
+//NOTE: file has to have been validated, only decompresses the levels that get uploaded
+texture LoadFieldImage(buffer file, Field_ImageLevel *levels, u32 level_count) {
+   texture result = {};
+   
+   u32 first_level = 0;
+   while(((first_level + 1) < level_count) && 
+         ((levels[first_level].width > FIELD_IMAGE_MAX_LOAD_SIZE) || (levels[first_level].height > FIELD_IMAGE_MAX_LOAD_SIZE)))
+   {
+      first_level++;
+   }
+
+   u32 **level_texels = PushTempArray(u32 *, level_count);
+   for(u32 i = first_level; i < level_count; i++) {
+      level_texels[i] = PushTempArray(u32, levels[i].width * levels[i].height);
+      if(!DecodeFieldImageLevel(file, levels + i, level_texels[i])) {
+         OutputDebugStringA("bad field image\n");
+         return result;
+      }
+   }
+
+   if(level_count > 0) {
+      result = createTexture(level_texels + first_level, levels[first_level].width, 
+                             levels[first_level].height, level_count - first_level);
+   }
+
+   return result;
+}
+
 void ReadSettingsFile(NorthSettings *settings) {
    Reset(settings->arena);
 
    buffer settings_file = ReadEntireFile("settings.ncsf");
    if(settings_file.data != NULL) {
-      FileHeader *file_numbers = ConsumeStruct(&settings_file, FileHeader);
-      
-      if((file_numbers->magic_number == SETTINGS_MAGIC_NUMBER) && 
-         (file_numbers->version_number == SETTINGS_CURR_VERSION))
-      {
+      if(ValidateSettingsFile(settings_file)) {
+         ConsumeStruct(&settings_file, FileHeader);
          Settings_FileHeader *header = ConsumeStruct(&settings_file, Settings_FileHeader);
          
          settings->team_number = header->team_number;
@@ -63,33 +278,36 @@ void ReadSettingsFile(NorthSettings *settings) {
       }
    }
 
-   buffer field_file = ReadEntireFile(Concat(settings->field_name, Literal(".ncff")));
-   settings->field.loaded = (field_file.data != NULL);
-   if(field_file.data != NULL) {
-      FileHeader *file_numbers = ConsumeStruct(&field_file, FileHeader);
-
-      if((file_numbers->magic_number == FIELD_MAGIC_NUMBER) && 
-         (file_numbers->version_number == FIELD_CURR_VERSION))
-      {
-         Field_FileHeader *header = ConsumeStruct(&field_file, Field_FileHeader);
+   //NOTE: mapped so only the header & the image levels that get used are read in
+   MappedFile field_file = MapEntireFile(Concat(settings->field_name, Literal(".ncff")));
+   settings->field.loaded = ValidateFieldFile(field_file.data);
+   if(settings->field.loaded) {
+      buffer file = field_file.data;
+      FileHeader *numbers = ConsumeStruct(&file, FileHeader);
+      deleteTexture(settings->field.image);
+      
+      if(numbers->version_number == FIELD_V0_VERSION) {
+         Field_FileHeader_V0 *header = ConsumeStruct(&file, Field_FileHeader_V0);
          settings->field.size = V2(header->width, header->height);
          settings->field.flags = header->flags;
-
-         u32 starting_positions_size = sizeof(Field_StartingPosition) * header->starting_position_count;
-         Field_StartingPosition *starting_positions = ConsumeArray(&field_file, Field_StartingPosition,
-                                                                   header->starting_position_count);
-         
-         //TODO: make some sort of error message instead?
-         Assert(header->starting_position_count <= ArraySize(settings->field.starting_positions));
-         
          settings->field.starting_position_count = header->starting_position_count;
-         Copy(starting_positions, starting_positions_size, settings->field.starting_positions);
+         Copy(ConsumeArray(&file, Field_StartingPosition, header->starting_position_count),
+              header->starting_position_count * sizeof(Field_StartingPosition), settings->field.starting_positions);
          
-         deleteTexture(settings->field.image);
-         u32 *image_texels = (u32 *) ConsumeSize(&field_file, header->image_width * header->image_height * sizeof(u32));
+         u32 *image_texels = (u32 *) ConsumeSize(&file, (u64) header->image_width * header->image_height * sizeof(u32));
          settings->field.image = createTexture(image_texels, header->image_width, header->image_height);
+      } else {
+         Field_FileHeader *header = ConsumeStruct(&file, Field_FileHeader);
+         settings->field.size = V2(header->width, header->height);
+         settings->field.flags = header->flags;
+         settings->field.starting_position_count = header->starting_position_count;
+         Copy(header->starting_positions, sizeof(header->starting_positions), settings->field.starting_positions);
+
+         Field_ImageLevel *levels = ConsumeArray(&file, Field_ImageLevel, header->image_level_count);
+         settings->field.image = LoadFieldImage(field_file.data, levels, header->image_level_count);
       }
    }
+   UnmapFile(&field_file);
 
    settings->saved_data.team_number = settings->team_number;
    settings->saved_data.field_name = PushCopy(settings->arena, settings->field_name);
@@ -100,75 +318,75 @@ void ReadSettingsFile(NorthSettings *settings) {
    Copy(settings->field.starting_positions, sizeof(settings->field.starting_positions), settings->saved_data.field.starting_positions);
 }
 
+//NOTE: the image doesnt change so this only rewrites the header, 
+//      unless the file is still V0 & needs to be written out in the new format.
+//      the image only lives in the file, so if that's gone or broken theres nothing to save the header into
 void UpdateFieldFile(NorthSettings *settings) {
-   image img = {};
-   {
-      buffer old_field_file = ReadEntireFile(Concat(settings->field_name, Literal(".ncff")));
-      ConsumeStruct(&old_field_file, FileHeader);
-      Field_FileHeader *header = ConsumeStruct(&old_field_file, Field_FileHeader);
-      ConsumeArray(&old_field_file, Field_StartingPosition, header->starting_position_count);
-      img.width = header->image_width;
-      img.height = header->image_height;
-      img.texels = (u32 *) ConsumeSize(&old_field_file, img.width * img.height * 4);
+   string field_file_name = Concat(settings->field_name, Literal(".ncff"));
+   
+   Field_FileHeader field_header = {};
+   field_header.width = settings->field.size.x;
+   field_header.height = settings->field.size.y;
+   field_header.flags = settings->field.flags;
+   field_header.starting_position_count = settings->field.starting_position_count;
+   Copy(settings->field.starting_positions, sizeof(field_header.starting_positions), field_header.starting_positions);
+
+   MappedFile old_field_file = MapEntireFile(field_file_name);
+   buffer file = old_field_file.data;
+   if(!ValidateFieldFile(file)) {
+      UnmapFile(&old_field_file);
+      OutputDebugStringA("field file is missing or invalid, not saving the field\n");
+      return;
    }
 
-   FileHeader numbers = header(FIELD_MAGIC_NUMBER, FIELD_CURR_VERSION);
-   Field_FileHeader header = {};
-   header.width = settings->field.size.x;
-   header.height = settings->field.size.y;
-   header.flags = settings->field.flags;
-   header.starting_position_count = settings->field.starting_position_count;
-   header.image_width = img.width;
-   header.image_height = img.height;
-
-   u32 starting_positions_size = header.starting_position_count * sizeof(Field_StartingPosition);
-   u32 image_size = img.width * img.height * 4;
-   buffer field_file = PushTempBuffer(sizeof(numbers) + sizeof(header) +
-                                      starting_positions_size + image_size);
-   WriteStruct(&field_file, &numbers);
-   WriteStruct(&field_file, &header);
-   WriteSize(&field_file, settings->field.starting_positions, starting_positions_size);
-   WriteSize(&field_file, img.texels, image_size);
-   
-   WriteEntireFile(Concat(settings->field_name, Literal(".ncff")), field_file);
+   bool header_only = false;
+   buffer upgraded_file = {};
+   FileHeader *numbers = ConsumeStruct(&file, FileHeader);
+   if(numbers->version_number == FIELD_V0_VERSION) {
+      Field_FileHeader_V0 *old_header = ConsumeStruct(&file, Field_FileHeader_V0);
+      ConsumeArray(&file, Field_StartingPosition, old_header->starting_position_count);
+      field_header.image_width = old_header->image_width;
+      field_header.image_height = old_header->image_height;
+      upgraded_file = EncodeFieldFile(&field_header, (u32 *) ConsumeSize(&file, (u64) field_header.image_width * field_header.image_height * 4));
+   } else {
+      Field_FileHeader *old_header = ConsumeStruct(&file, Field_FileHeader);
+      field_header.image_width = old_header->image_width;
+      field_header.image_height = old_header->image_height;
+      field_header.image_level_count = old_header->image_level_count;
+      header_only = true;
+   }
+   UnmapFile(&old_field_file);
+
+   if(header_only) {
+      buffer header_file = PushTempBuffer(sizeof(FileHeader) + sizeof(Field_FileHeader));
+      FileHeader numbers = header(FIELD_MAGIC_NUMBER, FIELD_CURR_VERSION);
+      WriteStruct(&header_file, &numbers);
+      WriteStruct(&header_file, &field_header);
+      WriteFileRange(field_file_name, header_file, 0);
+   } else {
+      ReplaceEntireFile(field_file_name, upgraded_file);
+   }
    OutputDebugStringA("field updated\n");
 }
 
 void UpdateSettingsFile(NorthSettings *settings) {
-   FileHeader settings_numbers = header(SETTINGS_MAGIC_NUMBER, SETTINGS_CURR_VERSION);
-   Settings_FileHeader settings_header = {};
-   settings_header.team_number = (u16) settings->team_number;
-   settings_header.field_name_length = (u16) settings->field_name.length;
-
-   buffer settings_file = PushTempBuffer(sizeof(settings_numbers) + sizeof(settings_header) + settings->field_name.length);
-   WriteStruct(&settings_file, &settings_numbers);
-   WriteStruct(&settings_file, &settings_header);
-   WriteSize(&settings_file, settings->field_name.text, settings->field_name.length);
-
-   WriteEntireFile("settings.ncsf", settings_file);
+   WriteEntireFile("settings.ncsf", EncodeSettingsFile(settings->team_number, settings->field_name));
    OutputDebugStringA("settings updated\n");
 }
 
 void WriteNewFieldFile(string name, f32 width, f32 height, string img_file_name) {
-   FileHeader numbers = header(FIELD_MAGIC_NUMBER, FIELD_CURR_VERSION);
-   Field_FileHeader header = {};
-   header.width = width;
-   header.height = height;
+   Field_FileHeader field_header = {};
+   field_header.width = width;
+   field_header.height = height;
    image img = ReadImage(img_file_name);
-   header.image_width = img.valid ? img.width : 0;
-   header.image_height = img.valid ? img.height : 0;
+   field_header.image_width = img.valid ? img.width : 0;
+   field_header.image_height = img.valid ? img.height : 0;
 
-   u32 image_size = img.width * img.height * 4;
-
-   buffer field_file = PushTempBuffer(sizeof(numbers) + sizeof(header) + image_size);
-   WriteStruct(&field_file, &numbers);
-   WriteStruct(&field_file, &header);
-   if(img.valid)
-      WriteSize(&field_file, img.texels, image_size);
-   
-   WriteEntireFile(Concat(name, Literal(".ncff")), field_file);
+   ReplaceEntireFile(Concat(name, Literal(".ncff")), EncodeFieldFile(&field_header, img.texels));
+   FreeImage(&img);
    OutputDebugStringA("new field written\n");
 }
+#endif
 
 #ifdef INCLUDE_DRAWSETTINGS
 
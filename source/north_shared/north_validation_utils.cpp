@@ -0,0 +1,738 @@
+//NOTE: every file format & packet gets a validator that walks it the same way its parser does,
+//      but only checks that every count & length fits in the buffer (& the few values the parsers Assert on 
+//      or cast to an enum).
+//      validate once when a file gets loaded or a packet comes in, after that the Consume parsers cant run off the end
+
+//NOTE: nodes & paths nest, this keeps a bad file from blowing the stack (in here or in the parser)
+#define VALIDATE_MAX_NODE_DEPTH 256
+
+bool ValidateFileHeader(buffer *b, u32 magic_number, u32 version_number) {
+   FileHeader *file_numbers = ValidateStruct(b, FileHeader);
+   return (file_numbers != NULL) &&
+          (file_numbers->magic_number == magic_number) &&
+          (file_numbers->version_number == version_number);
+}
+
+//NOTE: { u8 length; char [length]; }
+bool ValidateShortString(buffer *b) {
+   u8 *length = ValidateStruct(b, u8);
+   return (length != NULL) && (ValidateArray(b, char, *length) != NULL);
+}
+
+//SETTINGS-VALIDATION---------------------------------------
+bool ValidateSettingsFile(buffer file) {
+   if(!ValidateFileHeader(&file, SETTINGS_MAGIC_NUMBER, SETTINGS_CURR_VERSION))
+      return false;
+
+   Settings_FileHeader *header = ValidateStruct(&file, Settings_FileHeader);
+   return (header != NULL) && (ValidateArray(&file, char, header->field_name_length) != NULL);
+}
+
+//NOTE: file is past the FileHeader
+bool ValidateFieldFile_V0(buffer file) {
+   Field_FileHeader_V0 *header = ValidateStruct(&file, Field_FileHeader_V0);
+   if((header == NULL) || (header->starting_position_count > FIELD_MAX_STARTING_POSITIONS))
+      return false;
+
+   return (ValidateArray(&file, Field_StartingPosition, header->starting_position_count) != NULL) &&
+          (ValidateArray(&file, u32, (u64) header->image_width * header->image_height) != NULL);
+}
+
+//NOTE: only walks the header & the tile tables, the tiles get checked as they get decompressed 
+//      so loading a field only touches the header & the levels that get used
+bool ValidateFieldFile(buffer file) {
+   buffer v0_file = file;
+   if(ValidateFileHeader(&v0_file, FIELD_MAGIC_NUMBER, FIELD_V0_VERSION))
+      return ValidateFieldFile_V0(v0_file);
+
+   if(!ValidateFileHeader(&file, FIELD_MAGIC_NUMBER, FIELD_CURR_VERSION))
+      return false;
+
+   Field_FileHeader *header = ValidateStruct(&file, Field_FileHeader);
+   if((header == NULL) || (header->starting_position_count > FIELD_MAX_STARTING_POSITIONS) ||
+      (header->image_level_count != FieldImageLevelCount(header->image_width, header->image_height)))
+   {
+      return false;
+   }
+
+   Field_ImageLevel *levels = ValidateArray(&file, Field_ImageLevel, header->image_level_count);
+   if(levels == NULL)
+      return false;
+
+   u32 width = header->image_width;
+   u32 height = header->image_height;
+   for(u32 i = 0; i < header->image_level_count; i++) {
+      Field_ImageLevel *level = levels + i;
+      if((level->width != width) || (level->height != height))
+         return false;
+      
+      buffer level_file = file;
+      level_file.offset = level->offset;
+      u32 tile_count = FieldImageTileCount(width, height);
+      u32 *tile_ends = ValidateArray(&level_file, u32, tile_count);
+      if(tile_ends == NULL)
+         return false;
+
+      u32 tiles_size = 0;
+      for(u32 j = 0; j < tile_count; j++) {
+         if(tile_ends[j] < tiles_size)
+            return false;
+         tiles_size = tile_ends[j];
+      }
+
+      if(ValidateSize(&level_file, tiles_size) == NULL)
+         return false;
+
+      width = Max(1, width / 2);
+      height = Max(1, height / 2);
+   }
+
+   return true;
+}
+//SETTINGS-VALIDATION---------------------------------------
+
+//PROFILE-VALIDATION----------------------------------------
+bool ValidateRobotProfileGroup(buffer *b) {
+   RobotProfile_Group *group = ValidateStruct(b, RobotProfile_Group);
+   if((group == NULL) || !ValidateArray(b, char, group->name_length))
+      return false;
+
+   for(u32 i = 0; i < group->parameter_count; i++) {
+      RobotProfile_Parameter *param = ValidateStruct(b, RobotProfile_Parameter);
+      if((param == NULL) || !ValidateArray(b, char, param->name_length) ||
+         !ValidateArray(b, f32, param->is_array ? param->value_count : 1))
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+bool ValidateRobotProfileFile(buffer file) {
+   if(!ValidateFileHeader(&file, ROBOT_PROFILE_MAGIC_NUMBER, ROBOT_PROFILE_CURR_VERSION))
+      return false;
+
+   RobotProfile_FileHeader *header = ValidateStruct(&file, RobotProfile_FileHeader);
+   if(header == NULL)
+      return false;
+
+   for(u32 i = 0; i < header->conditional_count; i++) {
+      if(!ValidateShortString(&file))
+         return false;
+   }
+
+   //NOTE: default group + group_count
+   for(u32 i = 0; i < ((u32) header->group_count + 1); i++) {
+      if(!ValidateRobotProfileGroup(&file))
+         return false;
+   }
+
+   for(u32 i = 0; i < header->command_count; i++) {
+      RobotProfile_Command *command = ValidateStruct(&file, RobotProfile_Command);
+      if((command == NULL) || (command->type > North_CommandExecutionType::Continuous) || 
+         !ValidateArray(&file, char, command->name_length))
+      {
+         return false;
+      }
+
+      for(u32 j = 0; j < command->param_count; j++) {
+         if(!ValidateShortString(&file))
+            return false;
+      }
+   }
+
+   return true;
+}
+//PROFILE-VALIDATION----------------------------------------
+
+//AUTO-PROJECT-VALIDATION-----------------------------------
+//NOTE: a u8 in version 0, a varint after that
+bool ValidateAutoCount(buffer *b, u32 version, u32 *count) {
+   if(version == AUTONOMOUS_PROGRAM_V0_VERSION) {
+      u8 *count_u8 = ValidateStruct(b, u8);
+      if(count_u8 == NULL)
+         return false;
+
+      *count = *count_u8;
+      return true;
+   }
+
+   return ValidateVarint(b, count);
+}
+
+bool ValidateAutoContinuousEvent(buffer *b, u32 version) {
+   u32 datapoint_count = 0;
+   AutonomousProgram_ContinuousEvent *event = ValidateStruct(b, AutonomousProgram_ContinuousEvent);
+   return (event != NULL) &&
+          ValidateAutoCount(b, version, &datapoint_count) &&
+          (ValidateArray(b, char, event->command_name_length) != NULL) &&
+          (ValidateArray(b, North_PathDataPoint, datapoint_count) != NULL);
+}
+
+bool ValidateAutoDiscreteEvent(buffer *b, u32 version) {
+   u32 parameter_count = 0;
+   AutonomousProgram_DiscreteEvent *event = ValidateStruct(b, AutonomousProgram_DiscreteEvent);
+   return (event != NULL) &&
+          ValidateAutoCount(b, version, &parameter_count) &&
+          (ValidateArray(b, char, event->command_name_length) != NULL) &&
+          (ValidateArray(b, f32, parameter_count) != NULL);
+}
+
+//NOTE: the three counts for velocity, continuous events & discrete events, shared by paths & pivots
+bool ValidateAutoPathlikeCounts(buffer *b, u32 version, u32 *counts) {
+   return ValidateAutoCount(b, version, counts + 0) &&
+          ValidateAutoCount(b, version, counts + 1) &&
+          ValidateAutoCount(b, version, counts + 2);
+}
+
+bool ValidateAutoPathlikeData(buffer *b, u32 version, u32 *counts) {
+   if((counts[0] < 2) || !ValidateArray(b, North_PathDataPoint, counts[0]))
+      return false;
+
+   for(u32 i = 0; i < counts[1]; i++) {
+      if(!ValidateAutoContinuousEvent(b, version))
+         return false;
+   }
+
+   for(u32 i = 0; i < counts[2]; i++) {
+      if(!ValidateAutoDiscreteEvent(b, version))
+         return false;
+   }
+
+   return true;
+}
+
+bool ValidateAutoCommand(buffer *b, u32 version) {
+   AutonomousProgram_CommandHeader *header = ValidateStruct(b, AutonomousProgram_CommandHeader);
+   if(header == NULL)
+      return false;
+
+   switch(header->type) {
+      case North_CommandType::Generic: {
+         u32 parameter_count = 0;
+         AutonomousProgram_CommandBody_Generic *body = ValidateStruct(b, AutonomousProgram_CommandBody_Generic);
+         return (body != NULL) &&
+                ValidateAutoCount(b, version, &parameter_count) &&
+                (ValidateArray(b, char, body->command_name_length) != NULL) &&
+                (ValidateArray(b, f32, parameter_count) != NULL);
+      } break;
+
+      case North_CommandType::Wait: {
+         return ValidateStruct(b, AutonomousProgram_CommandBody_Wait) != NULL;
+      } break;
+
+      case North_CommandType::Pivot: {
+         u32 counts[3] = {};
+         return (ValidateStruct(b, AutonomousProgram_CommandBody_Pivot) != NULL) &&
+                ValidateAutoPathlikeCounts(b, version, counts) &&
+                ValidateAutoPathlikeData(b, version, counts);
+      } break;
+   }
+
+   return false;
+}
+
+//NOTE: everything but the paths
+bool ValidateAutoNodeData(buffer *b, u32 version, u32 *path_count) {
+   u32 command_count = 0;
+   if(!ValidateStruct(b, AutonomousProgram_Node) ||
+      !ValidateAutoCount(b, version, &command_count) ||
+      !ValidateAutoCount(b, version, path_count))
+   {
+      return false;
+   }
+
+   for(u32 i = 0; i < command_count; i++) {
+      if(!ValidateAutoCommand(b, version))
+         return false;
+   }
+
+   return true;
+}
+
+bool ValidateAutoPath(buffer *b, u32 version, u32 depth);
+bool ValidateAutoNode(buffer *b, u32 version, u32 depth) {
+   if(depth > VALIDATE_MAX_NODE_DEPTH)
+      return false;
+
+   u32 path_count = 0;
+   if(!ValidateAutoNodeData(b, version, &path_count))
+      return false;
+
+   for(u32 i = 0; i < path_count; i++) {
+      if(!ValidateAutoPath(b, version, depth + 1))
+         return false;
+   }
+
+   return true;
+}
+
+//NOTE: everything but the end node
+bool ValidateAutoPathData(buffer *b, u32 version) {
+   u32 control_point_count = 0;
+   u32 counts[3] = {};
+   AutonomousProgram_Path *path = ValidateStruct(b, AutonomousProgram_Path);
+   if((path == NULL) ||
+      !ValidateAutoCount(b, version, &control_point_count) ||
+      !ValidateAutoPathlikeCounts(b, version, counts) ||
+      !ValidateArray(b, char, path->conditional_length))
+   {
+      return false;
+   }
+
+   bool quantized = (version != AUTONOMOUS_PROGRAM_V0_VERSION) && 
+                    (path->flags & AutonomousProgram_PathFlags::QUANTIZED_CONTROL_POINTS);
+   u64 control_point_size = quantized ? sizeof(AutonomousProgram_QuantizedControlPoint) : sizeof(North_HermiteControlPoint);
+   if(!ValidateSize(b, (u64) control_point_count * control_point_size))
+      return false;
+
+   return ValidateAutoPathlikeData(b, version, counts);
+}
+
+bool ValidateAutoPath(buffer *b, u32 version, u32 depth) {
+   return ValidateAutoPathData(b, version) && ValidateAutoNode(b, version, depth);
+}
+
+bool ValidateAutoProjectVersion(u32 version) {
+   return (version == AUTONOMOUS_PROGRAM_V0_VERSION) || (version == AUTONOMOUS_PROGRAM_CURR_VERSION);
+}
+
+//NOTE: reads version 0 & 1
+bool ValidateAutoProjectFile(buffer file) {
+   FileHeader *file_numbers = ValidateStruct(&file, FileHeader);
+   if((file_numbers == NULL) || (file_numbers->magic_number != AUTONOMOUS_PROGRAM_MAGIC_NUMBER) ||
+      !ValidateAutoProjectVersion(file_numbers->version_number))
+   {
+      return false;
+   }
+
+   return (ValidateStruct(&file, AutonomousProgram_FileHeader) != NULL) && 
+          ValidateAutoNode(&file, file_numbers->version_number, 0);
+}
+
+bool ValidateAutoProjectIndexFile(buffer file) {
+   if(!ValidateFileHeader(&file, AUTONOMOUS_PROGRAM_INDEX_MAGIC_NUMBER, AUTONOMOUS_PROGRAM_INDEX_CURR_VERSION))
+      return false;
+
+   AutonomousProgramIndex_FileHeader *header = ValidateStruct(&file, AutonomousProgramIndex_FileHeader);
+   if(header == NULL)
+      return false;
+
+   for(u32 i = 0; i < header->project_count; i++) {
+      AutonomousProgramIndex_Project *project = ValidateStruct(&file, AutonomousProgramIndex_Project);
+      if((project == NULL) || !ValidateArray(&file, char, project->name_length))
+         return false;
+
+      for(u32 j = 0; j < project->command_count; j++) {
+         AutonomousProgramIndex_Command *command = ValidateStruct(&file, AutonomousProgramIndex_Command);
+         if((command == NULL) || !ValidateArray(&file, char, command->command_name_length))
+            return false;
+      }
+
+      for(u32 j = 0; j < project->conditional_count; j++) {
+         if(!ValidateShortString(&file))
+            return false;
+      }
+   }
+
+   return true;
+}
+
+//NOTE: one record, the body has to be exactly record->size. bodies are laid out like the .ncap of the journal's version
+bool ValidateAutoProjectJournalRecord(buffer *b, u32 version) {
+   AutonomousProgramJournal_Record *record = ValidateStruct(b, AutonomousProgramJournal_Record);
+   if((record == NULL) || !ValidateArray(b, u8, record->address_length))
+      return false;
+
+   buffer body = {};
+   body.data = ValidateSize(b, record->size);
+   body.size = record->size;
+   if(body.data == NULL)
+      return false;
+
+   switch(record->type) {
+      case AutonomousProgramJournal_RecordType::Node: {
+         u32 path_count = 0;
+         if(!ValidateAutoNodeData(&body, version, &path_count))
+            return false;
+      } break;
+
+      case AutonomousProgramJournal_RecordType::Path: {
+         if((record->address_length == 0) || !ValidateAutoPathData(&body, version))
+            return false;
+      } break;
+
+      case AutonomousProgramJournal_RecordType::AddPath: {
+         if(!ValidateAutoPath(&body, version, record->address_length))
+            return false;
+      } break;
+
+      case AutonomousProgramJournal_RecordType::RemovePath: {
+         if(record->address_length == 0)
+            return false;
+      } break;
+
+      default: return false;
+   }
+
+   return body.offset == body.size;
+}
+//AUTO-PROJECT-VALIDATION-----------------------------------
+
+//RECORDING-VALIDATION--------------------------------------
+bool ValidatePackedColumn(buffer *b, u32 count) {
+   RobotRecording_PackedColumn *column = ValidateStruct(b, RobotRecording_PackedColumn);
+   if((column == NULL) || ((column->order != 1) && (column->order != 2)))
+      return false;
+
+   u32 block_count = (count + PACKED_BLOCK_SIZE - 1) / PACKED_BLOCK_SIZE;
+   u8 *bit_widths = ValidateArray(b, u8, block_count);
+   if(bit_widths == NULL)
+      return false;
+
+   for(u32 i = 0; i < block_count; i++) {
+      u32 block_size = Min(count - i * PACKED_BLOCK_SIZE, PACKED_BLOCK_SIZE);
+      if((bit_widths[i] > 32) || !ValidateArray(b, u32, PackedBlockWordCount(block_size, bit_widths[i])))
+         return false;
+   }
+
+   return true;
+}
+
+bool ValidateRecordingGroup(buffer *b) {
+   RobotRecording_Group *group = ValidateStruct(b, RobotRecording_Group);
+   if((group == NULL) || !ValidateArray(b, char, group->name_length))
+      return false;
+
+   for(u32 i = 0; i < group->diagnostic_count; i++) {
+      RobotRecording_Diagnostic *diag = ValidateStruct(b, RobotRecording_Diagnostic);
+      if((diag == NULL) || !ValidateArray(b, char, diag->name_length) ||
+         !ValidatePackedColumn(b, diag->sample_count) || !ValidatePackedColumn(b, diag->sample_count))
+      {
+         return false;
+      }
+   }
+
+   for(u32 i = 0; i < group->message_count; i++) {
+      RobotRecording_Message *message = ValidateStruct(b, RobotRecording_Message);
+      if((message == NULL) || !ValidateArray(b, char, message->length))
+         return false;
+   }
+
+   for(u32 i = 0; i < group->marker_count; i++) {
+      RobotRecording_Marker *marker = ValidateStruct(b, RobotRecording_Marker);
+      if((marker == NULL) || !ValidateArray(b, char, marker->length))
+         return false;
+   }
+
+   for(u32 i = 0; i < group->path_count; i++) {
+      RobotRecording_Path *path = ValidateStruct(b, RobotRecording_Path);
+      if((path == NULL) || !ValidateArray(b, char, path->length) ||
+         !ValidateArray(b, North_HermiteControlPoint, path->control_point_count))
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+//NOTE: only the chunk header & size, ValidateRecordingChunk does the rest when the chunk gets read
+bool ValidateRecordingChunkHeader(buffer file, u64 offset, u64 end) {
+   if((offset > end) || (end > file.size))
+      return false;
+
+   file.offset = offset;
+   file.size = end;
+   RobotRecording_Chunk *chunk = ValidateStruct(&file, RobotRecording_Chunk);
+   return (chunk != NULL) && (ValidateSize(&file, chunk->size) != NULL);
+}
+
+//NOTE: the contents of one chunk, everything has to fit in chunk->size
+bool ValidateRecordingChunk(buffer file, u64 offset) {
+   if(!ValidateRecordingChunkHeader(file, offset, file.size))
+      return false;
+
+   file.offset = offset;
+   RobotRecording_Chunk *chunk = ConsumeStruct(&file, RobotRecording_Chunk);
+   file.size = file.offset + chunk->size;
+
+   for(u32 i = 0; i < 4; i++) {
+      if(!ValidatePackedColumn(&file, chunk->robot_state_sample_count))
+         return false;
+   }
+
+   //NOTE: default group + group_count (<= so a group_count of U32_MAX doesnt wrap to 0 groups)
+   for(u32 i = 0; i <= chunk->group_count; i++) {
+      if(!ValidateRecordingGroup(&file))
+         return false;
+   }
+
+   return true;
+}
+
+bool ValidateRecordingSummaries(buffer file, u64 summary_offset) {
+   file.offset = summary_offset;
+   RobotRecording_SummaryIndex *index = ValidateStruct(&file, RobotRecording_SummaryIndex);
+   if(index == NULL)
+      return false;
+
+   for(u32 i = 0; i < index->stream_count; i++) {
+      RobotRecording_SummaryStream *stream = ValidateStruct(&file, RobotRecording_SummaryStream);
+      if((stream == NULL) || !ValidateArray(&file, char, stream->group_name_length) ||
+         !ValidateArray(&file, char, stream->name_length) || (stream->level_count > 32)) //NOTE: bucket sizes are u32s
+      {
+         return false;
+      }
+
+      for(u32 j = 0; j < stream->level_count; j++) {
+         RobotRecording_SummaryLevel *level = ValidateStruct(&file, RobotRecording_SummaryLevel);
+         if((level == NULL) || !ValidateArray(&file, RobotRecording_DiagnosticSummary, level->bucket_count))
+            return false;
+      }
+   }
+
+   return true;
+}
+
+//NOTE: the header, chunk index & summaries, the chunks themselves get checked by ValidateRecordingChunk
+//      so opening a recording doesnt have to touch all of it
+bool ValidateRecordingFile(buffer file) {
+   if(!ValidateFileHeader(&file, ROBOT_RECORDING_MAGIC_NUMBER, ROBOT_RECORDING_CURR_VERSION))
+      return false;
+
+   RobotRecording_FileHeader *header = ValidateStruct(&file, RobotRecording_FileHeader);
+   if((header == NULL) || !ValidateArray(&file, char, header->robot_name_length))
+      return false;
+
+   if(header->chunk_index_offset != 0) {
+      buffer index = file;
+      index.offset = header->chunk_index_offset;
+      RobotRecording_ChunkIndex *index_header = ValidateStruct(&index, RobotRecording_ChunkIndex);
+      if(index_header == NULL)
+         return false;
+
+      RobotRecording_ChunkIndexEntry *entries = ValidateArray(&index, RobotRecording_ChunkIndexEntry, index_header->chunk_count);
+      if(entries == NULL)
+         return false;
+
+      for(u32 i = 0; i < index_header->chunk_count; i++) {
+         if(!ValidateRecordingChunkHeader(file, entries[i].offset, header->chunk_index_offset))
+            return false;
+      }
+   }
+
+   if(header->summary_offset != 0) {
+      if(!ValidateRecordingSummaries(file, header->summary_offset))
+         return false;
+   }
+
+   return true;
+}
+//RECORDING-VALIDATION--------------------------------------
+
+//PACKET-VALIDATION-----------------------------------------
+//NOTE: packet is the body, after the PacketHeader
+bool ValidateWelcomePacket(buffer packet) {
+   Welcome_PacketHeader *header = ValidateStruct(&packet, Welcome_PacketHeader);
+   if((header == NULL) || !ValidateArray(&packet, char, header->robot_name_length))
+      return false;
+
+   for(u32 i = 0; i < header->conditional_count; i++) {
+      if(!ValidateShortString(&packet))
+         return false;
+   }
+
+   for(u32 i = 0; i < header->command_count; i++) {
+      Welcome_Command *command = ValidateStruct(&packet, Welcome_Command);
+      if((command == NULL) || (command->type > North_CommandExecutionType::Continuous) || 
+         !ValidateArray(&packet, char, command->name_length))
+      {
+         return false;
+      }
+
+      for(u32 j = 0; j < command->param_count; j++) {
+         if(!ValidateShortString(&packet))
+            return false;
+      }
+   }
+
+   return true;
+}
+
+bool ValidateCurrentParametersGroup(buffer *packet) {
+   CurrentParameters_Group *group = ValidateStruct(packet, CurrentParameters_Group);
+   if((group == NULL) || !ValidateArray(packet, char, group->name_length))
+      return false;
+
+   for(u32 i = 0; i < group->param_count; i++) {
+      CurrentParameters_Parameter *param = ValidateStruct(packet, CurrentParameters_Parameter);
+      if((param == NULL) || !ValidateArray(packet, char, param->name_length) ||
+         !ValidateArray(packet, f32, param->is_array ? param->value_count : 1))
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+bool ValidateCurrentParametersPacket(buffer packet) {
+   CurrentParameters_PacketHeader *header = ValidateStruct(&packet, CurrentParameters_PacketHeader);
+   if(header == NULL)
+      return false;
+
+   //NOTE: default group + group_count
+   for(u32 i = 0; i < ((u32) header->group_count + 1); i++) {
+      if(!ValidateCurrentParametersGroup(&packet))
+         return false;
+   }
+
+   return true;
+}
+
+//NOTE: the messages, markers & paths of a State_Group or State_V2_Group
+bool ValidateStateEvents(buffer *packet, u32 message_count, u32 marker_count, u32 path_count) {
+   for(u32 i = 0; i < message_count; i++) {
+      State_Message *message = ValidateStruct(packet, State_Message);
+      if((message == NULL) || !ValidateArray(packet, char, message->length))
+         return false;
+   }
+
+   for(u32 i = 0; i < marker_count; i++) {
+      State_Marker *marker = ValidateStruct(packet, State_Marker);
+      if((marker == NULL) || !ValidateArray(packet, char, marker->length))
+         return false;
+   }
+
+   for(u32 i = 0; i < path_count; i++) {
+      State_Path *path = ValidateStruct(packet, State_Path);
+      if((path == NULL) || !ValidateArray(packet, char, path->length) ||
+         !ValidateArray(packet, North_HermiteControlPoint, path->control_point_count))
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+bool ValidateStateGroup(buffer *packet) {
+   State_Group *group = ValidateStruct(packet, State_Group);
+   if((group == NULL) || !ValidateArray(packet, char, group->name_length))
+      return false;
+
+   for(u32 i = 0; i < group->diagnostic_count; i++) {
+      State_Diagnostic *diag = ValidateStruct(packet, State_Diagnostic);
+      if((diag == NULL) || !ValidateArray(packet, char, diag->name_length))
+         return false;
+   }
+
+   return ValidateStateEvents(packet, group->message_count, group->marker_count, group->path_count);
+}
+
+bool ValidateStatePacket(buffer packet) {
+   State_PacketHeader *header = ValidateStruct(&packet, State_PacketHeader);
+   if(header == NULL)
+      return false;
+
+   //NOTE: default group + group_count
+   for(u32 i = 0; i < ((u32) header->group_count + 1); i++) {
+      if(!ValidateStateGroup(&packet))
+         return false;
+   }
+
+   return true;
+}
+
+bool ValidateStateSchemaGroup(buffer *packet) {
+   StateSchema_Group *group = ValidateStruct(packet, StateSchema_Group);
+   if((group == NULL) || !ValidateArray(packet, char, group->name_length))
+      return false;
+
+   for(u32 i = 0; i < group->diagnostic_count; i++) {
+      StateSchema_Diagnostic *diag = ValidateStruct(packet, StateSchema_Diagnostic);
+      if((diag == NULL) || !ValidateArray(packet, char, diag->name_length))
+         return false;
+   }
+
+   return true;
+}
+
+bool ValidateStateSchemaPacket(buffer packet) {
+   StateSchema_PacketHeader *header = ValidateStruct(&packet, StateSchema_PacketHeader);
+   if(header == NULL)
+      return false;
+
+   //NOTE: default group + group_count
+   for(u32 i = 0; i < ((u32) header->group_count + 1); i++) {
+      if(!ValidateStateSchemaGroup(&packet))
+         return false;
+   }
+
+   return true;
+}
+
+//NOTE: the ids can only be checked against the schema, RecieveStateV2Packet does that
+bool ValidateStateV2Packet(buffer packet) {
+   State_V2_PacketHeader *header = ValidateStruct(&packet, State_V2_PacketHeader);
+   u32 changed_count = 0;
+   if((header == NULL) || !ValidateVarint(&packet, &changed_count))
+      return false;
+
+   for(u32 i = 0; i < changed_count; i++) {
+      u32 id_gap = 0;
+      if(!ValidateVarint(&packet, &id_gap))
+         return false;
+   }
+
+   u32 value_size = (header->flags & State_V2_Flags::F16_VALUES) ? sizeof(u16) : sizeof(f32);
+   u32 group_count = 0;
+   if(!ValidateSize(&packet, (u64) changed_count * value_size) || !ValidateVarint(&packet, &group_count))
+      return false;
+
+   for(u32 i = 0; i < group_count; i++) {
+      State_V2_Group *group = ValidateStruct(&packet, State_V2_Group);
+      if((group == NULL) || !ValidateStateEvents(&packet, group->message_count, group->marker_count, group->path_count))
+         return false;
+   }
+
+   return true;
+}
+
+bool ValidateParameterOpPacket(buffer packet) {
+   ParameterOp_PacketHeader *header = ValidateStruct(&packet, ParameterOp_PacketHeader);
+   return (header != NULL) &&
+          (ValidateArray(&packet, char, header->group_name_length) != NULL) &&
+          (ValidateArray(&packet, char, header->param_name_length) != NULL);
+}
+
+bool ValidateUploadAutonomousPacket(buffer packet) {
+   return (ValidateStruct(&packet, UploadAutonomous_PacketHeader) != NULL) && 
+          ValidateAutoNode(&packet, AUTONOMOUS_PROGRAM_V0_VERSION, 0);
+}
+
+bool ValidateUploadAutonomousV1Packet(buffer packet) {
+   return (ValidateStruct(&packet, UploadAutonomous_V1_PacketHeader) != NULL) && 
+          ValidateAutoNode(&packet, AUTONOMOUS_PROGRAM_CURR_VERSION, 0);
+}
+
+bool ValidatePacket(PacketType::type type, buffer packet) {
+   switch(type) {
+      case PacketType::Heartbeat: return true;
+      case PacketType::SetConnectionFlags: return ValidateStruct(&packet, SetConnectionFlags_PacketHeader) != NULL;
+      case PacketType::Welcome: return ValidateWelcomePacket(packet);
+      case PacketType::CurrentParameters: return ValidateCurrentParametersPacket(packet);
+      case PacketType::State: return ValidateStatePacket(packet);
+      case PacketType::ParameterOp: return ValidateParameterOpPacket(packet);
+      case PacketType::SetState: return ValidateStruct(&packet, SetState_PacketHeader) != NULL;
+      case PacketType::UploadAutonomous: return ValidateUploadAutonomousPacket(packet);
+      case PacketType::UploadAutonomous_V1: return ValidateUploadAutonomousV1Packet(packet);
+      case PacketType::StateSchema: return ValidateStateSchemaPacket(packet);
+      case PacketType::State_V2: return ValidateStateV2Packet(packet);
+   }
+
+   return false;
+}
+//PACKET-VALIDATION-----------------------------------------
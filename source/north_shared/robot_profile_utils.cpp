@@ -31,6 +31,32 @@ struct RobotProfileCommand {
    v4 colour;
 };
 
+struct RobotStateDiagnostic {
+   string name;
+   North_Unit::type unit;
+   u32 group; //NOTE: index into RobotStateSchema.groups
+   bool has_value; //NOTE: false until a State_V2 sends it
+   f32 value;
+};
+
+struct RobotStateGroup {
+   string name;
+   u32 first_diagnostic;
+   u32 diagnostic_count;
+};
+
+//NOTE: from the robot's StateSchema, State_V2 packets only update the values
+struct RobotStateSchema {
+   bool valid;
+   u8 id;
+
+   u32 group_count; //NOTE: includes the default group, groups[0]
+   RobotStateGroup *groups;
+
+   u32 diagnostic_count;
+   RobotStateDiagnostic *diagnostics;
+};
+
 namespace RobotProfileState {
    enum type {
       Invalid,
@@ -41,10 +67,12 @@ namespace RobotProfileState {
 
 struct RobotProfile {
    MemoryArena *arena; //NOTE: owned by RobotProfile
+   MemoryArena *schema_arena; //NOTE: owned by RobotProfile, only state_schema lives here so it can be reset on every StateSchema
 
    RobotProfileState::type state;
    string name;
    v2 size;
+   u32 flags; //NOTE: Welcome_Flags, only known while connected (0 for loaded profiles)
    
    RobotProfileGroup default_group;
    u32 group_count;
@@ -55,6 +83,8 @@ struct RobotProfile {
 
    u32 conditional_count;
    string *conditionals;
+
+   RobotStateSchema state_schema; //NOTE: only while connected
 };
 
 bool IsValid(RobotProfile *profile) {
@@ -94,8 +124,12 @@ RobotProfileGroup *GetOrCreateGroup(RobotProfile *profile, string name) {
       result = PushStruct(arena, RobotProfileGroup);
       result->name = PushCopy(arena, name);
 
-      result->next = profile->first_group;
-      profile->first_group = result;
+      //NOTE: appended so groups stay in file order, otherwise every save would flip them
+      RobotProfileGroup **last = &profile->first_group;
+      while(*last != NULL) {
+         last = &(*last)->next;
+      }
+      *last = result;
       profile->group_count++;
    }
 
@@ -124,6 +158,32 @@ RobotProfileCommand *GetCommand(RobotProfile *profile, string name) {
    return NULL;
 }
 
+f32 GetParameterValue(RobotProfileGroup *group, string name, f32 default_value) {
+   RobotProfileParameter *param = GetParameter(group, name);
+   return ((param != NULL) && !param->is_array) ? param->value : default_value;
+}
+
+//NOTE: read from the default group, the defaults are for profiles that dont have them
+struct RobotMotionLimits {
+   f32 max_velocity; //NOTE: ft/s
+   f32 max_acceleration; //NOTE: ft/s^2
+   f32 max_centripetal_acceleration; //NOTE: ft/s^2
+};
+
+RobotMotionLimits GetMotionLimits(RobotProfile *profile) {
+   RobotProfileGroup *group = &profile->default_group;
+   RobotMotionLimits result = {};
+   result.max_velocity = GetParameterValue(group, Literal("max_velocity"), 10);
+   result.max_acceleration = GetParameterValue(group, Literal("max_acceleration"), 8);
+   result.max_centripetal_acceleration = GetParameterValue(group, Literal("max_centripetal_acceleration"), 6);
+   return result;
+}
+
+bool SameMotionLimits(RobotMotionLimits a, RobotMotionLimits b) {
+   return (a.max_velocity == b.max_velocity) && (a.max_acceleration == b.max_acceleration) &&
+          (a.max_centripetal_acceleration == b.max_centripetal_acceleration);
+}
+
 //File-Writing-------------------------------------
 void EncodeGroup(RobotProfileGroup *group, buffer *file) {
    WriteStructData(file, RobotProfile_Group, s, {
@@ -200,10 +260,12 @@ void RecieveWelcomePacket(RobotProfile *profile, buffer packet) {
    profile->state = RobotProfileState::Connected;
    profile->first_group = NULL;
    profile->group_count = 0;
+   profile->state_schema = {};
 
    Welcome_PacketHeader *header = ConsumeStruct(&packet, Welcome_PacketHeader);
    profile->name = PushCopy(arena, ConsumeString(&packet, header->robot_name_length));
    profile->size = V2(header->robot_width, header->robot_length);
+   profile->flags = header->flags;
    profile->command_count = header->command_count;
    profile->commands = PushArray(arena, RobotProfileCommand, profile->command_count);
    profile->conditional_count = header->conditional_count;
@@ -295,6 +357,114 @@ void RecieveCurrentParametersPacket(RobotProfile *profile, buffer packet) {
    UpdateProfileFile(profile);
 }
 
+//NOTE: schemas get resent rarely (only when the robot adds something) so the old one just stays in the arena
+//NOTE: the robot resends its schema whenever it changes, the old one is thrown out with the arena
+void RecieveStateSchemaPacket(RobotProfile *profile, buffer packet) {
+   MemoryArena *arena = profile->schema_arena;
+   RobotStateSchema *schema = &profile->state_schema;
+   Reset(arena);
+   StateSchema_PacketHeader *header = ConsumeStruct(&packet, StateSchema_PacketHeader);
+
+   //NOTE: count the diagnostics first so they can all go in one array
+   buffer counter = packet;
+   u32 diagnostic_count = 0;
+   for(u32 i = 0; i < ((u32) header->group_count + 1); i++) {
+      StateSchema_Group *group = ConsumeStruct(&counter, StateSchema_Group);
+      ConsumeString(&counter, group->name_length);
+      for(u32 j = 0; j < group->diagnostic_count; j++) {
+         StateSchema_Diagnostic *diag = ConsumeStruct(&counter, StateSchema_Diagnostic);
+         ConsumeString(&counter, diag->name_length);
+      }
+      diagnostic_count += group->diagnostic_count;
+   }
+
+   schema->valid = true;
+   schema->id = header->schema_id;
+   schema->group_count = header->group_count + 1;
+   schema->groups = PushArray(arena, RobotStateGroup, schema->group_count);
+   schema->diagnostic_count = diagnostic_count;
+   schema->diagnostics = PushArray(arena, RobotStateDiagnostic, diagnostic_count);
+
+   u32 diagnostic_i = 0;
+   for(u32 i = 0; i < schema->group_count; i++) {
+      StateSchema_Group *packet_group = ConsumeStruct(&packet, StateSchema_Group);
+      RobotStateGroup *group = schema->groups + i;
+      group->name = PushCopy(arena, ConsumeString(&packet, packet_group->name_length));
+      group->first_diagnostic = diagnostic_i;
+      group->diagnostic_count = packet_group->diagnostic_count;
+
+      for(u32 j = 0; j < packet_group->diagnostic_count; j++) {
+         StateSchema_Diagnostic *packet_diag = ConsumeStruct(&packet, StateSchema_Diagnostic);
+         RobotStateDiagnostic *diag = schema->diagnostics + diagnostic_i++;
+         diag->name = PushCopy(arena, ConsumeString(&packet, packet_diag->name_length));
+         diag->unit = (North_Unit::type) packet_diag->unit;
+         diag->group = i;
+         diag->has_value = false;
+         diag->value = 0;
+      }
+   }
+}
+
+//NOTE: returns false (& changes nothing) if the packet isnt for the current schema or refers to something
+//      that isnt in it, the robot's new StateSchema is probably on its way
+bool RecieveStateV2Packet(RobotProfile *profile, buffer packet) {
+   RobotStateSchema *schema = &profile->state_schema;
+   State_V2_PacketHeader *header = ConsumeStruct(&packet, State_V2_PacketHeader);
+   if(!schema->valid || (header->schema_id != schema->id))
+      return false;
+
+   u32 changed_count = ConsumeVarint(&packet);
+   u32 *ids = PushTempArray(u32, changed_count);
+   u64 id = 0;
+   for(u32 i = 0; i < changed_count; i++) {
+      u32 id_gap = ConsumeVarint(&packet);
+      id = (i == 0) ? id_gap : (id + 1 + id_gap);
+      if(id >= schema->diagnostic_count)
+         return false;
+      ids[i] = (u32) id;
+   }
+
+   bool f16_values = (header->flags & State_V2_Flags::F16_VALUES) != 0;
+   u8 *values = ConsumeSize(&packet, changed_count * (f16_values ? sizeof(u16) : sizeof(f32)));
+
+   u32 group_count = ConsumeVarint(&packet);
+   for(u32 i = 0; i < group_count; i++) {
+      State_V2_Group *group = ConsumeStruct(&packet, State_V2_Group);
+      if(group->group_id >= schema->group_count)
+         return false;
+
+      for(u32 j = 0; j < group->message_count; j++) {
+         State_Message *message = ConsumeStruct(&packet, State_Message);
+         ConsumeString(&packet, message->length);
+      }
+
+      for(u32 j = 0; j < group->marker_count; j++) {
+         State_Marker *marker = ConsumeStruct(&packet, State_Marker);
+         ConsumeString(&packet, marker->length);
+      }
+
+      for(u32 j = 0; j < group->path_count; j++) {
+         State_Path *path = ConsumeStruct(&packet, State_Path);
+         ConsumeString(&packet, path->length);
+         ConsumeArray(&packet, North_HermiteControlPoint, path->control_point_count);
+      }
+   }
+
+   //NOTE: anything missing from a keyframe isnt being sent anymore
+   if(header->flags & State_V2_Flags::KEYFRAME) {
+      for(u32 i = 0; i < schema->diagnostic_count; i++)
+         schema->diagnostics[i].has_value = false;
+   }
+
+   for(u32 i = 0; i < changed_count; i++) {
+      RobotStateDiagnostic *diag = schema->diagnostics + ids[i];
+      diag->has_value = true;
+      diag->value = f16_values ? F16ToF32(((u16 *) values)[i]) : ((f32 *) values)[i];
+   }
+
+   return true;
+}
+
 void ParseGroup(MemoryArena *arena, buffer *file, RobotProfile *profile) {
    RobotProfile_Group *file_group = ConsumeStruct(file, RobotProfile_Group);
    string name = ConsumeString(file, file_group->name_length);
@@ -325,6 +495,7 @@ void ParseProfileFile(RobotProfile *profile, buffer file, string name) {
    
    profile->state = RobotProfileState::Loaded;
    profile->first_group = NULL;
+   profile->group_count = 0;
    ZeroStruct(&profile->default_group);
    Reset(arena);
 
@@ -335,6 +506,7 @@ void ParseProfileFile(RobotProfile *profile, buffer file, string name) {
    RobotProfile_FileHeader *header = ConsumeStruct(&file, RobotProfile_FileHeader);
    profile->name = PushCopy(arena, name);
    profile->size = V2(header->robot_width, header->robot_length);
+   profile->flags = 0;
    profile->command_count = header->command_count;
    profile->commands = PushArray(arena, RobotProfileCommand, header->command_count);
    profile->conditional_count = header->conditional_count;
@@ -370,7 +542,7 @@ void ParseProfileFile(RobotProfile *profile, buffer file, string name) {
 //File-Reading----------------------------------------
 void LoadProfileFile(RobotProfile *profile, string file_name) {
    buffer loaded_file = ReadEntireFile(Concat(file_name, Literal(".ncrp")));
-   if(loaded_file.data != NULL) 
+   if((loaded_file.data != NULL) && ValidateRobotProfileFile(loaded_file))
       ParseProfileFile(profile, loaded_file, file_name);
 }
 
@@ -396,6 +568,9 @@ buffer MakeParamOpPacket(RobotProfileParameter *param, ParameterOp_Type::type ty
    return packet;
 }
 
+//UI--------------------------------------------------
+#ifdef INCLUDE_DRAWPROFILES 
+//NOTE: SendPacket comes from the networking layer, which only the editor links in
 void SendParamSetValue(RobotProfileParameter *param, f32 value, u32 index = 0) {
    buffer packet = MakeParamOpPacket(param, ParameterOp_Type::SetValue, value, index);
    SendPacket(packet);
@@ -411,8 +586,6 @@ void SendParamAddValue(RobotProfileParameter *param, f32 value) {
    SendPacket(packet);
 }
 
-//UI--------------------------------------------------
-#ifdef INCLUDE_DRAWPROFILES 
 struct RobotProfiles {
    RobotProfile current;
    RobotProfile loaded; //NOTE: this is a file we're looking at
@@ -0,0 +1,1337 @@
+//NOTE: robot recordings (.ncrr) are a header, a bunch of chunks that each cover chunk_duration seconds,
+//      a chunk index & the diagnostic summaries at the end, see RobotRecording_FileHeader
+
+#define ROBOT_RECORDING_DEFAULT_CHUNK_DURATION 2
+#define RECORDING_BLOCK_SIZE 64
+//NOTE: State packets resend every message/marker/path each packet,
+//      the same one again within this many seconds just extends it instead of recording a new one
+#define RECORDING_COALESCE_TIME 0.25
+//NOTE: samples per bucket in the finest summary level, each level above doubles it
+#define RECORDING_SUMMARY_BASE_BUCKET_SIZE 32
+#define RECORDING_SUMMARY_MAX_LEVELS 32
+
+//PACKED-COLUMNS--------------------------------------------
+//NOTE: see RobotRecording_PackedColumn, values are f32s read as u32 bits so this is lossless,
+//      slowly changing floats have slowly changing bits & evenly spaced times have a delta of delta around 0
+u32 PackedColumnResidual(u32 *values, u32 stride, u32 i, u32 order, u32 first_delta) {
+   if(i == 0)
+      return 0;
+
+   u32 curr = values[i * stride];
+   u32 prev = values[(i - 1) * stride];
+   if(order == 1)
+      return ZigZag(curr - prev);
+
+   u32 prev_delta = (i == 1) ? first_delta : (prev - values[(i - 2) * stride]);
+   return ZigZag((curr - prev) - prev_delta);
+}
+
+u32 PackedColumnBlockWidth(u32 *values, u32 stride, u32 block_start, u32 block_size, u32 order, u32 first_delta) {
+   u32 all_bits = 0;
+   for(u32 i = block_start; i < (block_start + block_size); i++) {
+      all_bits |= PackedColumnResidual(values, stride, i, order, first_delta);
+   }
+   return BitWidth(all_bits);
+}
+
+u64 PackedColumnSize(u32 *values, u32 stride, u32 count, u32 order, u32 first_delta) {
+   u32 block_count = (count + PACKED_BLOCK_SIZE - 1) / PACKED_BLOCK_SIZE;
+   u64 result = sizeof(RobotRecording_PackedColumn) + block_count;
+   for(u32 block_start = 0; block_start < count; block_start += PACKED_BLOCK_SIZE) {
+      u32 block_size = Min(count - block_start, PACKED_BLOCK_SIZE);
+      u32 bit_width = PackedColumnBlockWidth(values, stride, block_start, block_size, order, first_delta);
+      result += sizeof(u32) * PackedBlockWordCount(block_size, bit_width);
+   }
+   return result;
+}
+
+//NOTE: values[i * stride] for i in [0, count), picks whichever order comes out smaller
+void WritePackedColumn(buffer *b, u32 *values, u32 count, u32 stride) {
+   u32 first = (count > 0) ? values[0] : 0;
+   u32 first_delta = (count > 1) ? (values[stride] - values[0]) : 0;
+   u32 order = (PackedColumnSize(values, stride, count, 2, first_delta) <
+                PackedColumnSize(values, stride, count, 1, first_delta)) ? 2 : 1;
+
+   WriteStructData(b, RobotRecording_PackedColumn, column, {
+      column.order = order;
+      column.first = first;
+      column.first_delta = first_delta;
+   });
+
+   for(u32 block_start = 0; block_start < count; block_start += PACKED_BLOCK_SIZE) {
+      u32 block_size = Min(count - block_start, PACKED_BLOCK_SIZE);
+      u8 bit_width = PackedColumnBlockWidth(values, stride, block_start, block_size, order, first_delta);
+      WriteStruct(b, &bit_width);
+   }
+
+   for(u32 block_start = 0; block_start < count; block_start += PACKED_BLOCK_SIZE) {
+      u32 block_size = Min(count - block_start, PACKED_BLOCK_SIZE);
+      u32 residuals[PACKED_BLOCK_SIZE];
+      u32 all_bits = 0;
+      for(u32 i = 0; i < block_size; i++) {
+         residuals[i] = PackedColumnResidual(values, stride, block_start + i, order, first_delta);
+         all_bits |= residuals[i];
+      }
+
+      u32 bit_width = BitWidth(all_bits);
+      u32 words[PACKED_BLOCK_SIZE] = {};
+      PackBlock(residuals, block_size, bit_width, words);
+      WriteArray(b, words, PackedBlockWordCount(block_size, bit_width));
+   }
+}
+
+//NOTE: writes to out[i * stride] for i in [0, count)
+void ReadPackedColumn(buffer *b, u32 count, u32 *out, u32 stride) {
+   RobotRecording_PackedColumn *column = ConsumeStruct(b, RobotRecording_PackedColumn);
+   u32 block_count = (count + PACKED_BLOCK_SIZE - 1) / PACKED_BLOCK_SIZE;
+   u8 *bit_widths = ConsumeArray(b, u8, block_count);
+
+   unpack_block_kernel unpack_block = GetUnpackBlockKernel();
+   prefix_sum_kernel prefix_sum = GetPrefixSumKernel();
+
+   //NOTE: order 2 is two prefix sums, the first gives the deltas & the second the values
+   u32 delta_sum = column->first_delta;
+   u32 value_sum = (column->order == 2) ? (column->first - column->first_delta) : column->first;
+
+   u32 block[PACKED_BLOCK_SIZE];
+   for(u32 block_i = 0; block_i < block_count; block_i++) {
+      u32 block_start = block_i * PACKED_BLOCK_SIZE;
+      u32 block_size = Min(count - block_start, PACKED_BLOCK_SIZE);
+      u32 bit_width = bit_widths[block_i];
+      Assert(bit_width <= 32);
+
+      u8 *words = ConsumeSize(b, sizeof(u32) * PackedBlockWordCount(block_size, bit_width));
+      unpack_block(words, block_size, bit_width, block);
+
+      if(column->order == 2) {
+         delta_sum = prefix_sum(block, block, block_size, delta_sum, true);
+         value_sum = prefix_sum(block, block, block_size, value_sum, false);
+      } else {
+         value_sum = prefix_sum(block, block, block_size, value_sum, true);
+      }
+
+      u32 *block_out = out + block_start * stride;
+      for(u32 i = 0; i < block_size; i++) {
+         block_out[i * stride] = block[i];
+      }
+   }
+}
+
+void WriteRobotStateColumns(buffer *b, RobotRecording_RobotStateSample *samples, u32 count) {
+   u32 stride = sizeof(RobotRecording_RobotStateSample) / sizeof(u32);
+   WritePackedColumn(b, (u32 *) &samples->pos.x, count, stride);
+   WritePackedColumn(b, (u32 *) &samples->pos.y, count, stride);
+   WritePackedColumn(b, (u32 *) &samples->angle, count, stride);
+   WritePackedColumn(b, (u32 *) &samples->time, count, stride);
+}
+
+void ReadRobotStateColumns(buffer *b, RobotRecording_RobotStateSample *samples, u32 count) {
+   u32 stride = sizeof(RobotRecording_RobotStateSample) / sizeof(u32);
+   ReadPackedColumn(b, count, (u32 *) &samples->pos.x, stride);
+   ReadPackedColumn(b, count, (u32 *) &samples->pos.y, stride);
+   ReadPackedColumn(b, count, (u32 *) &samples->angle, stride);
+   ReadPackedColumn(b, count, (u32 *) &samples->time, stride);
+}
+
+void WriteDiagnosticColumns(buffer *b, RobotRecording_DiagnosticSample *samples, u32 count) {
+   u32 stride = sizeof(RobotRecording_DiagnosticSample) / sizeof(u32);
+   WritePackedColumn(b, (u32 *) &samples->value, count, stride);
+   WritePackedColumn(b, (u32 *) &samples->time, count, stride);
+}
+
+void ReadDiagnosticColumns(buffer *b, RobotRecording_DiagnosticSample *samples, u32 count) {
+   u32 stride = sizeof(RobotRecording_DiagnosticSample) / sizeof(u32);
+   ReadPackedColumn(b, count, (u32 *) &samples->value, stride);
+   ReadPackedColumn(b, count, (u32 *) &samples->time, stride);
+}
+//PACKED-COLUMNS--------------------------------------------
+
+//RECORDING-WRITER------------------------------------------
+struct RecorderDiagnosticBlock {
+   RecorderDiagnosticBlock *next;
+   u32 count;
+   RobotRecording_DiagnosticSample samples[RECORDING_BLOCK_SIZE];
+};
+
+struct RecorderSummaryBucket {
+   RobotRecording_DiagnosticSummary summary;
+   u32 sample_count;
+};
+
+struct RecorderSummaryBlock {
+   RecorderSummaryBlock *next;
+   u32 count;
+   RecorderSummaryBucket buckets[RECORDING_BLOCK_SIZE];
+};
+
+//NOTE: unlike RecorderDiagnostic this lasts the whole recording, not just a chunk
+struct RecorderSummaryStream {
+   RecorderSummaryStream *next;
+   string group_name;
+   string name;
+   North_Unit::type unit;
+   u32 sample_count;
+
+   u32 bucket_count; //NOTE: finished buckets of the finest level
+   RecorderSummaryBlock *first_block;
+   RecorderSummaryBlock *last_block;
+   RecorderSummaryBucket curr;
+};
+
+struct RecorderSummaryLevels {
+   u32 level_count;
+   u32 bucket_counts[RECORDING_SUMMARY_MAX_LEVELS];
+   RecorderSummaryBucket *buckets[RECORDING_SUMMARY_MAX_LEVELS];
+};
+
+struct RecorderDiagnostic {
+   RecorderDiagnostic *next;
+   string name;
+   North_Unit::type unit;
+   RecorderSummaryStream *summary;
+
+   u32 sample_count;
+   RecorderDiagnosticBlock *first_block;
+   RecorderDiagnosticBlock *last_block;
+   RobotRecording_DiagnosticSample *samples; //NOTE: the blocks in one array, filled in right before writing
+};
+
+struct RecorderMessage {
+   RecorderMessage *next;
+   North_MessageType::type type;
+   string text;
+   f32 begin_time;
+   f32 end_time;
+};
+
+struct RecorderMarker {
+   RecorderMarker *next;
+   v2 pos;
+   string text;
+   f32 begin_time;
+   f32 end_time;
+};
+
+struct RecorderPath {
+   RecorderPath *next;
+   string text;
+   u32 control_point_count;
+   North_HermiteControlPoint *control_points;
+   f32 begin_time;
+   f32 end_time;
+};
+
+struct RecorderGroup {
+   RecorderGroup *next;
+   string name;
+
+   u32 diagnostic_count;
+   RecorderDiagnostic *first_diagnostic;
+   RecorderDiagnostic *last_diagnostic;
+
+   u32 message_count;
+   RecorderMessage *first_message;
+   RecorderMessage *last_message;
+
+   u32 marker_count;
+   RecorderMarker *first_marker;
+   RecorderMarker *last_marker;
+
+   u32 path_count;
+   RecorderPath *first_path;
+   RecorderPath *last_path;
+};
+
+struct RecorderStateBlock {
+   RecorderStateBlock *next;
+   u32 count;
+   RobotRecording_RobotStateSample samples[RECORDING_BLOCK_SIZE];
+};
+
+struct RecorderChunkIndexBlock {
+   RecorderChunkIndexBlock *next;
+   u32 count;
+   RobotRecording_ChunkIndexEntry entries[RECORDING_BLOCK_SIZE];
+};
+
+struct RobotRecorder {
+   MemoryArena *arena; //NOTE: owned by the RobotRecorder, everything that lasts the whole recording
+   MemoryArena *chunk_arena; //NOTE: owned by the RobotRecorder, reset every time a chunk gets written
+
+   bool recording;
+   string file_name;
+   RobotRecording_FileHeader header;
+   string robot_name;
+   u64 file_size;
+
+   u32 chunk_count;
+   RecorderChunkIndexBlock *first_index_block;
+   RecorderChunkIndexBlock *last_index_block;
+
+   u32 summary_stream_count;
+   RecorderSummaryStream *first_summary_stream;
+   RecorderSummaryStream *last_summary_stream;
+
+   //NOTE: the chunk that's being recorded right now
+   bool chunk_started;
+   f32 chunk_begin_time;
+   f32 chunk_end_time;
+
+   u32 robot_state_count;
+   RecorderStateBlock *first_state_block;
+   RecorderStateBlock *last_state_block;
+   RobotRecording_RobotStateSample *robot_states; //NOTE: the blocks in one array, filled in right before writing
+
+   u32 group_count; //NOTE: doesnt include the default group
+   RecorderGroup *default_group;
+   RecorderGroup *first_group;
+   RecorderGroup *last_group;
+};
+
+void InitRobotRecorder(RobotRecorder *rec) {
+   rec->arena = PlatformAllocArena(Kilobyte(64), "Recorder");
+   rec->chunk_arena = PlatformAllocArena(Megabyte(1), "Recorder Chunk");
+}
+
+void ResetRecorderChunk(RobotRecorder *rec) {
+   Reset(rec->chunk_arena);
+   rec->chunk_started = false;
+   rec->robot_state_count = 0;
+   rec->first_state_block = NULL;
+   rec->last_state_block = NULL;
+   rec->robot_states = NULL;
+
+   rec->group_count = 0;
+   rec->first_group = NULL;
+   rec->last_group = NULL;
+   rec->default_group = PushStruct(rec->chunk_arena, RecorderGroup);
+   rec->default_group->name = EMPTY_STRING;
+}
+
+void WriteRecorderGroup(buffer *b, RecorderGroup *group) {
+   WriteStructData(b, RobotRecording_Group, group_header, {
+      group_header.name_length = group->name.length;
+      group_header.diagnostic_count = group->diagnostic_count;
+      group_header.message_count = group->message_count;
+      group_header.marker_count = group->marker_count;
+      group_header.path_count = group->path_count;
+   });
+   WriteString(b, group->name);
+
+   for(RecorderDiagnostic *diag = group->first_diagnostic; diag; diag = diag->next) {
+      WriteStructData(b, RobotRecording_Diagnostic, diag_header, {
+         diag_header.name_length = diag->name.length;
+         diag_header.unit = (u8) diag->unit;
+         diag_header.sample_count = diag->sample_count;
+      });
+      WriteString(b, diag->name);
+      WriteDiagnosticColumns(b, diag->samples, diag->sample_count);
+   }
+
+   for(RecorderMessage *message = group->first_message; message; message = message->next) {
+      WriteStructData(b, RobotRecording_Message, message_header, {
+         message_header.type = (u8) message->type;
+         message_header.length = message->text.length;
+         message_header.begin_time = message->begin_time;
+         message_header.end_time = message->end_time;
+      });
+      WriteString(b, message->text);
+   }
+
+   for(RecorderMarker *marker = group->first_marker; marker; marker = marker->next) {
+      WriteStructData(b, RobotRecording_Marker, marker_header, {
+         marker_header.pos = marker->pos;
+         marker_header.length = marker->text.length;
+         marker_header.begin_time = marker->begin_time;
+         marker_header.end_time = marker->end_time;
+      });
+      WriteString(b, marker->text);
+   }
+
+   for(RecorderPath *path = group->first_path; path; path = path->next) {
+      WriteStructData(b, RobotRecording_Path, path_header, {
+         path_header.length = path->text.length;
+         path_header.control_point_count = path->control_point_count;
+         path_header.begin_time = path->begin_time;
+         path_header.end_time = path->end_time;
+      });
+      WriteString(b, path->text);
+      WriteArray(b, path->control_points, path->control_point_count);
+   }
+}
+
+void WriteRecorderChunk(buffer *b, RobotRecorder *rec, u32 size) {
+   WriteStructData(b, RobotRecording_Chunk, chunk_header, {
+      chunk_header.size = size;
+      chunk_header.begin_time = rec->chunk_begin_time;
+      chunk_header.end_time = rec->chunk_end_time;
+      chunk_header.robot_state_sample_count = rec->robot_state_count;
+      chunk_header.group_count = rec->group_count;
+   });
+
+   WriteRobotStateColumns(b, rec->robot_states, rec->robot_state_count);
+
+   WriteRecorderGroup(b, rec->default_group);
+   for(RecorderGroup *group = rec->first_group; group; group = group->next) {
+      WriteRecorderGroup(b, group);
+   }
+}
+
+//NOTE: the columns are written from contiguous arrays
+void FlattenRecorderGroup(RobotRecorder *rec, RecorderGroup *group) {
+   for(RecorderDiagnostic *diag = group->first_diagnostic; diag; diag = diag->next) {
+      diag->samples = PushArray(rec->chunk_arena, RobotRecording_DiagnosticSample, diag->sample_count);
+      u32 sample_i = 0;
+      for(RecorderDiagnosticBlock *block = diag->first_block; block; block = block->next) {
+         Copy(block->samples, block->count * sizeof(RobotRecording_DiagnosticSample), diag->samples + sample_i);
+         sample_i += block->count;
+      }
+   }
+}
+
+void FlattenRecorderChunk(RobotRecorder *rec) {
+   rec->robot_states = PushArray(rec->chunk_arena, RobotRecording_RobotStateSample, rec->robot_state_count);
+   u32 sample_i = 0;
+   for(RecorderStateBlock *block = rec->first_state_block; block; block = block->next) {
+      Copy(block->samples, block->count * sizeof(RobotRecording_RobotStateSample), rec->robot_states + sample_i);
+      sample_i += block->count;
+   }
+
+   FlattenRecorderGroup(rec, rec->default_group);
+   for(RecorderGroup *group = rec->first_group; group; group = group->next) {
+      FlattenRecorderGroup(rec, group);
+   }
+}
+
+void FlushRecorderChunk(RobotRecorder *rec) {
+   if(!rec->chunk_started)
+      return;
+
+   FlattenRecorderChunk(rec);
+
+   buffer sizer = {};
+   WriteRecorderChunk(&sizer, rec, 0);
+
+   buffer chunk = PushBuffer(rec->chunk_arena, sizer.offset);
+   WriteRecorderChunk(&chunk, rec, sizer.offset - sizeof(RobotRecording_Chunk));
+   WriteFileAppend(rec->file_name, chunk);
+
+   RecorderChunkIndexBlock *index_block = rec->last_index_block;
+   if((index_block == NULL) || (index_block->count == RECORDING_BLOCK_SIZE)) {
+      index_block = PushStruct(rec->arena, RecorderChunkIndexBlock);
+      if(rec->last_index_block != NULL) {
+         rec->last_index_block->next = index_block;
+      } else {
+         rec->first_index_block = index_block;
+      }
+      rec->last_index_block = index_block;
+   }
+
+   RobotRecording_ChunkIndexEntry *entry = index_block->entries + index_block->count++;
+   entry->offset = rec->file_size;
+   entry->begin_time = rec->chunk_begin_time;
+   entry->end_time = rec->chunk_end_time;
+   rec->chunk_count++;
+   rec->file_size += chunk.offset;
+
+   ResetRecorderChunk(rec);
+}
+
+void WriteRecordingHeader(RobotRecorder *rec) {
+   buffer b = PushBuffer(rec->chunk_arena, sizeof(FileHeader) + sizeof(RobotRecording_FileHeader) + rec->robot_name.length);
+   FileHeader file_numbers = header(ROBOT_RECORDING_MAGIC_NUMBER, ROBOT_RECORDING_CURR_VERSION);
+   WriteStruct(&b, &file_numbers);
+   WriteStruct(&b, &rec->header);
+   WriteString(&b, rec->robot_name);
+   WriteFileRange(rec->file_name, b, 0);
+}
+
+//NOTE: file_name includes the extension, the file gets overwritten
+void BeginRecording(RobotRecorder *rec, string file_name, string robot_name, v2 robot_size, u64 timestamp,
+                    f32 chunk_duration = ROBOT_RECORDING_DEFAULT_CHUNK_DURATION)
+{
+   Reset(rec->arena);
+   rec->recording = true;
+   rec->file_name = PushCopy(rec->arena, file_name);
+   rec->robot_name = PushCopy(rec->arena, robot_name);
+   rec->chunk_count = 0;
+   rec->first_index_block = NULL;
+   rec->last_index_block = NULL;
+   rec->summary_stream_count = 0;
+   rec->first_summary_stream = NULL;
+   rec->last_summary_stream = NULL;
+
+   rec->header = {};
+   rec->header.timestamp = timestamp;
+   rec->header.robot_name_length = robot_name.length;
+   rec->header.robot_width = robot_size.x;
+   rec->header.robot_length = robot_size.y;
+   rec->header.chunk_duration = chunk_duration;
+   rec->header.chunk_index_offset = 0;
+   rec->header.summary_offset = 0;
+
+   ResetRecorderChunk(rec);
+   WriteEntireFile(rec->file_name, Buffer(0, NULL));
+   WriteRecordingHeader(rec);
+   rec->file_size = sizeof(FileHeader) + sizeof(RobotRecording_FileHeader) + robot_name.length;
+}
+
+void AddSummarySample(RecorderSummaryBucket *bucket, f32 value, f32 time) {
+   RobotRecording_DiagnosticSummary *summary = &bucket->summary;
+   if(bucket->sample_count == 0) {
+      summary->begin_time = time;
+      summary->min = value;
+      summary->max = value;
+      summary->mean = value;
+      summary->first = value;
+   } else {
+      summary->min = Min(summary->min, value);
+      summary->max = Max(summary->max, value);
+      summary->mean += (value - summary->mean) / (bucket->sample_count + 1);
+   }
+
+   summary->end_time = time;
+   summary->last = value;
+   bucket->sample_count++;
+}
+
+//NOTE: b comes after a, b can be empty
+RecorderSummaryBucket MergeSummaryBuckets(RecorderSummaryBucket a, RecorderSummaryBucket b) {
+   if(b.sample_count == 0)
+      return a;
+
+   RecorderSummaryBucket result = {};
+   result.sample_count = a.sample_count + b.sample_count;
+   result.summary.begin_time = a.summary.begin_time;
+   result.summary.end_time = b.summary.end_time;
+   result.summary.min = Min(a.summary.min, b.summary.min);
+   result.summary.max = Max(a.summary.max, b.summary.max);
+   result.summary.mean = (a.summary.mean * a.sample_count + b.summary.mean * b.sample_count) / result.sample_count;
+   result.summary.first = a.summary.first;
+   result.summary.last = b.summary.last;
+   return result;
+}
+
+RecorderSummaryStream *GetRecorderSummaryStream(RobotRecorder *rec, string group_name, string name, North_Unit::type unit) {
+   for(RecorderSummaryStream *stream = rec->first_summary_stream; stream; stream = stream->next) {
+      if((stream->group_name == group_name) && (stream->name == name))
+         return stream;
+   }
+
+   RecorderSummaryStream *result = PushStruct(rec->arena, RecorderSummaryStream);
+   result->group_name = PushCopy(rec->arena, group_name);
+   result->name = PushCopy(rec->arena, name);
+   result->unit = unit;
+   if(rec->last_summary_stream != NULL) {
+      rec->last_summary_stream->next = result;
+   } else {
+      rec->first_summary_stream = result;
+   }
+   rec->last_summary_stream = result;
+   rec->summary_stream_count++;
+   return result;
+}
+
+void SummarizeDiagnosticSample(RobotRecorder *rec, RecorderSummaryStream *stream, f32 value, f32 time) {
+   AddSummarySample(&stream->curr, value, time);
+   stream->sample_count++;
+
+   if(stream->curr.sample_count == RECORDING_SUMMARY_BASE_BUCKET_SIZE) {
+      RecorderSummaryBlock *block = stream->last_block;
+      if((block == NULL) || (block->count == RECORDING_BLOCK_SIZE)) {
+         block = PushStruct(rec->arena, RecorderSummaryBlock);
+         if(stream->last_block != NULL) {
+            stream->last_block->next = block;
+         } else {
+            stream->first_block = block;
+         }
+         stream->last_block = block;
+      }
+
+      block->buckets[block->count++] = stream->curr;
+      stream->bucket_count++;
+      stream->curr = {};
+   }
+}
+
+//NOTE: every level has half as many buckets as the one below it, until there's just one bucket left
+RecorderSummaryLevels BuildSummaryLevels(RecorderSummaryStream *stream, MemoryArena *arena) {
+   RecorderSummaryLevels result = {};
+   u32 bucket_count = stream->bucket_count + ((stream->curr.sample_count > 0) ? 1 : 0);
+   if(bucket_count == 0)
+      return result;
+
+   RecorderSummaryBucket *buckets = PushArray(arena, RecorderSummaryBucket, bucket_count);
+   u32 bucket_i = 0;
+   for(RecorderSummaryBlock *block = stream->first_block; block; block = block->next) {
+      for(u32 i = 0; i < block->count; i++)
+         buckets[bucket_i++] = block->buckets[i];
+   }
+   if(stream->curr.sample_count > 0)
+      buckets[bucket_i++] = stream->curr;
+
+   result.level_count = 1;
+   result.bucket_counts[0] = bucket_count;
+   result.buckets[0] = buckets;
+
+   while(bucket_count > 1) {
+      Assert(result.level_count < RECORDING_SUMMARY_MAX_LEVELS);
+      RecorderSummaryBucket *prev_buckets = buckets;
+      u32 prev_bucket_count = bucket_count;
+
+      bucket_count = (prev_bucket_count + 1) / 2;
+      buckets = PushArray(arena, RecorderSummaryBucket, bucket_count);
+      for(u32 i = 0; i < bucket_count; i++) {
+         RecorderSummaryBucket empty = {};
+         RecorderSummaryBucket b = ((2 * i + 1) < prev_bucket_count) ? prev_buckets[2 * i + 1] : empty;
+         buckets[i] = MergeSummaryBuckets(prev_buckets[2 * i], b);
+      }
+
+      result.bucket_counts[result.level_count] = bucket_count;
+      result.buckets[result.level_count] = buckets;
+      result.level_count++;
+   }
+
+   return result;
+}
+
+void WriteRecorderSummaries(buffer *b, RobotRecorder *rec, RecorderSummaryLevels *levels) {
+   WriteStructData(b, RobotRecording_SummaryIndex, index_header, {
+      index_header.base_bucket_size = RECORDING_SUMMARY_BASE_BUCKET_SIZE;
+      index_header.stream_count = rec->summary_stream_count;
+   });
+
+   u32 stream_i = 0;
+   for(RecorderSummaryStream *stream = rec->first_summary_stream; stream; stream = stream->next) {
+      RecorderSummaryLevels *stream_levels = levels + stream_i++;
+      WriteStructData(b, RobotRecording_SummaryStream, stream_header, {
+         stream_header.group_name_length = stream->group_name.length;
+         stream_header.name_length = stream->name.length;
+         stream_header.unit = (u8) stream->unit;
+         stream_header.sample_count = stream->sample_count;
+         stream_header.level_count = stream_levels->level_count;
+      });
+      WriteString(b, stream->group_name);
+      WriteString(b, stream->name);
+
+      for(u32 i = 0; i < stream_levels->level_count; i++) {
+         WriteStructData(b, RobotRecording_SummaryLevel, level_header, {
+            level_header.bucket_count = stream_levels->bucket_counts[i];
+         });
+         for(u32 j = 0; j < stream_levels->bucket_counts[i]; j++) {
+            WriteStruct(b, &stream_levels->buckets[i][j].summary);
+         }
+      }
+   }
+}
+
+void EndRecording(RobotRecorder *rec) {
+   if(!rec->recording)
+      return;
+
+   FlushRecorderChunk(rec);
+
+   u64 index_size = sizeof(RobotRecording_ChunkIndex) + rec->chunk_count * sizeof(RobotRecording_ChunkIndexEntry);
+   buffer index = PushBuffer(rec->chunk_arena, index_size);
+   WriteStructData(&index, RobotRecording_ChunkIndex, index_header, {
+      index_header.chunk_count = rec->chunk_count;
+   });
+   for(RecorderChunkIndexBlock *block = rec->first_index_block; block; block = block->next) {
+      WriteArray(&index, block->entries, block->count);
+   }
+   WriteFileAppend(rec->file_name, index);
+   rec->header.chunk_index_offset = rec->file_size;
+   rec->file_size += index_size;
+
+   RecorderSummaryLevels *levels = PushArray(rec->chunk_arena, RecorderSummaryLevels, rec->summary_stream_count);
+   u32 stream_i = 0;
+   for(RecorderSummaryStream *stream = rec->first_summary_stream; stream; stream = stream->next) {
+      levels[stream_i++] = BuildSummaryLevels(stream, rec->chunk_arena);
+   }
+
+   buffer sizer = {};
+   WriteRecorderSummaries(&sizer, rec, levels);
+   buffer summaries = PushBuffer(rec->chunk_arena, sizer.offset);
+   WriteRecorderSummaries(&summaries, rec, levels);
+   WriteFileAppend(rec->file_name, summaries);
+   rec->header.summary_offset = rec->file_size;
+   rec->file_size += summaries.offset;
+
+   //NOTE: the header only points at the index once everything else is in the file
+   WriteRecordingHeader(rec);
+   rec->recording = false;
+   ResetRecorderChunk(rec);
+}
+
+//NOTE: every Record call goes through this first, it starts a new chunk when time is past the current one
+void AdvanceRecorder(RobotRecorder *rec, f32 time) {
+   Assert(rec->recording);
+   if(rec->chunk_started && (time >= (rec->chunk_begin_time + rec->header.chunk_duration)))
+      FlushRecorderChunk(rec);
+
+   if(!rec->chunk_started) {
+      rec->chunk_started = true;
+      rec->chunk_begin_time = time;
+      rec->chunk_end_time = time;
+   }
+
+   rec->chunk_begin_time = Min(rec->chunk_begin_time, time);
+   rec->chunk_end_time = Max(rec->chunk_end_time, time);
+}
+
+RecorderGroup *GetRecorderGroup(RobotRecorder *rec, string name) {
+   if(name.length == 0)
+      return rec->default_group;
+
+   for(RecorderGroup *group = rec->first_group; group; group = group->next) {
+      if(group->name == name)
+         return group;
+   }
+
+   RecorderGroup *result = PushStruct(rec->chunk_arena, RecorderGroup);
+   result->name = PushCopy(rec->chunk_arena, name);
+   if(rec->last_group != NULL) {
+      rec->last_group->next = result;
+   } else {
+      rec->first_group = result;
+   }
+   rec->last_group = result;
+   rec->group_count++;
+   return result;
+}
+
+void RecordRobotState(RobotRecorder *rec, v2 pos, f32 angle, f32 time) {
+   AdvanceRecorder(rec, time);
+
+   RecorderStateBlock *block = rec->last_state_block;
+   if((block == NULL) || (block->count == RECORDING_BLOCK_SIZE)) {
+      block = PushStruct(rec->chunk_arena, RecorderStateBlock);
+      if(rec->last_state_block != NULL) {
+         rec->last_state_block->next = block;
+      } else {
+         rec->first_state_block = block;
+      }
+      rec->last_state_block = block;
+   }
+
+   RobotRecording_RobotStateSample sample = { pos, angle, time };
+   block->samples[block->count++] = sample;
+   rec->robot_state_count++;
+}
+
+void RecordDiagnostic(RobotRecorder *rec, string group_name, string name, North_Unit::type unit, f32 value, f32 time) {
+   AdvanceRecorder(rec, time);
+   RecorderGroup *group = GetRecorderGroup(rec, group_name);
+
+   RecorderDiagnostic *diag = NULL;
+   for(RecorderDiagnostic *curr = group->first_diagnostic; curr; curr = curr->next) {
+      if(curr->name == name) {
+         diag = curr;
+         break;
+      }
+   }
+
+   if(diag == NULL) {
+      diag = PushStruct(rec->chunk_arena, RecorderDiagnostic);
+      diag->name = PushCopy(rec->chunk_arena, name);
+      diag->unit = unit;
+      diag->summary = GetRecorderSummaryStream(rec, group_name, name, unit);
+      if(group->last_diagnostic != NULL) {
+         group->last_diagnostic->next = diag;
+      } else {
+         group->first_diagnostic = diag;
+      }
+      group->last_diagnostic = diag;
+      group->diagnostic_count++;
+   }
+
+   RecorderDiagnosticBlock *block = diag->last_block;
+   if((block == NULL) || (block->count == RECORDING_BLOCK_SIZE)) {
+      block = PushStruct(rec->chunk_arena, RecorderDiagnosticBlock);
+      if(diag->last_block != NULL) {
+         diag->last_block->next = block;
+      } else {
+         diag->first_block = block;
+      }
+      diag->last_block = block;
+   }
+
+   RobotRecording_DiagnosticSample sample = { value, time };
+   block->samples[block->count++] = sample;
+   diag->sample_count++;
+
+   SummarizeDiagnosticSample(rec, diag->summary, value, time);
+}
+
+void RecordMessage(RobotRecorder *rec, string group_name, North_MessageType::type type, string text,
+                   f32 begin_time, f32 end_time)
+{
+   AdvanceRecorder(rec, begin_time);
+   RecorderGroup *group = GetRecorderGroup(rec, group_name);
+
+   for(RecorderMessage *curr = group->first_message; curr; curr = curr->next) {
+      if((curr->type == type) && (curr->text == text) &&
+         (begin_time <= (curr->end_time + RECORDING_COALESCE_TIME)))
+      {
+         curr->end_time = Max(curr->end_time, end_time);
+         return;
+      }
+   }
+
+   RecorderMessage *message = PushStruct(rec->chunk_arena, RecorderMessage);
+   message->type = type;
+   message->text = PushCopy(rec->chunk_arena, text);
+   message->begin_time = begin_time;
+   message->end_time = end_time;
+   if(group->last_message != NULL) {
+      group->last_message->next = message;
+   } else {
+      group->first_message = message;
+   }
+   group->last_message = message;
+   group->message_count++;
+}
+
+void RecordMarker(RobotRecorder *rec, string group_name, v2 pos, string text, f32 begin_time, f32 end_time) {
+   AdvanceRecorder(rec, begin_time);
+   RecorderGroup *group = GetRecorderGroup(rec, group_name);
+
+   for(RecorderMarker *curr = group->first_marker; curr; curr = curr->next) {
+      if((curr->pos.x == pos.x) && (curr->pos.y == pos.y) && (curr->text == text) &&
+         (begin_time <= (curr->end_time + RECORDING_COALESCE_TIME)))
+      {
+         curr->end_time = Max(curr->end_time, end_time);
+         return;
+      }
+   }
+
+   RecorderMarker *marker = PushStruct(rec->chunk_arena, RecorderMarker);
+   marker->pos = pos;
+   marker->text = PushCopy(rec->chunk_arena, text);
+   marker->begin_time = begin_time;
+   marker->end_time = end_time;
+   if(group->last_marker != NULL) {
+      group->last_marker->next = marker;
+   } else {
+      group->first_marker = marker;
+   }
+   group->last_marker = marker;
+   group->marker_count++;
+}
+
+void RecordPath(RobotRecorder *rec, string group_name, string text,
+                North_HermiteControlPoint *control_points, u32 control_point_count,
+                f32 begin_time, f32 end_time)
+{
+   AdvanceRecorder(rec, begin_time);
+   RecorderGroup *group = GetRecorderGroup(rec, group_name);
+   u64 points_size = control_point_count * sizeof(North_HermiteControlPoint);
+
+   for(RecorderPath *curr = group->first_path; curr; curr = curr->next) {
+      if((curr->text == text) && (curr->control_point_count == control_point_count) &&
+         (memcmp(curr->control_points, control_points, points_size) == 0) &&
+         (begin_time <= (curr->end_time + RECORDING_COALESCE_TIME)))
+      {
+         curr->end_time = Max(curr->end_time, end_time);
+         return;
+      }
+   }
+
+   RecorderPath *path = PushStruct(rec->chunk_arena, RecorderPath);
+   path->text = PushCopy(rec->chunk_arena, text);
+   path->control_point_count = control_point_count;
+   path->control_points = PushArrayCopy(rec->chunk_arena, North_HermiteControlPoint, control_points, control_point_count);
+   path->begin_time = begin_time;
+   path->end_time = end_time;
+   if(group->last_path != NULL) {
+      group->last_path->next = path;
+   } else {
+      group->first_path = path;
+   }
+   group->last_path = path;
+   group->path_count++;
+}
+
+//NOTE: the messages, markers & paths of a State_Group or State_V2_Group
+void RecordStateEvents(RobotRecorder *rec, buffer *packet, string group_name,
+                       u32 message_count, u32 marker_count, u32 path_count, f32 time)
+{
+   for(u32 i = 0; i < message_count; i++) {
+      State_Message *message = ConsumeStruct(packet, State_Message);
+      string text = ConsumeString(packet, message->length);
+      RecordMessage(rec, group_name, (North_MessageType::type) message->type, text, time, time);
+   }
+
+   for(u32 i = 0; i < marker_count; i++) {
+      State_Marker *marker = ConsumeStruct(packet, State_Marker);
+      string text = ConsumeString(packet, marker->length);
+      RecordMarker(rec, group_name, marker->pos, text, time, time);
+   }
+
+   for(u32 i = 0; i < path_count; i++) {
+      State_Path *path = ConsumeStruct(packet, State_Path);
+      string text = ConsumeString(packet, path->length);
+      North_HermiteControlPoint *points = ConsumeArray(packet, North_HermiteControlPoint, path->control_point_count);
+      RecordPath(rec, group_name, text, points, path->control_point_count, time, time);
+   }
+}
+
+void RecordStateGroup(RobotRecorder *rec, buffer *packet, f32 time) {
+   State_Group *group = ConsumeStruct(packet, State_Group);
+   string group_name = ConsumeString(packet, group->name_length);
+
+   for(u32 i = 0; i < group->diagnostic_count; i++) {
+      State_Diagnostic *diag = ConsumeStruct(packet, State_Diagnostic);
+      string name = ConsumeString(packet, diag->name_length);
+      RecordDiagnostic(rec, group_name, name, (North_Unit::type) diag->unit, diag->value, time);
+   }
+
+   RecordStateEvents(rec, packet, group_name, group->message_count, group->marker_count, group->path_count, time);
+}
+
+//NOTE: packet is the State packet body (after the PacketHeader)
+void RecordStatePacket(RobotRecorder *rec, buffer packet) {
+   State_PacketHeader *header = ConsumeStruct(&packet, State_PacketHeader);
+   RecordRobotState(rec, header->pos, header->angle, header->time);
+
+   RecordStateGroup(rec, &packet, header->time);
+   for(u32 i = 0; i < header->group_count; i++) {
+      RecordStateGroup(rec, &packet, header->time);
+   }
+}
+
+//NOTE: packet is the State_V2 packet body, RecieveStateV2Packet has to have taken it first
+//      every diagnostic with a value gets a sample, same as if the robot had sent a whole State
+//      returns false if the packet doesnt match the schema, recording stops at whatever didnt match
+bool RecordStateV2Packet(RobotRecorder *rec, RobotStateSchema *schema, buffer packet) {
+   State_V2_PacketHeader *header = ConsumeStruct(&packet, State_V2_PacketHeader);
+   if(!schema->valid || (header->schema_id != schema->id))
+      return false;
+
+   RecordRobotState(rec, header->pos, header->angle, header->time);
+
+   for(u32 i = 0; i < schema->diagnostic_count; i++) {
+      RobotStateDiagnostic *diag = schema->diagnostics + i;
+      if(diag->has_value)
+         RecordDiagnostic(rec, schema->groups[diag->group].name, diag->name, diag->unit, diag->value, header->time);
+   }
+
+   //NOTE: skip the changed values, theyre already in the schema
+   u32 changed_count = ConsumeVarint(&packet);
+   for(u32 i = 0; i < changed_count; i++) {
+      ConsumeVarint(&packet);
+   }
+   ConsumeSize(&packet, changed_count * ((header->flags & State_V2_Flags::F16_VALUES) ? sizeof(u16) : sizeof(f32)));
+
+   u32 group_count = ConsumeVarint(&packet);
+   for(u32 i = 0; i < group_count; i++) {
+      State_V2_Group *group = ConsumeStruct(&packet, State_V2_Group);
+      if(group->group_id >= schema->group_count)
+         return false;
+
+      RecordStateEvents(rec, &packet, schema->groups[group->group_id].name,
+                        group->message_count, group->marker_count, group->path_count, header->time);
+   }
+
+   return true;
+}
+//RECORDING-WRITER------------------------------------------
+
+//RECORDING-READER------------------------------------------
+//NOTE: strings point straight into the mapped file, samples get decoded into the arena
+struct RecordingDiagnostic {
+   string name;
+   North_Unit::type unit;
+   u32 sample_count;
+   RobotRecording_DiagnosticSample *samples;
+};
+
+struct RecordingMessage {
+   North_MessageType::type type;
+   string text;
+   f32 begin_time;
+   f32 end_time;
+};
+
+struct RecordingMarker {
+   v2 pos;
+   string text;
+   f32 begin_time;
+   f32 end_time;
+};
+
+struct RecordingPath {
+   string text;
+   u32 control_point_count;
+   North_HermiteControlPoint *control_points;
+   f32 begin_time;
+   f32 end_time;
+};
+
+struct RecordingGroup {
+   string name;
+
+   u32 diagnostic_count;
+   RecordingDiagnostic *diagnostics;
+
+   u32 message_count;
+   RecordingMessage *messages;
+
+   u32 marker_count;
+   RecordingMarker *markers;
+
+   u32 path_count;
+   RecordingPath *paths;
+};
+
+struct RecordingChunk {
+   f32 begin_time;
+   f32 end_time;
+
+   u32 robot_state_count;
+   RobotRecording_RobotStateSample *robot_states;
+
+   u32 group_count; //NOTE: includes the default group, groups[0]
+   RecordingGroup *groups;
+};
+
+struct RecordingSummaryLevel {
+   u32 bucket_size; //NOTE: in samples, the last bucket can have less
+   u32 bucket_count;
+   RobotRecording_DiagnosticSummary *buckets;
+};
+
+struct RecordingSummaryStream {
+   string group_name;
+   string name;
+   North_Unit::type unit;
+   u32 sample_count;
+
+   u32 level_count; //NOTE: levels[0] is the finest
+   RecordingSummaryLevel *levels;
+};
+
+struct RobotRecording {
+   MappedFile file;
+
+   u64 timestamp;
+   string robot_name;
+   v2 robot_size;
+   f32 chunk_duration;
+
+   f32 begin_time;
+   f32 end_time;
+
+   u32 chunk_count;
+   RobotRecording_ChunkIndexEntry *chunks;
+
+   u32 summary_stream_count;
+   RecordingSummaryStream *summary_streams;
+};
+
+//NOTE: only used if the recording never got ended, rebuilds the index by hopping from chunk to chunk
+//      & stops at the first chunk that got cut off
+void RebuildRecordingIndex(RobotRecording *rec, buffer file, MemoryArena *arena) {
+   u64 first_chunk_offset = file.offset;
+   u32 chunk_count = 0;
+   while((file.size - file.offset) >= sizeof(RobotRecording_Chunk)) {
+      RobotRecording_Chunk *chunk = PeekStruct(&file, RobotRecording_Chunk);
+      if((file.size - file.offset - sizeof(RobotRecording_Chunk)) < chunk->size)
+         break;
+
+      file.offset += sizeof(RobotRecording_Chunk) + chunk->size;
+      chunk_count++;
+   }
+
+   rec->chunk_count = chunk_count;
+   rec->chunks = PushArray(arena, RobotRecording_ChunkIndexEntry, chunk_count);
+   file.offset = first_chunk_offset;
+   for(u32 i = 0; i < chunk_count; i++) {
+      RobotRecording_Chunk *chunk = PeekStruct(&file, RobotRecording_Chunk);
+      rec->chunks[i].offset = file.offset;
+      rec->chunks[i].begin_time = chunk->begin_time;
+      rec->chunks[i].end_time = chunk->end_time;
+      file.offset += sizeof(RobotRecording_Chunk) + chunk->size;
+   }
+}
+
+void ReadRecordingSummaries(RobotRecording *rec, buffer file, u64 summary_offset, MemoryArena *arena) {
+   file.offset = summary_offset;
+   RobotRecording_SummaryIndex *index_header = ConsumeStruct(&file, RobotRecording_SummaryIndex);
+   rec->summary_stream_count = index_header->stream_count;
+   rec->summary_streams = PushArray(arena, RecordingSummaryStream, index_header->stream_count);
+
+   for(u32 i = 0; i < index_header->stream_count; i++) {
+      RecordingSummaryStream *stream = rec->summary_streams + i;
+      RobotRecording_SummaryStream *stream_header = ConsumeStruct(&file, RobotRecording_SummaryStream);
+      stream->group_name = ConsumeString(&file, stream_header->group_name_length);
+      stream->name = ConsumeString(&file, stream_header->name_length);
+      stream->unit = (North_Unit::type) stream_header->unit;
+      stream->sample_count = stream_header->sample_count;
+      stream->level_count = stream_header->level_count;
+      stream->levels = PushArray(arena, RecordingSummaryLevel, stream_header->level_count);
+
+      for(u32 j = 0; j < stream_header->level_count; j++) {
+         RobotRecording_SummaryLevel *level_header = ConsumeStruct(&file, RobotRecording_SummaryLevel);
+         stream->levels[j].bucket_size = index_header->base_bucket_size << j;
+         stream->levels[j].bucket_count = level_header->bucket_count;
+         stream->levels[j].buckets = ConsumeArray(&file, RobotRecording_DiagnosticSummary, level_header->bucket_count);
+      }
+   }
+}
+
+//NOTE: arena is used for the summary streams & the index if it has to be rebuilt
+//NOTE: rec->file.data has to have passed ValidateRecordingFile
+void ParseRecording(RobotRecording *rec, MemoryArena *arena) {
+   buffer file = rec->file.data;
+   ConsumeStruct(&file, FileHeader);
+   RobotRecording_FileHeader *header = ConsumeStruct(&file, RobotRecording_FileHeader);
+   rec->timestamp = header->timestamp;
+   rec->robot_name = ConsumeString(&file, header->robot_name_length);
+   rec->robot_size = V2(header->robot_width, header->robot_length);
+   rec->chunk_duration = header->chunk_duration;
+
+   if(header->chunk_index_offset != 0) {
+      buffer index = file;
+      index.offset = header->chunk_index_offset;
+      RobotRecording_ChunkIndex *index_header = ConsumeStruct(&index, RobotRecording_ChunkIndex);
+      rec->chunk_count = index_header->chunk_count;
+      rec->chunks = ConsumeArray(&index, RobotRecording_ChunkIndexEntry, index_header->chunk_count);
+   } else {
+      RebuildRecordingIndex(rec, file, arena);
+   }
+
+   if(header->summary_offset != 0)
+      ReadRecordingSummaries(rec, file, header->summary_offset, arena);
+
+   if(rec->chunk_count > 0) {
+      rec->begin_time = rec->chunks[0].begin_time;
+      rec->end_time = rec->chunks[rec->chunk_count - 1].end_time;
+   }
+}
+
+bool OpenRecording(RobotRecording *rec, string file_name, MemoryArena *arena = __temp_arena) {
+   *rec = {};
+   rec->file = MapEntireFile(file_name);
+   if(!ValidateRecordingFile(rec->file.data)) {
+      UnmapFile(&rec->file);
+      return false;
+   }
+
+   ParseRecording(rec, arena);
+   return true;
+}
+
+void CloseRecording(RobotRecording *rec) {
+   UnmapFile(&rec->file);
+   *rec = {};
+}
+
+//NOTE: returns the last chunk that begins at or before time (0 if time is before the recording)
+u32 FindRecordingChunk(RobotRecording *rec, f32 time) {
+   Assert(rec->chunk_count > 0);
+   u32 low = 0;
+   u32 high = rec->chunk_count - 1;
+   while(low < high) {
+      u32 mid = (low + high + 1) / 2;
+      if(rec->chunks[mid].begin_time <= time) {
+         low = mid;
+      } else {
+         high = mid - 1;
+      }
+   }
+
+   return low;
+}
+
+RecordingGroup ReadRecordingGroup(buffer *chunk, MemoryArena *arena) {
+   RecordingGroup result = {};
+   RobotRecording_Group *group = ConsumeStruct(chunk, RobotRecording_Group);
+   result.name = ConsumeString(chunk, group->name_length);
+
+   result.diagnostic_count = group->diagnostic_count;
+   result.diagnostics = PushArray(arena, RecordingDiagnostic, group->diagnostic_count);
+   for(u32 i = 0; i < group->diagnostic_count; i++) {
+      RobotRecording_Diagnostic *diag = ConsumeStruct(chunk, RobotRecording_Diagnostic);
+      result.diagnostics[i].name = ConsumeString(chunk, diag->name_length);
+      result.diagnostics[i].unit = (North_Unit::type) diag->unit;
+      result.diagnostics[i].sample_count = diag->sample_count;
+      result.diagnostics[i].samples = PushArray(arena, RobotRecording_DiagnosticSample, diag->sample_count);
+      ReadDiagnosticColumns(chunk, result.diagnostics[i].samples, diag->sample_count);
+   }
+
+   result.message_count = group->message_count;
+   result.messages = PushArray(arena, RecordingMessage, group->message_count);
+   for(u32 i = 0; i < group->message_count; i++) {
+      RobotRecording_Message *message = ConsumeStruct(chunk, RobotRecording_Message);
+      result.messages[i].type = (North_MessageType::type) message->type;
+      result.messages[i].text = ConsumeString(chunk, message->length);
+      result.messages[i].begin_time = message->begin_time;
+      result.messages[i].end_time = message->end_time;
+   }
+
+   result.marker_count = group->marker_count;
+   result.markers = PushArray(arena, RecordingMarker, group->marker_count);
+   for(u32 i = 0; i < group->marker_count; i++) {
+      RobotRecording_Marker *marker = ConsumeStruct(chunk, RobotRecording_Marker);
+      result.markers[i].pos = marker->pos;
+      result.markers[i].text = ConsumeString(chunk, marker->length);
+      result.markers[i].begin_time = marker->begin_time;
+      result.markers[i].end_time = marker->end_time;
+   }
+
+   result.path_count = group->path_count;
+   result.paths = PushArray(arena, RecordingPath, group->path_count);
+   for(u32 i = 0; i < group->path_count; i++) {
+      RobotRecording_Path *path = ConsumeStruct(chunk, RobotRecording_Path);
+      result.paths[i].text = ConsumeString(chunk, path->length);
+      result.paths[i].control_point_count = path->control_point_count;
+      result.paths[i].control_points = ConsumeArray(chunk, North_HermiteControlPoint, path->control_point_count);
+      result.paths[i].begin_time = path->begin_time;
+      result.paths[i].end_time = path->end_time;
+   }
+
+   return result;
+}
+
+//NOTE: a chunk that doesnt validate comes back empty
+RecordingChunk ReadRecordingChunk(RobotRecording *rec, u32 chunk_i, MemoryArena *arena = __temp_arena) {
+   Assert(chunk_i < rec->chunk_count);
+   if(!ValidateRecordingChunk(rec->file.data, rec->chunks[chunk_i].offset)) {
+      RecordingChunk result = {};
+      result.begin_time = rec->chunks[chunk_i].begin_time;
+      result.end_time = rec->chunks[chunk_i].end_time;
+      return result;
+   }
+
+   buffer chunk = rec->file.data;
+   chunk.offset = rec->chunks[chunk_i].offset;
+   RobotRecording_Chunk *header = ConsumeStruct(&chunk, RobotRecording_Chunk);
+   chunk.size = chunk.offset + header->size;
+
+   RecordingChunk result = {};
+   result.begin_time = header->begin_time;
+   result.end_time = header->end_time;
+   result.robot_state_count = header->robot_state_sample_count;
+   result.robot_states = PushArray(arena, RobotRecording_RobotStateSample, header->robot_state_sample_count);
+   ReadRobotStateColumns(&chunk, result.robot_states, header->robot_state_sample_count);
+
+   result.group_count = header->group_count + 1;
+   result.groups = PushArray(arena, RecordingGroup, result.group_count);
+   for(u32 i = 0; i < result.group_count; i++) {
+      result.groups[i] = ReadRecordingGroup(&chunk, arena);
+   }
+
+   return result;
+}
+
+//NOTE: only touches the chunks that overlap [begin_time, end_time]
+u32 ReadRobotStates(RobotRecording *rec, f32 begin_time, f32 end_time,
+                    RobotRecording_RobotStateSample **samples, MemoryArena *arena = __temp_arena)
+{
+   *samples = NULL;
+   if(rec->chunk_count == 0)
+      return 0;
+
+   u32 first_chunk = FindRecordingChunk(rec, begin_time);
+   u32 last_chunk = FindRecordingChunk(rec, end_time);
+
+   //NOTE: chunks that dont validate get skipped in both passes
+   bool *chunk_valid = PushArray(arena, bool, last_chunk - first_chunk + 1);
+   u32 count = 0;
+   for(u32 i = first_chunk; i <= last_chunk; i++) {
+      chunk_valid[i - first_chunk] = ValidateRecordingChunk(rec->file.data, rec->chunks[i].offset);
+      if(chunk_valid[i - first_chunk]) {
+         RobotRecording_Chunk *header = (RobotRecording_Chunk *) (rec->file.data.data + rec->chunks[i].offset);
+         count += header->robot_state_sample_count;
+      }
+   }
+
+   RobotRecording_RobotStateSample *result = PushArray(arena, RobotRecording_RobotStateSample, count);
+   u32 result_count = 0;
+   for(u32 i = first_chunk; i <= last_chunk; i++) {
+      if(!chunk_valid[i - first_chunk])
+         continue;
+
+      buffer chunk = rec->file.data;
+      chunk.offset = rec->chunks[i].offset;
+      RobotRecording_Chunk *header = ConsumeStruct(&chunk, RobotRecording_Chunk);
+
+      //NOTE: decode the whole chunk past the samples we've kept, then only keep the ones in range
+      RobotRecording_RobotStateSample *chunk_samples = result + result_count;
+      ReadRobotStateColumns(&chunk, chunk_samples, header->robot_state_sample_count);
+      for(u32 j = 0; j < header->robot_state_sample_count; j++) {
+         RobotRecording_RobotStateSample sample = chunk_samples[j];
+         if((sample.time >= begin_time) && (sample.time <= end_time))
+            result[result_count++] = sample;
+      }
+   }
+
+   *samples = result;
+   return result_count;
+}
+RecordingSummaryStream *GetRecordingSummary(RobotRecording *rec, string group_name, string name) {
+   for(u32 i = 0; i < rec->summary_stream_count; i++) {
+      RecordingSummaryStream *stream = rec->summary_streams + i;
+      if((stream->group_name == group_name) && (stream->name == name))
+         return stream;
+   }
+
+   return NULL;
+}
+
+//NOTE: first bucket that ends at or after time
+u32 FindSummaryBucketEndingAfter(RecordingSummaryLevel *level, f32 time) {
+   u32 low = 0;
+   u32 high = level->bucket_count;
+   while(low < high) {
+      u32 mid = (low + high) / 2;
+      if(level->buckets[mid].end_time < time) {
+         low = mid + 1;
+      } else {
+         high = mid;
+      }
+   }
+
+   return low;
+}
+
+//NOTE: first bucket that begins after time
+u32 FindSummaryBucketBeginningAfter(RecordingSummaryLevel *level, f32 time) {
+   u32 low = 0;
+   u32 high = level->bucket_count;
+   while(low < high) {
+      u32 mid = (low + high) / 2;
+      if(level->buckets[mid].begin_time <= time) {
+         low = mid + 1;
+      } else {
+         high = mid;
+      }
+   }
+
+   return low;
+}
+
+//NOTE: picks the finest level that covers [begin_time, end_time] in max_buckets or less,
+//      eg. max_buckets = width of the graph in pixels. buckets point into the mapped file
+u32 ReadDiagnosticSummary(RecordingSummaryStream *stream, f32 begin_time, f32 end_time, u32 max_buckets,
+                          RobotRecording_DiagnosticSummary **buckets, u32 *bucket_size = NULL)
+{
+   *buckets = NULL;
+   for(u32 i = 0; i < stream->level_count; i++) {
+      RecordingSummaryLevel *level = stream->levels + i;
+      u32 first = FindSummaryBucketEndingAfter(level, begin_time);
+      u32 last = FindSummaryBucketBeginningAfter(level, end_time);
+      u32 count = (last > first) ? (last - first) : 0;
+
+      if((count <= max_buckets) || (i == (stream->level_count - 1))) {
+         *buckets = level->buckets + first;
+         if(bucket_size)
+            *bucket_size = level->bucket_size;
+         return count;
+      }
+   }
+
+   return 0;
+}
+//RECORDING-READER------------------------------------------
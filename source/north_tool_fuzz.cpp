@@ -0,0 +1,1078 @@
+//NOTE: north_tool --fuzz, runs every seed in data/fuzz (or any directory of North files) through its validator,
+//      then every prefix of it & a bunch of randomly mutated copies. anything that validates also gets parsed
+//      & re-encoded, so a validator that lets through something the parser cant handle crashes here instead of
+//      in the editor. the mutations are seeded from the file name so runs are repeatable
+//      it also records a file through the RobotRecorder & reads it back first, see FuzzRecorderRoundTrip
+
+#define FUZZ_DEFAULT_MUTATION_COUNT 2000
+#define FUZZ_MAX_PREFIX_COUNT 4096
+
+namespace FuzzFormat {
+   enum type {
+      Unknown,
+      Settings,
+      Field,
+      RobotProfile,
+      AutoProject,
+      AutoProjectIndex,
+      AutoProjectJournal,
+      Recording,
+      Packet, //NOTE: a whole packet, PacketHeader included
+   };
+};
+
+struct FuzzSeed {
+   string file_name;
+   FuzzFormat::type format;
+   buffer data;
+
+   //NOTE: the .ncap with the same name, journal records get applied on top of it
+   buffer journal_base;
+};
+
+struct FuzzResult {
+   u32 variant_count;
+   u32 valid_count;
+   u32 failure_count; //NOTE: something validated but didnt survive the round trip
+   string first_failure;
+};
+
+struct FuzzState {
+   MemoryArena *scratch_arena; //NOTE: reset after every variant
+   buffer state_schema; //NOTE: body of the first StateSchema seed, State_V2 variants get checked against it
+   FuzzResult *result;
+};
+
+FuzzFormat::type GetFuzzFormat(string file_name) {
+   string extension = (file_name.length >= 5) ? String(file_name.text + file_name.length - 5, 5) : EMPTY_STRING;
+   if(extension == Literal(".ncsf")) return FuzzFormat::Settings;
+   if(extension == Literal(".ncff")) return FuzzFormat::Field;
+   if(extension == Literal(".ncrp")) return FuzzFormat::RobotProfile;
+   if(extension == Literal(".ncap")) return FuzzFormat::AutoProject;
+   if(extension == Literal(".ncai")) return FuzzFormat::AutoProjectIndex;
+   if(extension == Literal(".ncaj")) return FuzzFormat::AutoProjectJournal;
+   if(extension == Literal(".ncrr")) return FuzzFormat::Recording;
+   if((file_name.length >= 7) && (String(file_name.text + file_name.length - 7, 7) == Literal(".packet")))
+      return FuzzFormat::Packet;
+   return FuzzFormat::Unknown;
+}
+
+void FuzzFailure(FuzzState *state, char *what) {
+   if(state->result->failure_count++ == 0)
+      state->result->first_failure = Literal(what);
+}
+
+//NOTE: doesnt go through MapEntireFile so theres nothing to unmap, the data stays owned by the caller
+MappedFile FuzzMappedFile(buffer data) {
+   MappedFile result = {};
+   result.data = data;
+   return result;
+}
+
+//NOTE: the encoders leave offset at the end of what they wrote, this is what a reader would see
+bool ValidateEncoded(bool (*validate)(buffer), buffer encoded) {
+   return validate(Buffer(encoded.offset, encoded.data));
+}
+
+bool FuzzSettings(FuzzState *state, buffer file) {
+   if(!ValidateSettingsFile(file))
+      return false;
+
+   ConsumeStruct(&file, FileHeader);
+   Settings_FileHeader *header = ConsumeStruct(&file, Settings_FileHeader);
+   string field_name = ConsumeString(&file, header->field_name_length);
+   if(!ValidateEncoded(ValidateSettingsFile, EncodeSettingsFile(header->team_number, field_name)))
+      FuzzFailure(state, "re-encoded settings dont validate");
+   return true;
+}
+
+bool FuzzField(FuzzState *state, buffer file) {
+   if(!ValidateFieldFile(file))
+      return false;
+
+   buffer data = file;
+   FileHeader *numbers = ConsumeStruct(&data, FileHeader);
+   if(numbers->version_number == FIELD_V0_VERSION) {
+      if(!ValidateEncoded(ValidateFieldFile, UpgradeFieldFile(file)))
+         FuzzFailure(state, "upgraded field doesnt validate");
+   } else {
+      Field_FileHeader *header = ConsumeStruct(&data, Field_FileHeader);
+      Field_ImageLevel *levels = ConsumeArray(&data, Field_ImageLevel, header->image_level_count);
+
+      //NOTE: bad tiles are allowed to fail decoding, they just cant crash it
+      for(u32 i = 0; i < header->image_level_count; i++) {
+         u32 *texels = PushTempArray(u32, levels[i].width * levels[i].height);
+         DecodeFieldImageLevel(file, levels + i, texels);
+      }
+   }
+
+   return true;
+}
+
+bool FuzzRobotProfile(FuzzState *state, buffer file) {
+   if(!ValidateRobotProfileFile(file))
+      return false;
+
+   RobotProfile profile = {};
+   profile.arena = state->scratch_arena;
+   ParseProfileFile(&profile, file, Literal("fuzz"));
+
+   buffer sizer = {};
+   EncodeProfileFile(&profile, &sizer);
+   buffer new_file = PushTempBuffer(sizer.offset);
+   EncodeProfileFile(&profile, &new_file);
+   if(!ValidateEncoded(ValidateRobotProfileFile, new_file))
+      FuzzFailure(state, "re-encoded profile doesnt validate");
+   return true;
+}
+
+bool FuzzAutoProject(FuzzState *state, buffer file) {
+   if(!ValidateAutoProjectFile(file))
+      return false;
+
+   AutoProjectLink *view = ParseAutoProjectView(FuzzMappedFile(file), Literal("fuzz"), __temp_arena);
+   AutoProjectLink *project = CopyAutoProject(view, __temp_arena);
+   if(!ValidateEncoded(ValidateAutoProjectFile, EncodeAutoProject(project)) ||
+      !ValidateEncoded(ValidateAutoProjectFile, EncodeAutoProject(project, AutoProjectFileEncoding(true))))
+   {
+      FuzzFailure(state, "re-encoded project doesnt validate");
+   }
+
+   FreeAutoProject(project);
+   FreeAutoNode(view->starting_node);
+   return true;
+}
+
+//NOTE: same checks OpenAutoProjectJournal does, except the project hash (no mutation would ever match it),
+//      only valid if every record is
+bool FuzzAutoProjectJournal(FuzzState *state, buffer file, buffer base) {
+   FileHeader *file_numbers = ValidateStruct(&file, FileHeader);
+   if((file_numbers == NULL) || (file_numbers->magic_number != AUTONOMOUS_PROGRAM_JOURNAL_MAGIC_NUMBER) ||
+      !ValidateAutoProjectVersion(file_numbers->version_number) ||
+      (ValidateStruct(&file, AutonomousProgramJournal_FileHeader) == NULL))
+   {
+      return false;
+   }
+
+   u32 version = file_numbers->version_number;
+   AutoProjectLink *project = NULL;
+   if((base.data != NULL) && ValidateAutoProjectFile(base)) {
+      AutoProjectLink *view = ParseAutoProjectView(FuzzMappedFile(base), Literal("fuzz"), __temp_arena);
+      project = CopyAutoProject(view, __temp_arena);
+      FreeAutoNode(view->starting_node);
+   }
+
+   bool valid = true;
+   while(file.offset < file.size) {
+      buffer record = file;
+      if(!ValidateAutoProjectJournalRecord(&file, version)) {
+         valid = false;
+         break;
+      }
+
+      if((project != NULL) && !ApplyAutoProjectJournalRecord(project, &record, __temp_arena, version))
+         break;
+   }
+
+   if((project != NULL) && !ValidateEncoded(ValidateAutoProjectFile, EncodeAutoProject(project)))
+      FuzzFailure(state, "project doesnt validate after replaying the journal");
+
+   FreeAutoProject(project);
+   return valid;
+}
+
+bool FuzzRecording(FuzzState *state, buffer file) {
+   if(!ValidateRecordingFile(file))
+      return false;
+
+   RobotRecording rec = {};
+   rec.file = FuzzMappedFile(file);
+   ParseRecording(&rec, __temp_arena);
+
+   for(u32 i = 0; i < rec.chunk_count; i++) {
+      ReadRecordingChunk(&rec, i, state->scratch_arena);
+   }
+
+   RobotRecording_RobotStateSample *samples = NULL;
+   ReadRobotStates(&rec, rec.begin_time, rec.end_time, &samples, state->scratch_arena);
+   return true;
+}
+
+bool FuzzPacket(FuzzState *state, buffer file) {
+   PacketHeader *header = ValidateStruct(&file, PacketHeader);
+   if((header == NULL) || (header->size != (file.size - file.offset)))
+      return false;
+
+   PacketType::type type = (PacketType::type) header->type;
+   buffer packet = {};
+   packet.data = file.data + file.offset;
+   packet.size = header->size;
+   if(!ValidatePacket(type, packet))
+      return false;
+
+   //NOTE: Welcome & CurrentParameters write the robot's .ncrp when they're recieved, so those only get validated
+   RobotProfile profile = {};
+   profile.arena = state->scratch_arena;
+   profile.schema_arena = state->scratch_arena;
+   switch(type) {
+      case PacketType::StateSchema: {
+         RecieveStateSchemaPacket(&profile, packet);
+      } break;
+
+      case PacketType::State_V2: {
+         if(state->state_schema.data != NULL)
+            RecieveStateSchemaPacket(&profile, state->state_schema);
+         RecieveStateV2Packet(&profile, packet);
+      } break;
+
+      case PacketType::UploadAutonomous: {
+         ConsumeStruct(&packet, UploadAutonomous_PacketHeader);
+         ParseAutoNode(&packet, __temp_arena, AUTONOMOUS_PROGRAM_V0_VERSION);
+      } break;
+
+      case PacketType::UploadAutonomous_V1: {
+         ConsumeStruct(&packet, UploadAutonomous_V1_PacketHeader);
+         ParseAutoNode(&packet, __temp_arena, AUTONOMOUS_PROGRAM_CURR_VERSION);
+      } break;
+
+      default: break;
+   }
+
+   return true;
+}
+
+//NOTE: returns whether data validated
+bool FuzzVariant(FuzzState *state, FuzzSeed *seed, buffer data) {
+   state->result->variant_count++;
+
+   bool valid = false;
+   switch(seed->format) {
+      case FuzzFormat::Settings: valid = FuzzSettings(state, data); break;
+      case FuzzFormat::Field: valid = FuzzField(state, data); break;
+      case FuzzFormat::RobotProfile: valid = FuzzRobotProfile(state, data); break;
+      case FuzzFormat::AutoProject: valid = FuzzAutoProject(state, data); break;
+      case FuzzFormat::AutoProjectIndex: valid = ValidateAutoProjectIndexFile(data); break;
+      case FuzzFormat::AutoProjectJournal: valid = FuzzAutoProjectJournal(state, data, seed->journal_base); break;
+      case FuzzFormat::Recording: valid = FuzzRecording(state, data); break;
+      case FuzzFormat::Packet: valid = FuzzPacket(state, data); break;
+      default: break;
+   }
+
+   Reset(state->scratch_arena);
+   Reset(__temp_arena);
+
+   if(valid)
+      state->result->valid_count++;
+   return valid;
+}
+
+//NOTE: xorshift, just needs to be repeatable
+u32 NextFuzzRandom(u64 *random) {
+   u64 x = *random;
+   x ^= x << 13;
+   x ^= x >> 7;
+   x ^= x << 17;
+   *random = x;
+   return (u32) (x >> 32);
+}
+
+void MutateFuzzBuffer(u8 *data, u64 size, u64 *random) {
+   u8 interesting_bytes[] = { 0x00, 0x01, 0x7F, 0x80, 0xFF };
+   u32 interesting_words[] = { 0, 1, 0xFF, 0x100, 0xFFFF, 0x10000, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, 0x7FC00000 /*NaN*/ };
+
+   u32 mutation_count = 1 + (NextFuzzRandom(random) % 4);
+   for(u32 i = 0; i < mutation_count; i++) {
+      u64 offset = NextFuzzRandom(random) % size;
+      switch(NextFuzzRandom(random) % 3) {
+         case 0: {
+            data[offset] ^= (u8) (1 << (NextFuzzRandom(random) % 8));
+         } break;
+
+         case 1: {
+            data[offset] = interesting_bytes[NextFuzzRandom(random) % ArraySize(interesting_bytes)];
+         } break;
+
+         case 2: {
+            if(size >= sizeof(u32)) {
+               u32 word = interesting_words[NextFuzzRandom(random) % ArraySize(interesting_words)];
+               Copy(&word, sizeof(u32), data + Min(offset, size - sizeof(u32)));
+            }
+         } break;
+      }
+   }
+}
+
+FuzzResult FuzzSeedFile(FuzzState *state, FuzzSeed *seed, u32 mutation_count, MemoryArena *arena) {
+   FuzzResult result = {};
+   result.first_failure = EMPTY_STRING;
+   state->result = &result;
+
+   if(!FuzzVariant(state, seed, seed->data))
+      FuzzFailure(state, "seed doesnt validate");
+
+   //NOTE: every prefix, like a file that got cut off while it was being written
+   u64 prefix_step = Max((u64) 1, seed->data.size / FUZZ_MAX_PREFIX_COUNT);
+   for(u64 size = 0; size < seed->data.size; size += prefix_step) {
+      buffer prefix = seed->data;
+      prefix.size = size;
+      FuzzVariant(state, seed, prefix);
+   }
+
+   u64 random = 0x9E3779B97F4A7C15 ^ Hash(seed->file_name);
+   buffer mutated = PushBuffer(arena, seed->data.size);
+   mutated.size = seed->data.size;
+   for(u32 i = 0; (i < mutation_count) && (seed->data.size > 0); i++) {
+      Copy(seed->data.data, seed->data.size, mutated.data);
+      MutateFuzzBuffer(mutated.data, mutated.size, &random);
+      FuzzVariant(state, seed, mutated);
+   }
+
+   state->result = NULL;
+   return result;
+}
+
+//RECORDER-ROUND-TRIP---------------------------------------
+//NOTE: nothing records yet (the editor isnt hooked up), so this is what runs the writer. synthetic State & State_V2
+//      packets go through a RobotRecorder & the file gets read back & compared against what was sent,
+//      afterwards the file is fuzzed like any other seed
+#define FUZZ_RECORDING_FILE_NAME "fuzz_recorder.tmp"
+#define FUZZ_RECORDING_PACKET_COUNT 1111
+#define FUZZ_RECORDING_V2_START 600 //NOTE: packets before this are State, the rest are State_V2
+#define FUZZ_RECORDING_WIDE_PACKETS 200 //NOTE: the first packets also have a group with more diagnostics than a u8
+#define FUZZ_RECORDING_WIDE_COUNT 300
+#define FUZZ_RECORDING_CHUNK_DURATION 5 //NOTE: 250 samples a chunk, not a multiple of PACKED_BLOCK_SIZE
+#define FUZZ_RECORDING_SCHEMA_ID 3
+
+//NOTE: [first, last] packet of each run of the same message/marker, far enough apart that they dont get coalesced
+u32 fuzz_recording_message_runs[][2] = { {50, 74}, {90, 99} };
+u32 fuzz_recording_marker_runs[][2] = { {700, 719} };
+#define FUZZ_RECORDING_PATH_PACKET 10
+
+struct FuzzRecordedStream {
+   string group_name;
+   string name;
+   North_Unit::type unit;
+   u32 sample_count;
+   RobotRecording_DiagnosticSample *samples;
+   u32 read_count; //NOTE: how many have been compared so far
+};
+
+//NOTE: everything the recording should have in it, streams[0-2] are battery, drive/left & drive/right, then the wide ones
+struct FuzzRecordingModel {
+   u32 robot_state_count;
+   RobotRecording_RobotStateSample *robot_states;
+   u32 chunk_count;
+
+   u32 stream_count;
+   FuzzRecordedStream *streams;
+   North_HermiteControlPoint path[2];
+};
+
+f32 FuzzRecordingTime(u32 packet_i) {
+   return (f32) packet_i / 50;
+}
+
+bool InFuzzRecordingRun(u32 runs[][2], u32 run_count, u32 packet_i) {
+   for(u32 i = 0; i < run_count; i++) {
+      if((packet_i >= runs[i][0]) && (packet_i <= runs[i][1]))
+         return true;
+   }
+   return false;
+}
+
+void InitFuzzRecordedStream(FuzzRecordedStream *stream, string group_name, string name, North_Unit::type unit, MemoryArena *arena) {
+   stream->group_name = group_name;
+   stream->name = name;
+   stream->unit = unit;
+   stream->samples = PushArray(arena, RobotRecording_DiagnosticSample, FUZZ_RECORDING_PACKET_COUNT);
+}
+
+void AddFuzzRecordedSample(FuzzRecordedStream *stream, f32 value, f32 time) {
+   RobotRecording_DiagnosticSample sample = { value, time };
+   stream->samples[stream->sample_count++] = sample;
+}
+
+FuzzRecordedStream *GetFuzzRecordedStream(FuzzRecordingModel *model, string group_name, string name) {
+   for(u32 i = 0; i < model->stream_count; i++) {
+      if((model->streams[i].group_name == group_name) && (model->streams[i].name == name))
+         return model->streams + i;
+   }
+   return NULL;
+}
+
+void WriteFuzzStateDiagnostic(buffer *b, FuzzRecordedStream *stream, f32 value) {
+   WriteStructData(b, State_Diagnostic, diag, {
+      diag.name_length = stream->name.length;
+      diag.value = value;
+      diag.unit = (u8) stream->unit;
+   });
+   WriteString(b, stream->name);
+}
+
+buffer MakeFuzzStatePacket(FuzzRecordingModel *model, u32 packet_i, f32 *values, v2 pos, f32 angle) {
+   f32 time = FuzzRecordingTime(packet_i);
+   bool wide = packet_i < FUZZ_RECORDING_WIDE_PACKETS;
+   bool message = InFuzzRecordingRun(fuzz_recording_message_runs, ArraySize(fuzz_recording_message_runs), packet_i);
+   bool path = packet_i == FUZZ_RECORDING_PATH_PACKET;
+
+   buffer b = PushTempBuffer(Kilobyte(16));
+   WriteStructData(&b, State_PacketHeader, header, {
+      header.pos = pos;
+      header.angle = angle;
+      header.group_count = wide ? 3 : 1;
+      header.time = time;
+   });
+
+   WriteStructData(&b, State_Group, default_group, {
+      default_group.diagnostic_count = 1;
+   });
+   WriteFuzzStateDiagnostic(&b, model->streams + 0, values[0]);
+
+   string drive = model->streams[1].group_name;
+   WriteStructData(&b, State_Group, drive_group, {
+      drive_group.name_length = drive.length;
+      drive_group.diagnostic_count = 2;
+      drive_group.message_count = message ? 1 : 0;
+      drive_group.path_count = path ? 1 : 0;
+   });
+   WriteString(&b, drive);
+   WriteFuzzStateDiagnostic(&b, model->streams + 1, values[1]);
+   WriteFuzzStateDiagnostic(&b, model->streams + 2, values[2]);
+   if(message) {
+      string text = Literal("auto started");
+      WriteStructData(&b, State_Message, state_message, {
+         state_message.type = North_MessageType::Warning;
+         state_message.length = text.length;
+      });
+      WriteString(&b, text);
+   }
+   if(path) {
+      string text = Literal("to the scale");
+      WriteStructData(&b, State_Path, state_path, {
+         state_path.length = text.length;
+         state_path.control_point_count = ArraySize(model->path);
+      });
+      WriteString(&b, text);
+      WriteArray(&b, model->path, ArraySize(model->path));
+   }
+
+   //NOTE: the same group twice, so the recorder ends up with FUZZ_RECORDING_WIDE_COUNT diagnostics in one group
+   if(wide) {
+      u32 half = FUZZ_RECORDING_WIDE_COUNT / 2;
+      for(u32 i = 0; i < 2; i++) {
+         string wide_name = model->streams[3].group_name;
+         WriteStructData(&b, State_Group, wide_group, {
+            wide_group.name_length = wide_name.length;
+            wide_group.diagnostic_count = half;
+         });
+         WriteString(&b, wide_name);
+         for(u32 j = 0; j < half; j++) {
+            WriteFuzzStateDiagnostic(&b, model->streams + 3 + i * half + j, values[3 + i * half + j]);
+         }
+      }
+   }
+
+   return Buffer(b.offset, b.data);
+}
+
+buffer MakeFuzzStateSchemaPacket(FuzzRecordingModel *model) {
+   buffer b = PushTempBuffer(Kilobyte(1));
+   WriteStructData(&b, StateSchema_PacketHeader, header, {
+      header.schema_id = FUZZ_RECORDING_SCHEMA_ID;
+      header.group_count = 1;
+   });
+
+   for(u32 i = 0; i < 3; i++) {
+      FuzzRecordedStream *stream = model->streams + i;
+      if(i != 2) {
+         WriteStructData(&b, StateSchema_Group, group, {
+            group.name_length = stream->group_name.length;
+            group.diagnostic_count = (i == 0) ? 1 : 2;
+         });
+         WriteString(&b, stream->group_name);
+      }
+
+      WriteStructData(&b, StateSchema_Diagnostic, diag, {
+         diag.name_length = stream->name.length;
+         diag.unit = (u8) stream->unit;
+      });
+      WriteString(&b, stream->name);
+   }
+
+   return Buffer(b.offset, b.data);
+}
+
+//NOTE: changed says which of the schema's 3 diagnostics are in the packet, values get rounded like the robot would
+buffer MakeFuzzStateV2Packet(u32 packet_i, u8 flags, bool *changed, f32 *values, v2 pos, f32 angle) {
+   bool marker = InFuzzRecordingRun(fuzz_recording_marker_runs, ArraySize(fuzz_recording_marker_runs), packet_i);
+
+   buffer b = PushTempBuffer(Kilobyte(1));
+   WriteStructData(&b, State_V2_PacketHeader, header, {
+      header.pos = pos;
+      header.angle = angle;
+      header.time = FuzzRecordingTime(packet_i);
+      header.schema_id = FUZZ_RECORDING_SCHEMA_ID;
+      header.flags = flags;
+   });
+
+   u32 changed_count = 0;
+   for(u32 i = 0; i < 3; i++) {
+      if(changed[i])
+         changed_count++;
+   }
+
+   WriteVarint(&b, changed_count);
+   s32 last_id = -1;
+   for(u32 i = 0; i < 3; i++) {
+      if(changed[i]) {
+         WriteVarint(&b, (last_id < 0) ? i : (i - last_id - 1));
+         last_id = i;
+      }
+   }
+
+   for(u32 i = 0; i < 3; i++) {
+      if(!changed[i])
+         continue;
+
+      if(flags & State_V2_Flags::F16_VALUES) {
+         u16 half = F32ToF16(values[i]);
+         WriteStruct(&b, &half);
+      } else {
+         WriteStruct(&b, values + i);
+      }
+   }
+
+   WriteVarint(&b, marker ? 1 : 0);
+   if(marker) {
+      string text = Literal("target");
+      WriteStructData(&b, State_V2_Group, group, {
+         group.group_id = 1;
+         group.marker_count = 1;
+      });
+      WriteStructData(&b, State_Marker, state_marker, {
+         state_marker.pos = V2(3, 4);
+         state_marker.length = text.length;
+      });
+      WriteString(&b, text);
+   }
+
+   return Buffer(b.offset, b.data);
+}
+
+//NOTE: records the packets & fills in the model with what should come back out
+void RecordFuzzPackets(FuzzState *state, RobotRecorder *rec, FuzzRecordingModel *model) {
+   RobotProfile profile = {};
+   profile.arena = state->scratch_arena;
+   profile.schema_arena = state->scratch_arena;
+
+   u64 random = 0x9E3779B97F4A7C15;
+   f32 values[3 + FUZZ_RECORDING_WIDE_COUNT] = {};
+   f32 chunk_begin_time = 0;
+   for(u32 i = 0; i < FUZZ_RECORDING_PACKET_COUNT; i++) {
+      Reset(__temp_arena);
+      f32 time = FuzzRecordingTime(i);
+      v2 pos = V2(10 * cosf(time), 10 * sinf(time));
+      f32 angle = 10 * time;
+
+      //NOTE: a noisy one, a smooth one & one that's all over the place
+      values[0] = 12 + 0.5f * sinf(time) + (f32) (NextFuzzRandom(&random) % 1000) / 10000;
+      values[1] = 4 * sinf(3 * time);
+      values[2] = (f32) (s32) NextFuzzRandom(&random) / 65536;
+      for(u32 j = 0; j < FUZZ_RECORDING_WIDE_COUNT; j++) {
+         values[3 + j] = (f32) (i + j) / 4;
+      }
+
+      if(i < FUZZ_RECORDING_V2_START) {
+         buffer packet = MakeFuzzStatePacket(model, i, values, pos, angle);
+         if(!ValidatePacket(PacketType::State, packet)) {
+            FuzzFailure(state, "recorded State packet doesnt validate");
+            return;
+         }
+
+         RecordStatePacket(rec, packet);
+         u32 stream_count = (i < FUZZ_RECORDING_WIDE_PACKETS) ? model->stream_count : 3;
+         for(u32 j = 0; j < stream_count; j++) {
+            AddFuzzRecordedSample(model->streams + j, values[j], time);
+         }
+      } else {
+         if(i == FUZZ_RECORDING_V2_START)
+            RecieveStateSchemaPacket(&profile, MakeFuzzStateSchemaPacket(model));
+
+         bool keyframe = (i == FUZZ_RECORDING_V2_START);
+         u8 flags = (keyframe ? State_V2_Flags::KEYFRAME : 0) | ((i % 2) ? State_V2_Flags::F16_VALUES : 0);
+         bool changed[3] = { true, keyframe || ((i % 2) == 0), keyframe || ((i % 3) == 0) };
+
+         buffer packet = MakeFuzzStateV2Packet(i, flags, changed, values, pos, angle);
+         if(!ValidatePacket(PacketType::State_V2, packet) || !RecieveStateV2Packet(&profile, packet) ||
+            !RecordStateV2Packet(rec, &profile.state_schema, packet))
+         {
+            FuzzFailure(state, "recorded State_V2 packet doesnt validate or match the schema");
+            return;
+         }
+
+         //NOTE: every diagnostic with a value gets a sample, whether it changed or not
+         for(u32 j = 0; j < 3; j++) {
+            RobotStateDiagnostic *diag = profile.state_schema.diagnostics + j;
+            f32 sent = (flags & State_V2_Flags::F16_VALUES) ? F16ToF32(F32ToF16(values[j])) : values[j];
+            if(changed[j] && (diag->value != sent))
+               FuzzFailure(state, "State_V2 value didnt make it into the schema");
+            AddFuzzRecordedSample(model->streams + j, diag->value, time);
+         }
+      }
+
+      RobotRecording_RobotStateSample sample = { pos, angle, time };
+      model->robot_states[model->robot_state_count++] = sample;
+
+      //NOTE: same test AdvanceRecorder does
+      if((i == 0) || (time >= (chunk_begin_time + FUZZ_RECORDING_CHUNK_DURATION))) {
+         chunk_begin_time = time;
+         model->chunk_count++;
+      }
+   }
+
+   Reset(state->scratch_arena);
+}
+
+//NOTE: compares every chunk against the model, the samples have to come back bit for bit
+void CheckFuzzRecordingChunks(FuzzState *state, RobotRecording *recording, FuzzRecordingModel *model) {
+   u32 robot_state_i = 0;
+   u32 message_count = 0;
+   u32 marker_count = 0;
+   u32 path_count = 0;
+   for(u32 i = 0; i < recording->chunk_count; i++) {
+      Reset(state->scratch_arena);
+      RecordingChunk chunk = ReadRecordingChunk(recording, i, state->scratch_arena);
+      if((chunk.robot_state_count == 0) || ((robot_state_i + chunk.robot_state_count) > model->robot_state_count) ||
+         (memcmp(chunk.robot_states, model->robot_states + robot_state_i,
+                 chunk.robot_state_count * sizeof(RobotRecording_RobotStateSample)) != 0))
+      {
+         FuzzFailure(state, "recorded robot states dont match");
+         return;
+      }
+      robot_state_i += chunk.robot_state_count;
+
+      for(u32 j = 0; j < chunk.group_count; j++) {
+         RecordingGroup *group = chunk.groups + j;
+         for(u32 k = 0; k < group->diagnostic_count; k++) {
+            RecordingDiagnostic *diag = group->diagnostics + k;
+            FuzzRecordedStream *stream = GetFuzzRecordedStream(model, group->name, diag->name);
+            if((stream == NULL) || (stream->unit != diag->unit) ||
+               ((stream->read_count + diag->sample_count) > stream->sample_count) ||
+               (memcmp(diag->samples, stream->samples + stream->read_count,
+                       diag->sample_count * sizeof(RobotRecording_DiagnosticSample)) != 0))
+            {
+               FuzzFailure(state, "recorded diagnostic samples dont match");
+               return;
+            }
+            stream->read_count += diag->sample_count;
+         }
+
+         //NOTE: each run of the same message/marker should have been coalesced into one
+         for(u32 k = 0; k < group->message_count; k++) {
+            RecordingMessage *message = group->messages + k;
+            u32 *run = fuzz_recording_message_runs[Min(message_count, (u32) ArraySize(fuzz_recording_message_runs) - 1)];
+            message_count++;
+            if((message->type != North_MessageType::Warning) || (message->text != Literal("auto started")) ||
+               (message->begin_time != FuzzRecordingTime(run[0])) || (message->end_time != FuzzRecordingTime(run[1])))
+            {
+               FuzzFailure(state, "recorded messages dont match");
+            }
+         }
+
+         for(u32 k = 0; k < group->marker_count; k++) {
+            RecordingMarker *marker = group->markers + k;
+            u32 *run = fuzz_recording_marker_runs[Min(marker_count, (u32) ArraySize(fuzz_recording_marker_runs) - 1)];
+            marker_count++;
+            if((marker->pos.x != 3) || (marker->pos.y != 4) || (marker->text != Literal("target")) ||
+               (marker->begin_time != FuzzRecordingTime(run[0])) || (marker->end_time != FuzzRecordingTime(run[1])))
+            {
+               FuzzFailure(state, "recorded markers dont match");
+            }
+         }
+
+         for(u32 k = 0; k < group->path_count; k++) {
+            RecordingPath *path = group->paths + k;
+            path_count++;
+            if((path->text != Literal("to the scale")) || (path->control_point_count != ArraySize(model->path)) ||
+               (memcmp(path->control_points, model->path, sizeof(model->path)) != 0) ||
+               (path->begin_time != FuzzRecordingTime(FUZZ_RECORDING_PATH_PACKET)))
+            {
+               FuzzFailure(state, "recorded paths dont match");
+            }
+         }
+      }
+   }
+
+   if(robot_state_i != model->robot_state_count)
+      FuzzFailure(state, "recording is missing robot states");
+
+   for(u32 i = 0; i < model->stream_count; i++) {
+      if(model->streams[i].read_count != model->streams[i].sample_count)
+         FuzzFailure(state, "recording is missing diagnostic samples");
+   }
+
+   if((message_count != ArraySize(fuzz_recording_message_runs)) ||
+      (marker_count != ArraySize(fuzz_recording_marker_runs)) || (path_count != 1))
+   {
+      FuzzFailure(state, "recording has the wrong number of messages, markers or paths");
+   }
+
+   Reset(state->scratch_arena);
+   RobotRecording_RobotStateSample *samples = NULL;
+   u32 sample_count = ReadRobotStates(recording, recording->begin_time, recording->end_time, &samples, state->scratch_arena);
+   if((sample_count != model->robot_state_count) ||
+      (memcmp(samples, model->robot_states, sample_count * sizeof(RobotRecording_RobotStateSample)) != 0))
+   {
+      FuzzFailure(state, "ReadRobotStates doesnt match");
+   }
+   Reset(state->scratch_arena);
+}
+
+//NOTE: brute force over the samples the bucket should cover, the mean only has to be close since the recorder
+//      keeps a running f32 mean & the levels above merge them
+bool FuzzSummaryBucketMatches(RobotRecording_DiagnosticSummary *bucket, FuzzRecordedStream *stream, u32 first_sample, u32 sample_count) {
+   RobotRecording_DiagnosticSample *samples = stream->samples + first_sample;
+   f32 min = samples[0].value;
+   f32 max = samples[0].value;
+   f64 sum = 0;
+   for(u32 i = 0; i < sample_count; i++) {
+      min = Min(min, samples[i].value);
+      max = Max(max, samples[i].value);
+      sum += samples[i].value;
+   }
+
+   f64 mean = sum / sample_count;
+   f64 mean_tolerance = 1e-4 * Max(1.0, Max(fabs(min), fabs(max)));
+   return (bucket->begin_time == samples[0].time) && (bucket->end_time == samples[sample_count - 1].time) &&
+          (bucket->min == min) && (bucket->max == max) && (fabs(bucket->mean - mean) <= mean_tolerance) &&
+          (bucket->first == samples[0].value) && (bucket->last == samples[sample_count - 1].value);
+}
+
+//NOTE: bucket_i of a level with bucket_size samples a bucket
+bool FuzzSummaryLevelBucketMatches(RobotRecording_DiagnosticSummary *bucket, FuzzRecordedStream *stream, u32 bucket_size, u32 bucket_i) {
+   u32 first_sample = bucket_i * bucket_size;
+   return (first_sample < stream->sample_count) &&
+          FuzzSummaryBucketMatches(bucket, stream, first_sample, Min(bucket_size, stream->sample_count - first_sample));
+}
+
+//NOTE: every level of every stream against the samples, then ReadDiagnosticSummary has to pick a level that fits
+//      max_buckets & return exactly the buckets that overlap the range
+void CheckFuzzRecordingSummaries(FuzzState *state, RobotRecording *recording, FuzzRecordingModel *model) {
+   if(recording->summary_stream_count != model->stream_count)
+      FuzzFailure(state, "recording has the wrong number of summary streams");
+
+   for(u32 i = 0; i < model->stream_count; i++) {
+      FuzzRecordedStream *stream = model->streams + i;
+      RecordingSummaryStream *summary = GetRecordingSummary(recording, stream->group_name, stream->name);
+      if((summary == NULL) || (summary->sample_count != stream->sample_count) || (summary->unit != stream->unit) ||
+         (summary->level_count == 0) || (summary->levels[summary->level_count - 1].bucket_count != 1))
+      {
+         FuzzFailure(state, "summary stream is missing or has the wrong shape");
+         return;
+      }
+
+      for(u32 j = 0; j < summary->level_count; j++) {
+         RecordingSummaryLevel *level = summary->levels + j;
+         if((level->bucket_size != ((u32) RECORDING_SUMMARY_BASE_BUCKET_SIZE << j)) ||
+            (level->bucket_count != ((stream->sample_count + level->bucket_size - 1) / level->bucket_size)))
+         {
+            FuzzFailure(state, "summary level has the wrong bucket size or count");
+            return;
+         }
+
+         for(u32 k = 0; k < level->bucket_count; k++) {
+            if(!FuzzSummaryLevelBucketMatches(level->buckets + k, stream, level->bucket_size, k)) {
+               FuzzFailure(state, "summary bucket doesnt match the samples");
+               return;
+            }
+         }
+      }
+
+      f32 ranges[][2] = {
+         { stream->samples[0].time, stream->samples[stream->sample_count - 1].time },
+         { stream->samples[stream->sample_count / 3].time, stream->samples[(2 * stream->sample_count) / 3].time },
+         { stream->samples[stream->sample_count / 2].time, stream->samples[stream->sample_count / 2].time },
+         //NOTE: from the end of one base bucket to the beginning of another
+         { stream->samples[RECORDING_SUMMARY_BASE_BUCKET_SIZE - 1].time, stream->samples[3 * RECORDING_SUMMARY_BASE_BUCKET_SIZE].time },
+      };
+      u32 max_bucket_counts[] = { 1, 4, 17, 1 << 20 };
+      for(u32 j = 0; j < ArraySize(ranges); j++) {
+         for(u32 k = 0; k < ArraySize(max_bucket_counts); k++) {
+            f32 begin_time = ranges[j][0];
+            f32 end_time = ranges[j][1];
+            RobotRecording_DiagnosticSummary *buckets = NULL;
+            u32 bucket_size = 0;
+            u32 count = ReadDiagnosticSummary(summary, begin_time, end_time, max_bucket_counts[k], &buckets, &bucket_size);
+
+            RecordingSummaryLevel *level = NULL;
+            for(u32 l = 0; l < summary->level_count; l++) {
+               if(summary->levels[l].bucket_size == bucket_size)
+                  level = summary->levels + l;
+            }
+
+            if((level == NULL) || (count == 0) ||
+               ((count > max_bucket_counts[k]) && (level != (summary->levels + summary->level_count - 1))))
+            {
+               FuzzFailure(state, "ReadDiagnosticSummary picked the wrong level");
+               return;
+            }
+
+            //NOTE: & it has to be the finest level that fits
+            if(level != summary->levels) {
+               RecordingSummaryLevel *finer = level - 1;
+               u32 finer_count = 0;
+               for(u32 l = 0; l < finer->bucket_count; l++) {
+                  if((finer->buckets[l].end_time >= begin_time) && (finer->buckets[l].begin_time <= end_time))
+                     finer_count++;
+               }
+
+               if(finer_count <= max_bucket_counts[k]) {
+                  FuzzFailure(state, "ReadDiagnosticSummary skipped a finer level that fits");
+                  return;
+               }
+            }
+
+            //NOTE: the buckets right outside the range shouldnt overlap it
+            u32 first = (u32) (buckets - level->buckets);
+            u32 last = first + count - 1;
+            if((buckets[0].end_time < begin_time) || (buckets[count - 1].begin_time > end_time) ||
+               ((first > 0) && (level->buckets[first - 1].end_time >= begin_time)) ||
+               (((last + 1) < level->bucket_count) && (level->buckets[last + 1].begin_time <= end_time)))
+            {
+               FuzzFailure(state, "ReadDiagnosticSummary returned the wrong buckets");
+               return;
+            }
+
+            for(u32 l = 0; l < count; l++) {
+               if(!FuzzSummaryLevelBucketMatches(buckets + l, stream, bucket_size, first + l)) {
+                  FuzzFailure(state, "ReadDiagnosticSummary bucket doesnt match the samples");
+                  return;
+               }
+            }
+         }
+      }
+   }
+}
+
+namespace FuzzColumnKind {
+   enum type {
+      Timestamps,
+      Noisy,
+      RandomBits, //NOTE: every block ends up 32 bits wide
+      Constant, //NOTE: every block ends up 0 bits wide
+      Count
+   };
+};
+
+//NOTE: WritePackedColumn then ReadPackedColumn has to give back the exact bits, for counts that arent a multiple
+//      of PACKED_BLOCK_SIZE & with a stride, both orders have to come up somewhere
+void CheckFuzzPackedColumns(FuzzState *state) {
+   u32 counts[] = { 0, 1, 2, 3, PACKED_BLOCK_SIZE - 1, PACKED_BLOCK_SIZE + 1, 300, FUZZ_RECORDING_PACKET_COUNT };
+   u32 strides[] = { 1, 3 };
+   u32 sentinel = 0xDEADBEEF;
+   u32 orders_seen = 0;
+
+   u64 random = 0x2545F4914F6CDD1D;
+   for(u32 kind = 0; kind < FuzzColumnKind::Count; kind++) {
+      for(u32 i = 0; i < ArraySize(counts); i++) {
+         for(u32 j = 0; j < ArraySize(strides); j++) {
+            Reset(__temp_arena);
+            u32 count = counts[i];
+            u32 stride = strides[j];
+            u32 *values = PushTempArray(u32, count * stride + 1);
+            u32 *decoded = PushTempArray(u32, count * stride + 1);
+            for(u32 k = 0; k < (count * stride); k++) {
+               f32 time = 100 + FuzzRecordingTime(k / stride);
+               f32 value = 0;
+               switch(kind) {
+                  case FuzzColumnKind::Timestamps: value = time; break;
+                  case FuzzColumnKind::Noisy: value = sinf(time) + (f32) (NextFuzzRandom(&random) % 1000) / 1000; break;
+                  case FuzzColumnKind::Constant: value = 42; break;
+               }
+
+               values[k] = (kind == FuzzColumnKind::RandomBits) ? NextFuzzRandom(&random) : 0;
+               if(kind != FuzzColumnKind::RandomBits)
+                  Copy(&value, sizeof(u32), values + k);
+               decoded[k] = sentinel;
+            }
+
+            buffer sizer = {};
+            WritePackedColumn(&sizer, values, count, stride);
+            buffer encoded = PushTempBuffer(sizer.offset);
+            WritePackedColumn(&encoded, values, count, stride);
+
+            RobotRecording_PackedColumn *column = (RobotRecording_PackedColumn *) encoded.data;
+            orders_seen |= 1 << column->order;
+            if((encoded.offset != sizer.offset) ||
+               (encoded.offset != PackedColumnSize(values, stride, count, column->order, column->first_delta)))
+            {
+               FuzzFailure(state, "packed column size doesnt match what got written");
+               return;
+            }
+
+            buffer read = Buffer(encoded.offset, encoded.data);
+            ReadPackedColumn(&read, count, decoded, stride);
+            if(read.offset != read.size) {
+               FuzzFailure(state, "packed column didnt read back everything that got written");
+               return;
+            }
+
+            //NOTE: only every stride-th value belongs to the column, the ones in between cant get touched
+            for(u32 k = 0; k < (count * stride); k++) {
+               u32 expected = ((k % stride) == 0) ? values[k] : sentinel;
+               if(decoded[k] != expected) {
+                  FuzzFailure(state, "packed column doesnt decode to the same bits");
+                  return;
+               }
+            }
+         }
+      }
+   }
+
+   if(orders_seen != ((1 << 1) | (1 << 2)))
+      FuzzFailure(state, "packed columns never picked one of the orders");
+   Reset(__temp_arena);
+}
+
+//NOTE: recorded gets the bytes of the file, so it can be fuzzed too
+FuzzResult FuzzRecorderRoundTrip(FuzzState *state, MemoryArena *arena, buffer *recorded) {
+   FuzzResult result = {};
+   result.first_failure = EMPTY_STRING;
+   state->result = &result;
+   CheckFuzzPackedColumns(state);
+
+   FuzzRecordingModel model = {};
+   model.robot_states = PushArray(arena, RobotRecording_RobotStateSample, FUZZ_RECORDING_PACKET_COUNT);
+   model.stream_count = 3 + FUZZ_RECORDING_WIDE_COUNT;
+   model.streams = PushArray(arena, FuzzRecordedStream, model.stream_count);
+   InitFuzzRecordedStream(model.streams + 0, EMPTY_STRING, Literal("battery"), North_Unit::Unitless, arena);
+   InitFuzzRecordedStream(model.streams + 1, Literal("drive"), Literal("left"), North_Unit::FeetPerSecond, arena);
+   InitFuzzRecordedStream(model.streams + 2, Literal("drive"), Literal("right"), North_Unit::FeetPerSecond, arena);
+   for(u32 i = 0; i < FUZZ_RECORDING_WIDE_COUNT; i++) {
+      InitFuzzRecordedStream(model.streams + 3 + i, Literal("wide"), PushCopy(arena, Concat(Literal("w"), ToString(i))),
+                             North_Unit::Percent, arena);
+   }
+   model.path[0] = { V2(0, 0), V2(1, 0) };
+   model.path[1] = { V2(5, 5), V2(0, 1) };
+
+   RobotRecorder rec = {};
+   InitRobotRecorder(&rec);
+   BeginRecording(&rec, Literal(FUZZ_RECORDING_FILE_NAME), Literal("fuzzbot"), V2(2, 3), 1234, FUZZ_RECORDING_CHUNK_DURATION);
+   RecordFuzzPackets(state, &rec, &model);
+   EndRecording(&rec);
+   Reset(__temp_arena);
+
+   RobotRecording recording = {};
+   if(!OpenRecording(&recording, Literal(FUZZ_RECORDING_FILE_NAME), arena)) {
+      FuzzFailure(state, "recording doesnt validate");
+   } else {
+      if((recording.timestamp != 1234) || (recording.robot_name != Literal("fuzzbot")) ||
+         (recording.robot_size.x != 2) || (recording.robot_size.y != 3) ||
+         (recording.chunk_count != model.chunk_count))
+      {
+         FuzzFailure(state, "recording header or chunk index doesnt match");
+      } else {
+         CheckFuzzRecordingChunks(state, &recording, &model);
+         CheckFuzzRecordingSummaries(state, &recording, &model);
+      }
+      CloseRecording(&recording);
+   }
+
+   *recorded = ReadEntireFile(FUZZ_RECORDING_FILE_NAME, false, arena);
+   RemoveFile(FUZZ_RECORDING_FILE_NAME);
+   state->result = NULL;
+   return result;
+}
+//RECORDER-ROUND-TRIP---------------------------------------
+
+int FuzzMain(u32 mutation_count) {
+   char *wildcard_extensions[] = { "*.ncsf", "*.ncff", "*.ncrp", "*.ncap", "*.ncai", "*.ncaj", "*.ncrr", "*.packet" };
+   MemoryArena *arena = PlatformAllocArena(Megabyte(4), "Fuzz");
+
+   u32 seed_count = 0;
+   for(u32 i = 0; i < ArraySize(wildcard_extensions); i++) {
+      for(FileListLink *file = ListFilesWithExtension(wildcard_extensions[i], arena); file; file = file->next)
+         seed_count++;
+   }
+
+   //NOTE: + 1 for the file FuzzRecorderRoundTrip writes
+   FuzzSeed *seeds = PushArray(arena, FuzzSeed, seed_count + 1);
+   u32 seed_i = 0;
+   for(u32 i = 0; i < ArraySize(wildcard_extensions); i++) {
+      for(FileListLink *file = ListFilesWithExtension(wildcard_extensions[i], arena); file; file = file->next) {
+         FuzzSeed seed = {};
+         seed.file_name = PushCopy(arena, file->full_name);
+         seed.format = GetFuzzFormat(seed.file_name);
+         seed.data = ReadEntireFile(ToCString(seed.file_name), false, arena);
+
+         u32 j = seed_i++;
+         for(; (j > 0) && NameLessThan(seed.file_name, seeds[j - 1].file_name); j--) {
+            seeds[j] = seeds[j - 1];
+         }
+         seeds[j] = seed;
+      }
+   }
+
+   FuzzState state = {};
+   state.scratch_arena = PlatformAllocArena(Megabyte(1), "Fuzz Scratch");
+   for(u32 i = 0; i < seed_count; i++) {
+      FuzzSeed *seed = seeds + i;
+      if(seed->format == FuzzFormat::AutoProjectJournal) {
+         string base_name = Concat(String(seed->file_name.text, seed->file_name.length - 5), Literal(".ncap"));
+         seed->journal_base = ReadEntireFile(ToCString(base_name), false, arena);
+      } else if((seed->format == FuzzFormat::Packet) && (state.state_schema.data == NULL) &&
+                (seed->data.size >= sizeof(PacketHeader)) &&
+                (((PacketHeader *) seed->data.data)->type == PacketType::StateSchema))
+      {
+         state.state_schema.data = seed->data.data + sizeof(PacketHeader);
+         state.state_schema.size = seed->data.size - sizeof(PacketHeader);
+         if(!ValidateStateSchemaPacket(state.state_schema))
+            state.state_schema = {};
+      }
+   }
+
+   //NOTE: the path maps & kernels arent set up lazily anywhere else in the tool either
+   GetPathMapPool();
+   GetHermiteBatchKernel();
+   InitBitPackingKernels();
+
+   Timer total_timer = InitTimer();
+   u32 failed_count = 0;
+
+   Timer round_trip_timer = InitTimer();
+   buffer recorded = {};
+   FuzzResult round_trip = FuzzRecorderRoundTrip(&state, arena, &recorded);
+   if(round_trip.failure_count > 0)
+      failed_count++;
+
+   printf("%-32s %-7s %9.1fKB  %6u packets                  %9.3fms%s%.*s\n",
+          "recorder round trip", (round_trip.failure_count == 0) ? "ok" : "FAILED", (f32) recorded.size / 1024,
+          FUZZ_RECORDING_PACKET_COUNT, MS(GetDT(&round_trip_timer)),
+          (round_trip.failure_count > 0) ? "  " : "", round_trip.first_failure.length, round_trip.first_failure.text);
+
+   if(recorded.data != NULL) {
+      FuzzSeed *seed = seeds + seed_count++;
+      seed->file_name = Literal(FUZZ_RECORDING_FILE_NAME);
+      seed->format = FuzzFormat::Recording;
+      seed->data = recorded;
+   }
+
+   for(u32 i = 0; i < seed_count; i++) {
+      FuzzSeed *seed = seeds + i;
+      if((seed->data.data == NULL) || (seed->format == FuzzFormat::Unknown))
+         continue;
+
+      Timer timer = InitTimer();
+      FuzzResult result = FuzzSeedFile(&state, seed, mutation_count, arena);
+      if(result.failure_count > 0)
+         failed_count++;
+
+      printf("%-32.*s %-7s %9.1fKB  %6u variants, %6u valid  %9.3fms%s%.*s\n",
+             seed->file_name.length, seed->file_name.text, (result.failure_count == 0) ? "ok" : "FAILED",
+             (f32) seed->data.size / 1024, result.variant_count, result.valid_count, MS(GetDT(&timer)),
+             (result.failure_count > 0) ? "  " : "", result.first_failure.length, result.first_failure.text);
+   }
+
+   printf("%u seeds, %u failed, %u mutations each, %.3fms\n", seed_count, failed_count, mutation_count, MS(GetDT(&total_timer)));
+   return (failed_count == 0) ? 0 : 2;
+}
@@ -0,0 +1,437 @@
+//NOTE: headless inspector/converter for North files, no window or networking
+//      usage: north_tool [-j thread_count] [--convert] [--quantize] <directory>
+//             north_tool --fuzz [-n mutation_count] <directory>
+//      validates, parses & summarizes every .ncap/.ncrp/.ncff/.ncsf/.ncrr file in the directory in parallel
+//      & prints per file timings, --convert re-encodes the files that arent already in the current format
+//      (--quantize also writes .ncap control points as fixed point, this is lossy)
+//      --fuzz runs the seeds in the directory (eg. data/fuzz) through every validator instead & round trips
+//      a recording through the RobotRecorder, see north_tool_fuzz.cpp
+
+#include <stdarg.h>
+#include <string.h>
+
+#define COMMON_PLATFORM
+#include "lib/common.cpp"
+
+#include "north_defs/north_common_definitions.h"
+#include "north_defs/north_file_definitions.h"
+#include "north_defs/north_network_definitions.h"
+
+#include "north_shared/north_validation_utils.cpp"
+#include "north_shared/robot_profile_utils.cpp"
+#include "north_shared/auto_project_utils.cpp"
+#define NORTH_HEADLESS //NOTE: leaves out the parts of the settings utils that need textures
+#include "north_shared/north_settings_utils.cpp"
+#include "north_shared/robot_recording_utils.cpp"
+
+#define TOOL_MAX_WORKERS 32
+
+namespace ToolConvertResult {
+   enum type {
+      None, //NOTE: --convert wasnt passed, or the file type cant be re-encoded
+      UpToDate,
+      Converted,
+      Failed
+   };
+};
+
+struct ToolFileResult {
+   string file_name;
+   u64 size;
+   bool valid;
+
+   f32 validate_time;
+   f32 parse_time;
+   f32 recalc_time;
+
+   string summary;
+   ToolConvertResult::type convert;
+};
+
+struct ToolJob {
+   bool convert;
+   bool quantize;
+   u32 file_count;
+   string *file_names;
+   ToolFileResult *results;
+   volatile u32 next_file;
+};
+
+struct ToolWorker {
+   ToolJob *job;
+   MemoryArena *arena; //NOTE: the results live in here, so its never reset
+   MemoryArena *temp_arena;
+   MemoryArena *scratch_arena; //NOTE: reset by ParseProfileFile & after every recording chunk
+   PlatformThread thread;
+};
+
+//NOTE: directory order isnt stable, sorted so the output can be diffed between runs
+bool NameLessThan(string a, string b) {
+   for(u32 i = 0; i < Min(a.length, b.length); i++) {
+      if(a.text[i] != b.text[i])
+         return (u8) a.text[i] < (u8) b.text[i];
+   }
+   return a.length < b.length;
+}
+
+f32 MS(f32 seconds) {
+   return seconds * 1000;
+}
+
+string ToolSummary(MemoryArena *arena, const char *format, ...) {
+   char text[256];
+   va_list args;
+   va_start(args, format);
+   vsnprintf(text, ArraySize(text), format, args);
+   va_end(args);
+   return PushCopy(arena, Literal(text));
+}
+
+//NOTE: only writes the file if re-encoding actually changed it
+ToolConvertResult::type ConvertFile(string file_name, buffer old_file, buffer new_file) {
+   if((old_file.size == new_file.offset) && (memcmp(old_file.data, new_file.data, new_file.offset) == 0))
+      return ToolConvertResult::UpToDate;
+
+   return ReplaceEntireFile(file_name, new_file) ? ToolConvertResult::Converted : ToolConvertResult::Failed;
+}
+
+struct ToolProjectCounts {
+   u32 node_count;
+   u32 path_count;
+   u32 command_count;
+   u32 control_point_count;
+   f32 length;
+};
+
+void CountAutoNode(AutoNode *node, ToolProjectCounts *counts) {
+   counts->node_count++;
+   counts->command_count += node->command_count;
+   for(u32 i = 0; i < node->path_count; i++) {
+      AutoPath *path = node->out_paths[i];
+      counts->path_count++;
+      counts->control_point_count += path->control_point_count;
+      counts->length += path->length;
+      CountAutoNode(path->out_node, counts);
+   }
+}
+
+void InspectAutoProject(ToolWorker *worker, ToolFileResult *result) {
+   Timer timer = InitTimer();
+   MappedFile file = MapEntireFile(result->file_name);
+   result->size = file.data.size;
+   result->valid = ValidateAutoProjectFile(file.data);
+   result->validate_time = GetDT(&timer);
+   if(!result->valid) {
+      UnmapFile(&file);
+      return;
+   }
+
+   string name = String(result->file_name.text, result->file_name.length - 5);
+   AutoProjectLink *view = ParseAutoProjectView(file, name, __temp_arena);
+   result->parse_time = GetDT(&timer);
+
+   //NOTE: copying is what builds the path maps, so this is the recalc time the editor sees when it loads a project
+   AutoProjectLink *project = CopyAutoProject(view, __temp_arena);
+   result->recalc_time = GetDT(&timer);
+
+   ToolProjectCounts counts = {};
+   CountAutoNode(project->starting_node, &counts);
+   result->summary = ToolSummary(worker->arena, "%u nodes, %u paths, %u commands, %u control points, %.2fft",
+                                 counts.node_count, counts.path_count, counts.command_count,
+                                 counts.control_point_count, counts.length);
+
+   if(worker->job->convert)
+      result->convert = ConvertFile(result->file_name, file.data, EncodeAutoProject(project, AutoProjectFileEncoding(worker->job->quantize)));
+
+   FreeAutoProject(project);
+   FreeAutoProject(view);
+}
+
+void InspectRobotProfile(ToolWorker *worker, ToolFileResult *result) {
+   Timer timer = InitTimer();
+   buffer file = ReadEntireFile(ToCString(result->file_name));
+   result->size = file.size;
+   result->valid = (file.data != NULL) && ValidateRobotProfileFile(file);
+   result->validate_time = GetDT(&timer);
+   if(!result->valid)
+      return;
+
+   RobotProfile profile = {};
+   profile.arena = worker->scratch_arena;
+   ParseProfileFile(&profile, file, String(result->file_name.text, result->file_name.length - 5));
+   result->parse_time = GetDT(&timer);
+
+   u32 param_count = profile.default_group.param_count;
+   for(RobotProfileGroup *group = profile.first_group; group; group = group->next) {
+      param_count += group->param_count;
+   }
+
+   result->summary = ToolSummary(worker->arena, "%.2fx%.2fft, %u groups, %u parameters, %u commands, %u conditionals",
+                                 profile.size.x, profile.size.y, profile.group_count, param_count,
+                                 profile.command_count, profile.conditional_count);
+
+   if(worker->job->convert) {
+      buffer sizer = {};
+      EncodeProfileFile(&profile, &sizer);
+      buffer new_file = PushTempBuffer(sizer.offset);
+      EncodeProfileFile(&profile, &new_file);
+      result->convert = ConvertFile(result->file_name, file, new_file);
+   }
+}
+
+void InspectField(ToolWorker *worker, ToolFileResult *result) {
+   Timer timer = InitTimer();
+   MappedFile field_file = MapEntireFile(result->file_name);
+   result->size = field_file.data.size;
+   result->valid = ValidateFieldFile(field_file.data);
+   result->validate_time = GetDT(&timer);
+   if(!result->valid) {
+      UnmapFile(&field_file);
+      return;
+   }
+
+   buffer file = field_file.data;
+   FileHeader *numbers = ConsumeStruct(&file, FileHeader);
+   if(numbers->version_number == FIELD_V0_VERSION) {
+      Field_FileHeader_V0 *header = ConsumeStruct(&file, Field_FileHeader_V0);
+      result->parse_time = GetDT(&timer);
+      result->summary = ToolSummary(worker->arena, "v0, %.2fx%.2fft, %u starting positions, %ux%u raw image",
+                                    header->width, header->height, header->starting_position_count,
+                                    header->image_width, header->image_height);
+
+      if(worker->job->convert)
+         result->convert = ConvertFile(result->file_name, field_file.data, UpgradeFieldFile(field_file.data));
+   } else {
+      Field_FileHeader *header = ConsumeStruct(&file, Field_FileHeader);
+      Field_ImageLevel *levels = ConsumeArray(&file, Field_ImageLevel, header->image_level_count);
+
+      //NOTE: decodes every level, not just the ones the editor would upload, so broken tiles anywhere show up
+      bool decoded = true;
+      for(u32 i = 0; decoded && (i < header->image_level_count); i++) {
+         u32 *texels = PushTempArray(u32, levels[i].width * levels[i].height);
+         decoded = DecodeFieldImageLevel(field_file.data, levels + i, texels);
+      }
+      result->parse_time = GetDT(&timer);
+      result->valid = decoded;
+      result->summary = ToolSummary(worker->arena, "v1, %.2fx%.2fft, %u starting positions, %ux%u image, %u levels%s",
+                                    header->width, header->height, header->starting_position_count,
+                                    header->image_width, header->image_height, header->image_level_count,
+                                    decoded ? "" : ", bad image tiles");
+
+      //NOTE: already tiled & mipped, theres nothing to re-encode
+      if(worker->job->convert)
+         result->convert = ToolConvertResult::UpToDate;
+   }
+
+   UnmapFile(&field_file);
+}
+
+void InspectSettings(ToolWorker *worker, ToolFileResult *result) {
+   Timer timer = InitTimer();
+   buffer file = ReadEntireFile(ToCString(result->file_name));
+   result->size = file.size;
+   result->valid = (file.data != NULL) && ValidateSettingsFile(file);
+   result->validate_time = GetDT(&timer);
+   if(!result->valid)
+      return;
+
+   buffer data = file;
+   ConsumeStruct(&data, FileHeader);
+   Settings_FileHeader *header = ConsumeStruct(&data, Settings_FileHeader);
+   string field_name = ConsumeString(&data, header->field_name_length);
+   result->parse_time = GetDT(&timer);
+   result->summary = ToolSummary(worker->arena, "team %u, field \"%.*s\"",
+                                 header->team_number, field_name.length, field_name.text);
+
+   if(worker->job->convert)
+      result->convert = ConvertFile(result->file_name, file, EncodeSettingsFile(header->team_number, field_name));
+}
+
+//NOTE: theres no recording writer that works from a parsed recording (the recorder only streams samples in),
+//      so recordings only get validated & read, never re-encoded
+void InspectRecording(ToolWorker *worker, ToolFileResult *result) {
+   Timer timer = InitTimer();
+   RobotRecording rec = {};
+   result->valid = OpenRecording(&rec, result->file_name);
+   result->validate_time = GetDT(&timer);
+   if(!result->valid)
+      return;
+
+   result->size = rec.file.data.size;
+
+   u32 bad_chunks = 0;
+   u64 robot_state_count = 0;
+   u64 diagnostic_sample_count = 0;
+   for(u32 i = 0; i < rec.chunk_count; i++) {
+      RecordingChunk chunk = ReadRecordingChunk(&rec, i, worker->scratch_arena);
+      if(chunk.group_count == 0)
+         bad_chunks++;
+
+      robot_state_count += chunk.robot_state_count;
+      for(u32 j = 0; j < chunk.group_count; j++) {
+         RecordingGroup *group = chunk.groups + j;
+         for(u32 k = 0; k < group->diagnostic_count; k++) {
+            diagnostic_sample_count += group->diagnostics[k].sample_count;
+         }
+      }
+
+      Reset(worker->scratch_arena);
+   }
+   result->parse_time = GetDT(&timer);
+
+   result->summary = ToolSummary(worker->arena, "\"%.*s\", %.2fs, %u chunks (%u bad), %llu robot states, %llu diagnostic samples, %u summary streams",
+                                 rec.robot_name.length, rec.robot_name.text, rec.end_time - rec.begin_time,
+                                 rec.chunk_count, bad_chunks, (unsigned long long) robot_state_count,
+                                 (unsigned long long) diagnostic_sample_count, rec.summary_stream_count);
+   CloseRecording(&rec);
+}
+
+#include "north_tool_fuzz.cpp"
+
+void InspectFilesWorker(void *data) {
+   ToolWorker *worker = (ToolWorker *) data;
+   ToolJob *job = worker->job;
+   __temp_arena = worker->temp_arena;
+
+   for(u32 i = AtomicIncrement(&job->next_file) - 1; i < job->file_count;
+       i = AtomicIncrement(&job->next_file) - 1)
+   {
+      ToolFileResult *result = job->results + i;
+      result->file_name = job->file_names[i];
+      result->summary = EMPTY_STRING;
+
+      string file_name = result->file_name;
+      string extension = (file_name.length >= 5) ? String(file_name.text + file_name.length - 5, 5) : EMPTY_STRING;
+      if(extension == Literal(".ncap")) {
+         InspectAutoProject(worker, result);
+      } else if(extension == Literal(".ncrp")) {
+         InspectRobotProfile(worker, result);
+      } else if(extension == Literal(".ncff")) {
+         InspectField(worker, result);
+      } else if(extension == Literal(".ncsf")) {
+         InspectSettings(worker, result);
+      } else if(extension == Literal(".ncrr")) {
+         InspectRecording(worker, result);
+      }
+
+      Reset(worker->temp_arena);
+   }
+}
+
+int main(int argc, char **argv) {
+   bool convert = false;
+   bool quantize = false;
+   bool fuzz = false;
+   u32 mutation_count = FUZZ_DEFAULT_MUTATION_COUNT;
+   u32 worker_count = 0;
+   char *directory = NULL;
+   for(int i = 1; i < argc; i++) {
+      string arg = Literal(argv[i]);
+      if(arg == Literal("--convert")) {
+         convert = true;
+      } else if(arg == Literal("--quantize")) {
+         quantize = true;
+      } else if(arg == Literal("--fuzz")) {
+         fuzz = true;
+      } else if((arg == Literal("-j")) && ((i + 1) < argc)) {
+         worker_count = atoi(argv[++i]);
+      } else if((arg == Literal("-n")) && ((i + 1) < argc)) {
+         mutation_count = atoi(argv[++i]);
+      } else {
+         directory = argv[i];
+      }
+   }
+
+   if(directory == NULL) {
+      fprintf(stderr, "usage: %s [-j thread_count] [--convert] [--quantize] <directory>\n", argv[0]);
+      fprintf(stderr, "       %s --fuzz [-n mutation_count] <directory>\n", argv[0]);
+      return 1;
+   }
+
+   LinuxCommonInit(PlatformAllocArena(Megabyte(10), "Temp"));
+   if(chdir(directory) != 0) {
+      fprintf(stderr, "couldnt open %s\n", directory);
+      return 1;
+   }
+
+   if(fuzz)
+      return FuzzMain(mutation_count);
+
+   char *wildcard_extensions[] = { "*.ncsf", "*.ncff", "*.ncrp", "*.ncap", "*.ncrr" };
+   ToolJob job = {};
+   job.convert = convert;
+   job.quantize = quantize;
+
+   FileListLink *files[ArraySize(wildcard_extensions)] = {};
+   for(u32 i = 0; i < ArraySize(wildcard_extensions); i++) {
+      files[i] = ListFilesWithExtension(wildcard_extensions[i]);
+      for(FileListLink *file = files[i]; file; file = file->next) {
+         job.file_count++;
+      }
+   }
+
+   job.file_names = PushTempArray(string, job.file_count);
+   job.results = PushTempArray(ToolFileResult, job.file_count);
+   u32 file_i = 0;
+   for(u32 i = 0; i < ArraySize(wildcard_extensions); i++) {
+      for(FileListLink *file = files[i]; file; file = file->next) {
+         string file_name = file->full_name;
+         u32 j = file_i++;
+         for(; (j > 0) && NameLessThan(file_name, job.file_names[j - 1]); j--) {
+            job.file_names[j] = job.file_names[j - 1];
+         }
+         job.file_names[j] = file_name;
+      }
+   }
+
+   //NOTE: these arent thread safe to set up lazily so do it before any workers start
+   GetPathMapPool();
+   GetHermiteBatchKernel();
+   InitBitPackingKernels();
+
+   if(worker_count == 0)
+      worker_count = GetProcessorCount();
+   worker_count = Clamp(1, TOOL_MAX_WORKERS, Min(worker_count, Max(job.file_count, 1)));
+
+   Timer total_timer = InitTimer();
+   ToolWorker workers[TOOL_MAX_WORKERS] = {};
+   for(u32 i = 0; i < worker_count; i++) {
+      workers[i].job = &job;
+      workers[i].arena = PlatformAllocArena(Megabyte(1), "Tool Worker");
+      workers[i].temp_arena = PlatformAllocArena(Megabyte(10), "Tool Worker Temp");
+      workers[i].scratch_arena = PlatformAllocArena(Megabyte(1), "Tool Worker Scratch");
+   }
+
+   for(u32 i = 1; i < worker_count; i++) {
+      StartThread(&workers[i].thread, InspectFilesWorker, workers + i);
+   }
+
+   MemoryArena *main_temp_arena = __temp_arena;
+   InspectFilesWorker(workers + 0);
+   for(u32 i = 1; i < worker_count; i++) {
+      JoinThread(&workers[i].thread);
+   }
+   __temp_arena = main_temp_arena;
+   f32 total_time = GetDT(&total_timer);
+
+   char *convert_text[] = { "", "up to date", "converted", "CONVERT FAILED" };
+   u32 invalid_count = 0;
+   u32 converted_count = 0;
+   for(u32 i = 0; i < job.file_count; i++) {
+      ToolFileResult *result = job.results + i;
+      if(!result->valid)
+         invalid_count++;
+      if(result->convert == ToolConvertResult::Converted)
+         converted_count++;
+
+      printf("%-32.*s %-7s %9.1fKB  validate %8.3fms  parse %8.3fms  recalc %8.3fms  %.*s%s%s\n",
+             result->file_name.length, result->file_name.text, result->valid ? "ok" : "INVALID",
+             (f32) result->size / 1024, MS(result->validate_time), MS(result->parse_time), MS(result->recalc_time),
+             result->summary.length, result->summary.text,
+             (result->convert != ToolConvertResult::None) ? ", " : "", convert_text[result->convert]);
+   }
+
+   printf("%u files, %u invalid, %u converted, %.3fms on %u threads\n",
+          job.file_count, invalid_count, converted_count, MS(total_time), worker_count);
+   return (invalid_count == 0) ? 0 : 2;
+}
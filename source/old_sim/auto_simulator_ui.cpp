@@ -138,6 +138,7 @@ void DrawSimField(element *page, EditorState *state) {
             samples.data[i].data_ptr = sample1;
          }
          BuildMap(&plan->map);
+         plan->bounds = BuildPathBounds(&plan->map, plan->map.arena);
          //----------------------------
 
          AutoPathData starting_sample = {};
@@ -59,6 +59,7 @@ struct PathPlan {
    AutoVelocityDatapoints velocity;
    f32 length;
    InterpolatingMap map; //NOTE: f32 -> AutoPathData
+   PathBounds bounds;
 };
 
 
@@ -86,71 +87,14 @@ const f32 min_path_dist = 0.5;
 const f32 min_path_heading_diff = ToRadians(30);
 
 PathPoint GetCurrentPoint(PathPlan *plan, AutoRobotPose pose) {
-   f32 closest_dist = F32_MAX;
-   f32 closest_s = 0;
-   
-   u32 sample_count = 40;
-   f32 step = plan->length / (sample_count - 1);
-   for(u32 i = 0; i < sample_count; i++) {
-      f32 curr_s = i * step;
-      AutoPathData sample = {};
-      MapLookup(&plan->map, curr_s, &sample);
-      f32 curr_dist = Length(sample.pose.pos - pose.pos);
-
-      if(curr_dist < closest_dist) {
-         closest_dist = curr_dist;
-         closest_s = curr_s;
-      }
-   }
-
-   f32 lower_s = 0;
-   f32 lower_dist = 0;
-   f32 upper_s = 0;
-   f32 upper_dist = 0;
-
-   if((closest_s + step) > plan->length) {
-      lower_s = closest_s - step;
-      lower_dist = GetDistAtS(plan, lower_s, pose.pos);
-      upper_s = closest_s;
-      upper_dist = closest_dist;
-   } else if((closest_s - step) < 0) {
-      lower_s = closest_s;
-      lower_dist = closest_dist;
-      upper_s = closest_s + step;
-      upper_dist = GetDistAtS(plan, upper_s, pose.pos);
-   } else {
-      f32 next_s = closest_s + step;
-      f32 prev_s = closest_s - step;
-      f32 next_dist = GetDistAtS(plan, next_s, pose.pos);
-      f32 prev_dist = GetDistAtS(plan, prev_s, pose.pos);
-
-      lower_s = (next_dist > prev_dist) ? prev_s : closest_s;
-      lower_dist = (next_dist > prev_dist) ? prev_dist : closest_dist;
-      upper_s = (next_dist > prev_dist) ? closest_s : next_s;
-      upper_dist = (next_dist > prev_dist) ? closest_dist : next_dist;
-   }
-   
-   u32 recurse_count = 5;
-   for(u32 i = 0; i < recurse_count; i++) {
-      f32 midpoint_s = (lower_s + upper_s) / 2.0;
-      f32 midpoint_dist = GetDistAtS(plan, midpoint_s, pose.pos);
-
-      bool upper_is_farther = upper_dist > lower_dist;
-      lower_s = upper_is_farther ? lower_s : midpoint_s;
-      lower_dist = upper_is_farther ? lower_dist : midpoint_dist;
-      upper_s = upper_is_farther ? midpoint_s : upper_s;
-      upper_dist = upper_is_farther ? midpoint_dist : upper_dist;
-   }
-
-   closest_s = (lower_s + upper_s) / 2.0;
-   closest_dist = GetDistAtS(plan, closest_s, pose.pos);
-   AutoRobotPose closest_pose = GetPoseAtS(plan, closest_s);
+   PathClosestPoint closest = GetClosestPoint(&plan->bounds, &plan->map, pose.pos);
+   AutoRobotPose closest_pose = GetPoseAtS(plan, closest.s);
 
    PathPoint result = {};
-   result.on_path = (closest_dist <= min_path_dist) && 
+   result.on_path = (closest.distance <= min_path_dist) && 
                     (abs(ShortestAngleBetween_Radians(closest_pose.angle, pose.angle)) <= min_path_heading_diff);
    result.point = closest_pose.pos;
-   result.s = closest_s;
+   result.s = closest.s;
    return result;
 } 
 
@@ -177,21 +121,22 @@ f32 AdjustmentPathCost(PathPlan *plan, AutoRobotPose pose, f32 a, f32 b, f32 s,
 
    u32 sample_count = 20;
    f32 step = 1.0 / (sample_count - 1);
-   f32 last_t = 0;
+   v2 positions[20];
+   v2 tangents[20];
+   CubicHermiteSplineBatch(A.pos, A.tangent, B.pos, B.tangent, sample_count, positions, tangents);
+
    for(u32 i = 0; i < sample_count; i++) {
-      f32 curr_t = step * i;
-      v2 last_pos = CubicHermiteSpline(A.pos, A.tangent, B.pos, B.tangent, last_t);
-      v2 last_tangent = CubicHermiteSplineTangent(A.pos, A.tangent, B.pos, B.tangent, last_t);
-      v2 curr_pos = CubicHermiteSpline(A.pos, A.tangent, B.pos, B.tangent, curr_t);
-      v2 curr_tangent = CubicHermiteSplineTangent(A.pos, A.tangent, B.pos, B.tangent, curr_t);
+      u32 last_i = (i > 0) ? (i - 1) : 0;
+      v2 last_pos = positions[last_i];
+      v2 last_tangent = tangents[last_i];
+      v2 curr_pos = positions[i];
+      v2 curr_tangent = tangents[i];
 
       f32 theta_dot = abs(ShortestAngleBetween_Radians(ToRadians(Angle(last_tangent)), ToRadians(Angle(curr_tangent))) / step);
 
       length += Length(curr_pos - last_pos);
       max_theta_dot = Max(max_theta_dot, theta_dot);
       avg_theta_dot += theta_dot;
-
-      last_t = curr_t;
    }
 
    avg_theta_dot /= length;
@@ -287,9 +232,8 @@ bool SimFollowLoop(PathPlan *plan, SimRobot *bot, ui_field_topdown *field, f32 t
       CubicHermiteSpline(field, A.pos, A.tangent, B.pos, B.tangent, BLACK, 2);
       InterpolatingMap adj_pose_map = {};
       adj_pose_map.arena = PushTempArena(Megabyte(1));
-      adj_pose_map.sample_exp = 7;
       adj_pose_map.lerp_callback = map_lerp_pose;
-      f32 adj_length = BuildPathMap(&adj_pose_map, adj_spline, ArraySize(adj_spline));
+      f32 adj_length = BuildPathMap(&adj_pose_map, adj_spline, ArraySize(adj_spline)).length;
       f32 original_path_length = plan->length - adj_params.s;
       f32 total_length = adj_length + original_path_length;
 
@@ -338,6 +282,7 @@ bool SimFollowLoop(PathPlan *plan, SimRobot *bot, ui_field_topdown *field, f32 t
          samples.data[i].data_ptr = sample;
       }
       BuildMap(&plan->map);
+      plan->bounds = BuildPathBounds(&plan->map, plan->map.arena);
 
       //TODO: reset curr_point because we just rebuilt the plan
       curr_point = GetCurrentPoint(plan, curr_pose);